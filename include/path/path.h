@@ -14,6 +14,7 @@
 #include <stdlib.h>
 #include <stdbool.h>
 #include <string.h>
+#include <errno.h>
 
 // dict submodule
 #include <dict/dict.h>
@@ -21,13 +22,41 @@
 // stack submodule
 #include <stack/stack.h>
 
+// sync submodule
+#include <sync/sync.h>
+
+// crypto submodule
+#include <crypto/sha.h>
+
 // Platform dependent includes
 #ifdef _WIN64
 #include <windows.h>
 #include <process.h>
 #else
 #include <dirent.h>
+#include <fcntl.h>
+#include <unistd.h>
 #include <sys/stat.h>
+#include <time.h>
+#include <sched.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#endif
+
+// Linux specific includes
+#ifdef __linux__
+#include <sys/syscall.h>
+#include <sys/sysmacros.h>
+#include <sys/inotify.h>
+#include <sys/ioctl.h>
+#include <sys/sendfile.h>
+#include <linux/fs.h>
+#endif
+
+// io_uring includes
+#ifdef PATH_HAS_IO_URING
+#include <sys/mman.h>
+#include <linux/io_uring.h>
 #endif
 
 // Platform dependent macros
@@ -54,17 +83,118 @@
 #define PATH_REALLOC(p, sz) realloc(p,sz)
 #endif
 
+// Number of statx requests kept in flight by the 
+// io_uring metadata backend. 
+#ifndef PATH_IO_URING_QUEUE_DEPTH
+#define PATH_IO_URING_QUEUE_DEPTH 128
+#endif
+
 // Max length of a string representing a full path.
 // Exceeding this limit will produce errors. Exceeding 
 // this limit in while the NDEBUG macro is undefined 
 // will print error logs to standard out. 
 #define MAX_FILE_PATH_LEN 4096
 
+// Size of the buffer that directory entries are read
+// into when the getdents64 enumeration backend is used.
+// Larger buffers mean fewer system calls per listing. 
+#ifndef PATH_DIRENT_BUFFER_SIZE
+#define PATH_DIRENT_BUFFER_SIZE ( 256 * 1024 )
+#endif
+
+// Size of each block of memory in a path_arena, unless 
+// another size is requested when the arena is created.
+#ifndef PATH_ARENA_BLOCK_SIZE
+#define PATH_ARENA_BLOCK_SIZE ( 1024 * 1024 )
+#endif
+
+// Quantity of directory listings each path keeps, so 
+// revisited directories that haven't changed aren't 
+// read again. 
+#ifndef PATH_LISTING_CACHE_SIZE
+#define PATH_LISTING_CACHE_SIZE 16
+#endif
+
+// A directory that changed this close to the time it was 
+// listed may change again without moving its timestamps,
+// so its listing isn't reused. Covers a coarse clock tick.
+#ifndef PATH_LISTING_RACY_NS
+#define PATH_LISTING_RACY_NS 10000000LL
+#endif
+
+// Quantity of directories that are watched at once with 
+// PATH_OPEN_WATCH. Past the budget, paths fall back to 
+// validating listings with timestamps. 
+#ifndef PATH_WATCH_BUDGET
+#define PATH_WATCH_BUDGET 4096
+#endif
+
+// Quantity of directories above the path that a path 
+// opened with PATH_OPEN_HANDLE keeps open. Past the 
+// budget, ".." opens the parent again.
+#ifndef PATH_HANDLE_DEPTH
+#define PATH_HANDLE_DEPTH 64
+#endif
+
+// Size of the buffer that a directory cursor reads 
+// entries into. Cursors are meant to be cheap to open.
+#ifndef PATH_CURSOR_BUFFER_SIZE
+#define PATH_CURSOR_BUFFER_SIZE ( 32 * 1024 )
+#endif
+
+// Size of the buffer each hashing thread reads files 
+// into.
+#ifndef PATH_HASH_BUFFER_SIZE
+#define PATH_HASH_BUFFER_SIZE ( 128 * 1024 )
+#endif
+
+// Quantity of files that walkers queue ahead of the 
+// hashing threads, before they wait.
+#ifndef PATH_HASH_QUEUE_SIZE
+#define PATH_HASH_QUEUE_SIZE 1024
+#endif
+
+// Size of the buffer that copies files, when the kernel 
+// can't copy them without one.
+#ifndef PATH_COPY_BUFFER_SIZE
+#define PATH_COPY_BUFFER_SIZE ( 128 * 1024 )
+#endif
+
+// Quantity of directory fds that a recursive remove holds
+// open for queued directories. Past the budget, threads
+// empty directories depth first, one fd per level.
+#ifndef PATH_REMOVE_FD_BUDGET
+#define PATH_REMOVE_FD_BUDGET 256
+#endif
+
+// Quantity of directory fds that path_snapshot_save holds
+// open for queued directories. Past the budget, a directory
+// is opened from its nearest open ancestor.
+#ifndef PATH_SNAPSHOT_FD_BUDGET
+#define PATH_SNAPSHOT_FD_BUDGET 256
+#endif
+
+// Quantity of files that path_write_atomic_files writes,
+// and holds open, before it flushes them, and renames 
+// them into place. 
+#ifndef PATH_WRITE_BATCH_SIZE
+#define PATH_WRITE_BATCH_SIZE 256
+#endif
+
+// Size of a SHA-256 hash, in bytes
+#define PATH_HASH_SIZE 32
+
 // Forward declarations
 struct path_s;
+struct path_dir_cursor_s;
+struct path_arena_s;
 
 // Type definitions
-typedef struct path_s path;
+typedef struct path_s            path;
+typedef struct path_dir_cursor_s path_dir_cursor;
+typedef struct path_arena_s      path_arena;
+typedef struct path_pattern_s    path_pattern;
+typedef struct path_snapshot_s   path_snapshot;
 
 // Enumeration definitions
 typedef enum 
@@ -74,6 +204,138 @@ typedef enum
     PATH_TYPE_SOCKET    = 3
 } path_type;
 
+typedef enum 
+{
+    PATH_ENUMERATION_DEFAULT  = 0, // getdents64 on Linux, readdir elsewhere
+    PATH_ENUMERATION_READDIR  = 1, // Portable opendir / readdir
+    PATH_ENUMERATION_GETDENTS = 2  // Batched getdents64 ( Linux only )
+} path_enumeration_backend;
+
+typedef enum 
+{
+    PATH_METADATA_DEFAULT  = 0, // Same as PATH_METADATA_FSTATAT
+    PATH_METADATA_FSTATAT  = 1, // One fstatat per directory entry
+    PATH_METADATA_IO_URING = 2  // Batched statx through io_uring ( Linux only )
+} path_metadata_backend;
+
+typedef enum 
+{
+    PATH_OPEN_DEFAULT  = 0,
+    PATH_OPEN_METADATA = 1 << 0, // Stat every directory entry while listing
+    PATH_OPEN_WATCH    = 1 << 1, // Keep the listing current with inotify ( Linux only )
+    PATH_OPEN_HANDLE   = 1 << 2  // Keep the directories above the path open, so ".." is a cached fd
+} path_open_flags;
+
+typedef enum 
+{
+    PATH_WALK_STOP     = 0, // Stop the walk, as soon as possible
+    PATH_WALK_CONTINUE = 1, // Keep walking, and descend into directories
+    PATH_WALK_SKIP     = 2  // Keep walking, but don't descend into this directory
+} path_walk_result;
+
+typedef enum 
+{
+    PATH_CREATE_DEFAULT  = 0,
+    PATH_CREATE_IO_URING = 1 << 0 // Submit every file through io_uring, where it is available ( Linux only )
+} path_create_flags;
+
+typedef enum 
+{
+    PATH_COPY_DEFAULT  = 0,
+    PATH_COPY_PRESERVE = 1 << 0 // Copy the mode, and the access and modification times
+} path_copy_flags;
+
+typedef enum 
+{
+    PATH_WRITE_DEFAULT = 0,      // Flush each file with fdatasync, before it is renamed into place
+    PATH_WRITE_SYNCFS  = 1 << 0, // Flush each batch of files with one syncfs ( Linux only )
+    PATH_WRITE_NO_SYNC = 1 << 1  // Don't flush. Readers never see a partial file, but a crash may lose the write
+} path_write_flags;
+
+typedef enum 
+{
+    PATH_DIFF_ADDED    = 1,
+    PATH_DIFF_REMOVED  = 2,
+    PATH_DIFF_MODIFIED = 3, // The size, modification time, mode, or inode changed
+    PATH_DIFF_RENAMED  = 4  // An entry was removed, and one with the same inode was added
+} path_diff_kind;
+
+typedef enum 
+{
+    PATH_DIFF_DEFAULT           = 0,
+    PATH_DIFF_TRUST_DIRECTORIES = 1 << 0 // Skip subtrees whose directory has the same modification time and quantity of entries
+} path_diff_flags;
+
+// Function declarations
+typedef path_walk_result (*fn_path_walk)(const char *full_path, path_type type, size_t depth, void *p_context);
+typedef void *(*fn_path_realloc)(void *p_memory, size_t size, void *p_context);
+
+// Structure definitions
+typedef struct
+{
+    fn_path_realloc  pfn_realloc; // Same contract as realloc. A size of 0 frees
+    void            *p_context;
+} path_allocator;
+
+typedef struct
+{
+    path_type          type;
+    unsigned int       mode;
+    size_t             size;
+    unsigned long long blocks,
+                       links,
+                       inode,
+                       device;
+    long long          modified_seconds;
+    long               modified_nanoseconds;
+} path_metadata;
+
+// An entry in a directory listing. Valid only for the duration of a callback
+typedef struct
+{
+    const char          *name;
+    path_type            type;
+    size_t               index;      // Position of the entry, in name order
+    const path_metadata *p_metadata; // Metadata of the entry, or null pointer without PATH_OPEN_METADATA
+} path_entry;
+
+// Return 1 to keep iterating, or 0 to stop
+typedef int (*fn_path_foreach)(const path_entry *p_entry, void *p_context);
+
+// Disk usage of a subtree. Hard linked files are counted once
+typedef struct
+{
+    unsigned long long size,        // Apparent size, in bytes
+                       blocks,      // Allocated 512 byte blocks
+                       files,       // Everything that isn't a directory
+                       directories; // Including the root of the subtree
+} path_usage;
+
+// An entry in a snapshot. Entries are in breadth first order, and the 
+// contents of each directory are contiguous, sorted by name
+typedef struct
+{
+    const char    *name;        // The root is named by its full path
+    size_t         parent,      // The root is its own parent
+                   first_child,
+                   child_count;
+    path_metadata  metadata;
+} path_snapshot_entry;
+
+// Called once for each directory, with the usage of the subtree beneath it
+typedef void (*fn_path_usage)(const char *full_path, const path_usage *p_usage, size_t depth, void *p_context);
+
+// Called once for each file, with its SHA-256 hash
+typedef void (*fn_path_hash)(const char *full_path, const unsigned char *p_hash, unsigned long long size, void *p_context);
+
+// Called once for each set of files with the same contents. Paths are sorted
+typedef void (*fn_path_duplicates)(const char *const *full_paths, size_t count, unsigned long long size, void *p_context);
+
+// Called once for each difference. Paths are relative to the roots of the trees. 
+// The old path and metadata are null pointers for added entries, and the new 
+// path and metadata are null pointers for removed entries
+typedef void (*fn_path_diff)(path_diff_kind kind, const char *old_path, const char *new_path, const path_metadata *p_old, const path_metadata *p_new, void *p_context);
+
 // Allocators
 /** !
  * Allocate memory for a path
@@ -84,6 +346,95 @@ typedef enum
 */
 DLLEXPORT int path_create ( path **pp_path );
 
+/** !
+ * Create an arena. Arena allocations are bumped out of large blocks,
+ * and are all freed at once by path_arena_reset. An arena is not 
+ * thread safe.
+ * 
+ * @param pp_arena   return
+ * @param block_size the size of each block, or 0 for PATH_ARENA_BLOCK_SIZE
+ * 
+ * @sa path_arena_allocator
+ * 
+ * @return 1 on success, 0 on error
+*/
+DLLEXPORT int path_arena_create ( path_arena **pp_arena, size_t block_size );
+
+/** !
+ * Make an allocator that allocates from an arena
+ * 
+ * @param p_arena     the arena
+ * @param p_allocator return
+ * 
+ * @sa path_open_with_allocator
+ * 
+ * @return 1 on success, 0 on error
+*/
+DLLEXPORT int path_arena_allocator ( path_arena *p_arena, path_allocator *p_allocator );
+
+/** !
+ * Free everything allocated from an arena, and keep its first block
+ * for reuse. Paths allocated from the arena must not be used after.
+ * 
+ * @param p_arena the arena
+ * 
+ * @return 1 on success, 0 on error
+*/
+DLLEXPORT int path_arena_reset ( path_arena *p_arena );
+
+/** !
+ * Destroy an arena
+ * 
+ * @param pp_arena pointer to arena pointer
+ * 
+ * @return 1 on success, 0 on error
+*/
+DLLEXPORT int path_arena_destroy ( path_arena **pp_arena );
+
+// Configuration
+/** !
+ * Set the backend used to enumerate directory contents. If the requested backend 
+ * is not available on this platform, the readdir backend is used.
+ * 
+ * @param backend < PATH_ENUMERATION_DEFAULT | PATH_ENUMERATION_READDIR | PATH_ENUMERATION_GETDENTS >
+ * 
+ * @return 1 on success, 0 on error
+*/
+DLLEXPORT int path_enumeration_backend_set ( path_enumeration_backend backend );
+
+/** !
+ * Set the backend used to read the metadata of directory entries, when a path 
+ * is opened with PATH_OPEN_METADATA. If io_uring is requested, and it can not 
+ * be used, the fstatat backend is used.
+ * 
+ * @param backend < PATH_METADATA_DEFAULT | PATH_METADATA_FSTATAT | PATH_METADATA_IO_URING >
+ * 
+ * @sa path_open_with_flags
+ * 
+ * @return 1 on success, 0 on error
+*/
+DLLEXPORT int path_metadata_backend_set ( path_metadata_backend backend );
+
+/** !
+ * Get the inotify descriptor shared by paths opened with 
+ * PATH_OPEN_WATCH, so an event loop can poll it, and call 
+ * path_watch_process when it is readable.
+ * 
+ * @return the descriptor, or -1 if inotify is unavailable
+*/
+DLLEXPORT int path_watch_fd ( void );
+
+/** !
+ * Apply pending inotify events to the listings of watched paths.
+ * Must not run while another thread reads a watched path. Reading
+ * a watched path patches only its own listing, and marks the 
+ * listings of other watched paths to be read again, so paths may 
+ * be read from different threads.
+ * 
+ * @return 1 on success, 0 on error
+*/
+DLLEXPORT int path_watch_process ( void );
+
 // Constructors
 /** !
  * Construct a path from a string if pp_path references null pointer else update an existing path
@@ -97,6 +448,43 @@ DLLEXPORT int path_create ( path **pp_path );
 */
 DLLEXPORT int path_open ( path **pp_path, const char *path );
 
+/** !
+ * Construct a path from a string, with flags. When PATH_OPEN_METADATA is set, 
+ * the metadata of each directory entry is read while the directory is listed. 
+ * Otherwise, entry types come from the directory itself, and metadata is only
+ * read on request. When PATH_OPEN_WATCH is set, listings are patched by inotify
+ * events instead of being read again. When PATH_OPEN_HANDLE is set, the path
+ * keeps the directories it navigates through open, up to PATH_HANDLE_DEPTH,
+ * and navigating to ".." returns to them without resolving any text.
+ * 
+ * @param pp_path return
+ * @param path    the path, as a string
+ * @param flags   < PATH_OPEN_DEFAULT | PATH_OPEN_METADATA | PATH_OPEN_WATCH | PATH_OPEN_HANDLE >
+ * 
+ * @sa path_open
+ * @sa path_directory_content_metadata
+ * 
+ * @return 1 on success, 0 on error
+*/
+DLLEXPORT int path_open_with_flags ( path **pp_path, const char *path, int flags );
+
+/** !
+ * Construct a path from a string, with flags, and an allocator. The path, 
+ * its listings, and its cursors are allocated with the allocator. The 
+ * dict and stack submodules still use their own compile time allocators.
+ * 
+ * @param pp_path     return
+ * @param path        the path, as a string
+ * @param flags       < PATH_OPEN_DEFAULT | PATH_OPEN_METADATA | PATH_OPEN_WATCH | PATH_OPEN_HANDLE >
+ * @param p_allocator the allocator, or null pointer for PATH_REALLOC
+ * 
+ * @sa path_open_with_flags
+ * @sa path_arena_allocator
+ * 
+ * @return 1 on success, 0 on error
+*/
+DLLEXPORT int path_open_with_allocator ( path **pp_path, const char *path, int flags, const path_allocator *const p_allocator );
+
 // Accessors
 /** !
  * Get the type of a path. The name of this function is bad.
@@ -138,7 +526,8 @@ DLLEXPORT const char *path_full_path_text ( const path *const p_path );
 DLLEXPORT int path_file_size ( const path *const p_path, size_t *p_size_in_bytes );
 
 /** !
- *  Get the names of the directory's contents as path names, or the number of items in the directory
+ *  Get the names of the directory's contents as path names, or the number of items in the directory.
+ *  Names are sorted, and point into the listing of the directory
  *
  * @param p_path
  * @param names   return -OR- null pointer
@@ -148,18 +537,36 @@ DLLEXPORT int path_file_size ( const path *const p_path, size_t *p_size_in_bytes
 DLLEXPORT size_t path_directory_content_names ( const path *const p_path, const char **const names );
 
 /** !
- *  Get the types of the directory's contents, or the number of items in the directory
+ *  Get the types of the directory's contents, or the number of items in the directory.
+ *  Types are in the same order as the names from path_directory_content_names
  *
  * @param p_path
  * @param types   return -OR- null pointer
  *
  * @return 1 on success, 0 on error, if keys != null, else number of properties in directory
  */
-DLLEXPORT size_t path_directory_content_types ( const path *const p_path, const path_type *types );
+DLLEXPORT size_t path_directory_content_types ( const path *const p_path, path_type *const types );
+
+/** !
+ *  Get the metadata of an item in a directory
+ *
+ * @param p_path     the directory
+ * @param name       the name of the item in the directory
+ * @param p_metadata return
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int path_directory_content_metadata ( const path *const p_path, const char *name, path_metadata *p_metadata );
 
 // Mutators
 /** !
- * Navigate the filesystem from a source path
+ * Navigate the filesystem from a source path. The path text may 
+ * hold many names, separated by '/'. Directories along the way 
+ * are opened, but not listed. Each name is opened relative to 
+ * the directory before it, so a step costs the same at any depth.
+ * With PATH_OPEN_HANDLE, ".." returns to the directory the path 
+ * came from, even through a symbolic link. Every name resolves 
+ * before the path changes, so on error the path is unchanged. 
  * 
  * @param pp_path   pointer to source path
  * @param path_text text to append to path
@@ -183,6 +590,24 @@ DLLEXPORT int path_navigate ( path **pp_path, const char *path_text );
 */
 DLLEXPORT int path_create_file ( path *p_path, const char *path );
 
+/** !
+ * Make many files in the specified path. Each file is created 
+ * relative to the directory, and truncated if it exists. With 
+ * PATH_CREATE_IO_URING, the files are opened, and closed, in 
+ * batches of PATH_IO_URING_QUEUE_DEPTH requests, with one system
+ * call for each batch. 
+ * 
+ * @param p_path the specified path
+ * @param names  the name of each file
+ * @param count  the quantity of files
+ * @param flags  < PATH_CREATE_DEFAULT | PATH_CREATE_IO_URING >
+ * 
+ * @sa path_create_file
+ * 
+ * @return 1 on success, 0 if any file could not be created
+*/
+DLLEXPORT int path_create_files ( path *p_path, const char *const *names, size_t count, int flags );
+
 /** !
  * Make a directory in the specified path
  * 
@@ -197,7 +622,105 @@ DLLEXPORT int path_create_file ( path *p_path, const char *path );
 DLLEXPORT int path_create_directory ( path *p_path, const char *path );
 
 /** !
- * Remove a file / directory from the specified path
+ * Make a directory, and each missing directory above it, like 
+ * mkdir -p. Missing directories are made one at a time, relative
+ * to their parent, starting from the deepest one that exists. A 
+ * directory that already exists, or that another process makes 
+ * at the same time, is not an error.
+ * 
+ * @param p_path    the specified path
+ * @param path_text the directories, separated by '/'
+ * 
+ * @sa path_create_directory
+ * 
+ * @return 1 on success, 0 on error
+*/
+DLLEXPORT int path_create_directories ( path *p_path, const char *path_text );
+
+/** !
+ * Make many directory trees in the specified path, each like 
+ * path_create_directories, relative to the same directory
+ * 
+ * @param p_path the specified path
+ * @param paths  the directories of each tree, separated by '/'
+ * @param count  the quantity of trees
+ * 
+ * @sa path_create_directories
+ * 
+ * @return 1 on success, 0 if any tree could not be made
+*/
+DLLEXPORT int path_create_directory_trees ( path *p_path, const char *const *paths, size_t count );
+
+/** !
+ * Copy a file. The copy shares the extents of the source on file 
+ * systems that support reflinks. Otherwise the kernel copies it 
+ * with copy_file_range, or sendfile, and only when neither works 
+ * is it copied through a buffer. 
+ * 
+ * The copy is made beside the destination, and renamed over it 
+ * when it is done, so a failed copy leaves the destination as it
+ * was. A file can't be copied onto itself, or onto another name 
+ * for it.
+ * 
+ * @param p_source         the directory that contains the file
+ * @param source_name      the name of the file
+ * @param p_destination    the directory to copy the file to
+ * @param destination_name the name of the copy
+ * @param flags            < PATH_COPY_DEFAULT | PATH_COPY_PRESERVE >
+ * 
+ * @return 1 on success, 0 on error
+*/
+DLLEXPORT int path_copy_file ( const path *const p_source, const char *source_name, const path *const p_destination, const char *destination_name, int flags );
+
+/** !
+ * Write a file atomically. The contents are written to a file 
+ * without a name, or with a temporary one, which is flushed, and 
+ * then renamed over the old file. Readers see the old contents, 
+ * or the new contents, never a part of either. When this returns,
+ * the file, and its name, survive a crash, unless the flags are 
+ * PATH_WRITE_NO_SYNC. The file is made with mode 0666, less the 
+ * umask, whatever the mode of the file it replaces.
+ * 
+ * @param p_path   the directory that contains the file
+ * @param name     the name of the file
+ * @param p_buffer the contents of the file
+ * @param size     the size of the contents, in bytes
+ * @param flags    < PATH_WRITE_DEFAULT | PATH_WRITE_NO_SYNC >
+ * 
+ * @sa path_write_atomic_files
+ * 
+ * @return 1 on success, 0 on error
+*/
+DLLEXPORT int path_write_atomic ( path *p_path, const char *name, const void *p_buffer, size_t size, int flags );
+
+/** !
+ * Write many files atomically, each like path_write_atomic. The 
+ * files are written in batches of PATH_WRITE_BATCH_SIZE, and each
+ * batch is flushed before any file in it is renamed into place. 
+ * With PATH_WRITE_SYNCFS, a batch is flushed with one syncfs of 
+ * the file system, instead of one fdatasync for each file. The 
+ * directory is flushed once, after the last batch. 
+ * 
+ * @param p_path  the directory that contains the files
+ * @param names   the name of each file
+ * @param buffers the contents of each file
+ * @param sizes   the size of the contents of each file, in bytes
+ * @param count   the quantity of files
+ * @param flags   < PATH_WRITE_DEFAULT | PATH_WRITE_SYNCFS | PATH_WRITE_NO_SYNC >
+ * 
+ * @sa path_write_atomic
+ * 
+ * @return 1 on success, 0 if any file could not be written
+*/
+DLLEXPORT int path_write_atomic_files ( path *p_path, const char *const *names, const void *const *buffers, const size_t *sizes, size_t count, int flags );
+
+/** !
+ * Remove a file / directory from the specified path. Directories 
+ * are removed with everything in them, on a pool of threads, with 
+ * each entry unlinked relative to the fd of its directory. Symbolic
+ * links are removed, but never followed. Names that end with "." or
+ * "..", and empty names, are refused, since they name the directory
+ * itself, or one above it.
  * 
  * @param p_path the specified path
  * @param path the name of the file/directory
@@ -208,6 +731,24 @@ DLLEXPORT int path_create_directory ( path *p_path, const char *path );
 */
 DLLEXPORT int path_remove ( path *p_path, const char *path );
 
+/** !
+ * Only list the names in a directory that match a pattern. Other 
+ * names are skipped while the directory is read, before they are
+ * stored or stat'd. The filter applies to every directory that is
+ * listed through the path, and to its cursors. 
+ * 
+ * The pattern is not copied, and must outlive the path, or be 
+ * replaced first. 
+ * 
+ * @param p_path    the path
+ * @param p_pattern the pattern -OR- null pointer to list every name
+ * 
+ * @sa path_pattern_compile
+ * 
+ * @return 1 on success, 0 on error
+*/
+DLLEXPORT int path_directory_filter ( path *p_path, const path_pattern *const p_pattern );
+
 // Iterators
 /** !
  * Call a function for each path in a directory
@@ -219,6 +760,347 @@ DLLEXPORT int path_remove ( path *p_path, const char *path );
 */
 DLLEXPORT int path_directory_foreach_i ( const path *const p_path, void (*pfn_path_iter)(const char *full_path, path_type type, size_t i));
 
+/** !
+ * Call a function for each entry in a directory, in name order, 
+ * without allocating. The listing is read in place, and the 
+ * callback may stop the iteration early by returning 0
+ * 
+ * @param p_path      the directory
+ * @param pfn_foreach the callback, called with each entry and the context
+ * @param p_context   passed to each call of the callback
+ * 
+ * @return 1 on success, 0 on error
+*/
+DLLEXPORT int path_directory_foreach ( const path *const p_path, fn_path_foreach pfn_foreach, void *p_context );
+
+/** !
+ * Call a function for each entry in a directory with a name that
+ * matches a pattern, in name order, without allocating
+ * 
+ * @param p_path      the directory
+ * @param p_pattern   the pattern -OR- null pointer for every entry
+ * @param pfn_foreach the callback, called with each entry and the context
+ * @param p_context   passed to each call of the callback
+ * 
+ * @sa path_directory_foreach
+ * 
+ * @return 1 on success, 0 on error
+*/
+DLLEXPORT int path_directory_foreach_match ( const path *const p_path, const path_pattern *const p_pattern, fn_path_foreach pfn_foreach, void *p_context );
+
+/** !
+ * Recursively walk every path beneath a directory, on a pool of 
+ * work stealing threads. The callback is invoked for each path,
+ * with the full path, the type, and the depth. The entries of 
+ * the root are at depth 1. 
+ * 
+ * The callback may be invoked from many threads at once, and the 
+ * order of the paths is unspecified. Symbolic links are reported, 
+ * but never followed. Unreadable directories are skipped.
+ * 
+ * @param p_path       the root directory
+ * @param thread_count the quantity of threads, or 0 for one per processor
+ * @param pfn_walk     the callback
+ * @param p_context    a parameter passed to every call of the callback
+ * 
+ * @return 1 on success, 0 on error
+*/
+DLLEXPORT int path_walk ( const path *const p_path, size_t thread_count, fn_path_walk pfn_walk, void *p_context );
+
+/** !
+ * Find every path beneath a directory that matches a glob, like 
+ * "docs/{api,guide}.md". Each component of the glob,
+ * between two '/', is matched against one level of the tree, with
+ * the syntax of path_pattern_compile. "**" matches any quantity of
+ * visible directories, including none. 
+ * 
+ * Only directories that can still match are read, and literal 
+ * components are opened without reading their parent at all. 
+ * Entries are only stat'd when they might match. 
+ * 
+ * The callback is invoked with the full path, the type, and the
+ * depth of each match. Returning PATH_WALK_SKIP from a directory
+ * doesn't look for more matches beneath it. Symbolic links are
+ * reported, and followed by every component except "**".
+ * 
+ * @param p_path       the directory to match beneath
+ * @param pattern_text the glob
+ * @param pfn_glob     the callback
+ * @param p_context    passed to each call of the callback
+ * 
+ * @sa path_pattern_compile
+ * 
+ * @return 1 on success, 0 on error
+*/
+DLLEXPORT int path_glob ( const path *const p_path, const char *pattern_text, fn_path_walk pfn_glob, void *p_context );
+
+/** !
+ * Measure the disk usage of a directory tree, on a pool of work 
+ * stealing threads. Hard linked files are counted once, however 
+ * many names they have. Symbolic links are measured, but never 
+ * followed. Each directory is opened relative to its parent, so 
+ * the depth of the tree isn't limited by the length of a path. 
+ * A directory that can't be opened or read is an error, since the 
+ * usage would be undercounted. 
+ * 
+ * The optional callback is invoked once for each directory, when 
+ * it and every directory beneath it are measured, with the usage
+ * of the subtree. It may be invoked from many threads at once.
+ * 
+ * @param p_path       the directory, or a file
+ * @param thread_count the quantity of threads, or 0 for one thread per processor
+ * @param p_usage      return
+ * @param pfn_usage    the callback -OR- null pointer
+ * @param p_context    passed to each call of the callback
+ * 
+ * @return 1 on success, 0 on error
+*/
+DLLEXPORT int path_disk_usage ( const path *const p_path, size_t thread_count, path_usage *p_usage, fn_path_usage pfn_usage, void *p_context );
+
+/** !
+ * Compute the SHA-256 hash of each file in a directory tree. Walker 
+ * threads queue the files they find, and hashing threads take them
+ * from the queue, so hashing never waits for the walk, and the walk
+ * waits for hashing only when the queue is full. Files are read 
+ * into a buffer that each hashing thread reuses. Symbolic links, 
+ * and files that can't be read, are skipped.
+ * 
+ * The callback may be invoked from many threads at once.
+ * 
+ * @param p_path       the directory, or a file
+ * @param walker_count the quantity of walker threads, or 0 for one thread per processor
+ * @param hasher_count the quantity of hashing threads, or 0 for one thread per processor
+ * @param pfn_hash     called once for each file
+ * @param p_context    passed to each call of the callback
+ * 
+ * @return 1 on success, 0 on error
+*/
+DLLEXPORT int path_hash_tree ( const path *const p_path, size_t walker_count, size_t hasher_count, fn_path_hash pfn_hash, void *p_context );
+
+/** !
+ * Find sets of regular files with the same contents, in a directory
+ * tree. Only files of the same size are compared. Then, only files 
+ * with the same hash of their first and last 4 KiB are hashed in 
+ * full, so most files are read partly, or not at all. Each stage 
+ * runs on a pool of threads. 
+ * 
+ * Hard links to the same inode aren't duplicates, and only one of
+ * their names is reported. Empty files, and symbolic links, are 
+ * ignored.
+ * 
+ * @param p_path         the directory
+ * @param thread_count   the quantity of threads, or 0 for one thread per processor
+ * @param minimum_size   files smaller than this are ignored
+ * @param pfn_duplicates called once for each set of duplicates
+ * @param p_context      passed to each call of the callback
+ * 
+ * @return 1 on success, 0 on error
+*/
+DLLEXPORT int path_find_duplicates ( const path *const p_path, size_t thread_count, unsigned long long minimum_size, fn_path_duplicates pfn_duplicates, void *p_context );
+
+// Cursors
+/** !
+ * Open a cursor over the contents of a directory. Entries are 
+ * read from the file system as the cursor advances, in constant 
+ * memory, and are not stored in the path.
+ * 
+ * @param pp_cursor return
+ * @param p_path    the directory
+ * 
+ * @sa path_dir_cursor_next
+ * @sa path_dir_cursor_close
+ * 
+ * @return 1 on success, 0 on error
+*/
+DLLEXPORT int path_dir_cursor_open ( path_dir_cursor **pp_cursor, const path *const p_path );
+
+/** !
+ * Advance a cursor to the next entry in a directory. The name is 
+ * valid until the next call to this function.
+ * 
+ * @param p_cursor the cursor
+ * @param pp_name  return
+ * @param p_type   return, or null pointer to skip typing the entry
+ * 
+ * @return 1 if an entry was read, 0 at the end of the directory or on error
+*/
+DLLEXPORT int path_dir_cursor_next ( path_dir_cursor *p_cursor, const char **pp_name, path_type *p_type );
+
+/** !
+ * Close a directory cursor
+ * 
+ * @param pp_cursor pointer to cursor pointer
+ * 
+ * @return 1 on success, 0 on error
+*/
+DLLEXPORT int path_dir_cursor_close ( path_dir_cursor **pp_cursor );
+
+// Patterns
+/** !
+ * Compile a glob pattern that matches names. '*' matches any run
+ * of characters, '?' matches one character, "[...]" matches one
+ * character in a set, with ranges, and "[!...]" matches one that
+ * isn't. "{a,b}" matches either alternative, and may nest. A 
+ * backslash escapes the next character. As in the shell, names that begin 
+ * with '.' only match patterns that begin with a literal '.'
+ * 
+ * @param pp_pattern   return
+ * @param pattern_text the pattern
+ * 
+ * @return 1 on success, 0 on error
+*/
+DLLEXPORT int path_pattern_compile ( path_pattern **pp_pattern, const char *pattern_text );
+
+/** !
+ * Test a name against a compiled pattern
+ * 
+ * @param p_pattern the pattern
+ * @param name      the name
+ * 
+ * @return true if the name matches, else false
+*/
+DLLEXPORT bool path_pattern_match ( const path_pattern *const p_pattern, const char *name );
+
+/** !
+ * Free a compiled pattern
+ * 
+ * @param pp_pattern pointer to pattern
+ * 
+ * @return 1 on success, 0 on error
+*/
+DLLEXPORT int path_pattern_destroy ( path_pattern **pp_pattern );
+
+// Snapshots
+/** !
+ * Scan a directory tree, and save it to a snapshot file. A snapshot 
+ * is a compact binary index of the tree, with the name, parent, type,
+ * mode, size, modification time and inode of each entry. Symbolic 
+ * links are recorded, but never followed. Each directory is opened
+ * relative to its parent, so the depth of the tree isn't limited by
+ * the length of a path. Directories the caller may not read are 
+ * recorded as empty. Any other directory that can't be opened is an 
+ * error, since the snapshot would be missing entries. 
+ * 
+ * Snapshots are written in the byte order of the host. An existing
+ * snapshot is replaced atomically, so readers see the old snapshot 
+ * or the new one, never a part of either.
+ * 
+ * @param p_path        the root of the tree
+ * @param snapshot_path the path of the snapshot file
+ * 
+ * @return 1 on success, 0 on error
+*/
+DLLEXPORT int path_snapshot_save ( const path *const p_path, const char *snapshot_path );
+
+/** !
+ * Open a snapshot file. The file is mapped read only, and isn't 
+ * copied, so every process that opens the same snapshot shares its
+ * memory. The columns, and the shape of the tree, are checked once
+ * on open, so a damaged snapshot is refused, not followed.
+ * 
+ * @param pp_snapshot   return
+ * @param snapshot_path the path of the snapshot file
+ * 
+ * @sa path_snapshot_save
+ * @sa path_snapshot_close
+ * 
+ * @return 1 on success, 0 on error
+*/
+DLLEXPORT int path_snapshot_open ( path_snapshot **pp_snapshot, const char *snapshot_path );
+
+/** !
+ * Get the quantity of entries in a snapshot, including the root
+ * 
+ * @param p_snapshot the snapshot
+ * 
+ * @return the quantity of entries on success, 0 on error
+*/
+DLLEXPORT size_t path_snapshot_count ( const path_snapshot *const p_snapshot );
+
+/** !
+ * Get an entry of a snapshot. The root is entry 0. The name is 
+ * valid until the snapshot is closed.
+ * 
+ * @param p_snapshot the snapshot
+ * @param index      the index of the entry
+ * @param p_entry    return
+ * 
+ * @return 1 on success, 0 on error
+*/
+DLLEXPORT int path_snapshot_get ( const path_snapshot *const p_snapshot, size_t index, path_snapshot_entry *p_entry );
+
+/** !
+ * Write the full path of an entry of a snapshot to a buffer
+ * 
+ * @param p_snapshot  the snapshot
+ * @param index       the index of the entry
+ * @param p_buffer    return
+ * @param buffer_size the size of the buffer
+ * 
+ * @return the length of the full path. If it is not less than the buffer size, nothing is written
+*/
+DLLEXPORT size_t path_snapshot_full_path ( const path_snapshot *const p_snapshot, size_t index, char *p_buffer, size_t buffer_size );
+
+/** !
+ * Compare two snapshots, on a pool of work stealing threads. The
+ * contents of each directory are compared in a single pass, since
+ * they are stored sorted by name. When a directory is added or 
+ * removed, only the directory is reported, not its contents.
+ * 
+ * Modifications are reported while the trees are compared, and 
+ * the callback may be invoked from many threads at once. Added, 
+ * removed and renamed entries are reported from the calling thread,
+ * in order of path, after the trees are compared.
+ * 
+ * A directory's modification time only changes when entries are 
+ * added to it, or removed from it. With PATH_DIFF_TRUST_DIRECTORIES,
+ * a subtree is skipped when its directory has the same modification
+ * time and quantity of entries in both trees, which misses changes 
+ * to the contents of files beneath it.
+ * 
+ * @param p_old        the old snapshot
+ * @param p_new        the new snapshot
+ * @param thread_count the quantity of threads, or 0 for one thread per processor
+ * @param flags        < PATH_DIFF_DEFAULT | PATH_DIFF_TRUST_DIRECTORIES >
+ * @param pfn_diff     called for each difference
+ * @param p_context    passed to each call of the callback
+ * 
+ * @return 1 on success, 0 on error
+*/
+DLLEXPORT int path_diff ( const path_snapshot *const p_old, const path_snapshot *const p_new, size_t thread_count, int flags, fn_path_diff pfn_diff, void *p_context );
+
+/** !
+ * Compare a snapshot against the tree beneath a directory, as it 
+ * is now. Directories are read from the file system. With 
+ * PATH_DIFF_TRUST_DIRECTORIES, as with path_diff, a subtree is 
+ * skipped when its directory has the same modification time and 
+ * quantity of entries as in the snapshot. The directory is still
+ * read, to count its entries, but nothing beneath it is stated or
+ * compared, so changes to the contents of files beneath it are 
+ * missed.
+ * 
+ * @param p_old        the old snapshot
+ * @param p_path       the root of the live tree
+ * @param thread_count the quantity of threads, or 0 for one thread per processor
+ * @param flags        < PATH_DIFF_DEFAULT | PATH_DIFF_TRUST_DIRECTORIES >
+ * @param pfn_diff     called for each difference
+ * @param p_context    passed to each call of the callback
+ * 
+ * @sa path_diff
+ * 
+ * @return 1 on success, 0 on error
+*/
+DLLEXPORT int path_diff_live ( const path_snapshot *const p_old, const path *const p_path, size_t thread_count, int flags, fn_path_diff pfn_diff, void *p_context );
+
+/** !
+ * Close a snapshot
+ * 
+ * @param pp_snapshot pointer to snapshot pointer
+ * 
+ * @return 1 on success, 0 on error
+*/
+DLLEXPORT int path_snapshot_close ( path_snapshot **pp_snapshot );
+
 // Destructors
 /** !
  * Close a path
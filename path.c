@@ -1,6 +1,114 @@
 // Header file 
 #include <path/path.h>
 
+// Forward declarations
+struct path_statx_batch_s;
+
+// Arena allocations are preceded by their size, and aligned for any type
+#define PATH_ARENA_HEADER_SIZE 16
+#define PATH_ARENA_ALIGN(size) ( ( (size) + 15 ) & ~(size_t) 15 )
+
+// A block of memory in an arena
+typedef struct path_arena_block_s
+{
+    _Alignas(16) struct path_arena_block_s *p_next;
+    size_t                                  size,
+                                            used;
+    _Alignas(16) char                       data[];
+} path_arena_block;
+
+// A bump allocator. Blocks are pushed onto the current block, and the first block is never freed
+struct path_arena_s
+{
+    size_t            block_size;
+    path_arena_block *p_first,
+                     *p_current;
+};
+
+// A directory listing, as columns sorted by name. Names are packed back to back 
+// in one block of memory, and entries refer to them by offset. Lookups are binary
+// searches. The memory of each column is kept when a directory is listed again
+typedef struct
+{
+    char           *p_names;    // Names, each null terminated
+    size_t          names_len,
+                    names_max,
+                    names_dead; // Bytes of names of removed entries
+    unsigned int   *p_offsets;  // Offset of the name of each entry in p_names
+    unsigned char  *p_types;    // path_type of each entry
+    path_metadata  *p_metadata; // Metadata of each entry, with PATH_OPEN_METADATA. A type of 0 means none
+    size_t          count,
+                    max;
+    path_allocator  allocator;
+} path_listing;
+
+// Brace alternation expands a pattern into many. This bounds the expansion
+#define PATH_PATTERN_MAX_ALTERNATIVES 256
+
+// A step of a compiled glob
+typedef struct
+{
+    enum
+    {
+        PATH_PATTERN_OP_LITERAL, // Match a run of text
+        PATH_PATTERN_OP_ANY,     // '?' matches one character
+        PATH_PATTERN_OP_STAR,    // '*' matches any run of characters
+        PATH_PATTERN_OP_CLASS    // '[...]' matches one character in a set
+    } kind;
+    size_t        offset,   // Literal text, in the text of the pattern
+                  length;
+    unsigned char set[32];  // Character set, one bit per byte value
+} path_pattern_op;
+
+// One brace free alternative of a compiled glob
+typedef struct
+{
+    enum
+    {
+        PATH_PATTERN_EXACT,         // "name"
+        PATH_PATTERN_PREFIX,        // "name*"
+        PATH_PATTERN_SUFFIX,        // "*.o"
+        PATH_PATTERN_PREFIX_SUFFIX, // "name*.o"
+        PATH_PATTERN_GENERAL        // Anything else
+    } kind;
+    size_t first_op,
+           op_count,
+           prefix_offset,
+           prefix_length,
+           suffix_offset,
+           suffix_length;
+    bool   leading_dot; // True if the pattern begins with a literal '.', and so may match hidden names
+} path_pattern_alternative;
+
+// A compiled glob
+struct path_pattern_s
+{
+    char                     *p_text;         // Literal text of every op
+    size_t                    text_len,
+                              text_max;
+    path_pattern_op          *p_ops;
+    size_t                    op_count,
+                              op_max;
+    path_pattern_alternative *p_alternatives;
+    size_t                    alternative_count,
+                              alternative_max;
+};
+
+// A directory above a path opened with PATH_OPEN_HANDLE
+typedef struct
+{
+    int    fd;          // The directory, or -1 if the path below it was a file, and so kept the directory
+    size_t i_text_name; // Index of the name of the directory in the full path
+} path_ancestor;
+
+// A directory that navigation passed through, before the navigation is stored in the path
+typedef struct
+{
+    int    fd;          // The directory, or -1 if the path below it was a file, and so kept the directory
+    size_t i_text_name; // Index of the name of the directory in the text
+    bool   owned;       // True if navigation opened the directory, and so closes it on error
+} path_navigate_ancestor;
+
 // Structure definitions
 struct path_s
 {
@@ -8,6 +116,12 @@ struct path_s
     // Path type
     path_type type; 
 
+    // < PATH_OPEN_DEFAULT | PATH_OPEN_METADATA | PATH_OPEN_WATCH | PATH_OPEN_HANDLE >
+    int flags;
+
+    // Allocator for everything this path owns
+    path_allocator allocator;
+
     // Path as text
     struct 
     {
@@ -32,227 +146,631 @@ struct path_s
     // Path 
     struct
     {
-        bool dirty;
-        union {
-            size_t  file;      // Size of the file in bytes
-            dict   *directory; // Directory contents in a dict as < path_name_text : path_type >
-        };
+        bool dirty,
+             listed; // True once the contents of the directory have been read
+        size_t file; // Size of the file in bytes
+
+        // Directory contents
+        path_listing listing;
+
+        // Identity and timestamps of the directory, from the last stat
+        unsigned long long device,
+                           inode;
+        struct timespec    modified,
+                           changed,
+                           listed_at; // When the listing was read
     } data;
-};
-
-int path_update_full_path ( path *p_path )
-{
-
-    // Argument check
-    if ( p_path == (void *) 0 ) goto no_path;
 
-    // Initialized data
-    char *slash_name = 1+strrchr(p_path->full_path.text, '/');
+    // inotify watch on the open directory, when the path was opened with PATH_OPEN_WATCH
+    struct
+    {
+        int  wd;    // Watch descriptor, or -1
+        bool stale; // True if the listing must be read again. Set atomically by other threads
+    } watch;
 
-    // Get the name of the path
-    p_path->full_path.text_name = slash_name;
+    // Listings of directories that were visited before
+    struct
+    {
+        struct path_listing_cache_entry_s *p_entries;
+        size_t                             count;
+        unsigned long long                 clock;
+    } listing_cache;
 
-    // Get the index of the last / character
-    p_path->full_path.i_text_name = ( slash_name - p_path->full_path.text );
+    // Directory enumeration
+    struct
+    {
+        char   *p_buffer;    // Reusable getdents64 buffer
+        size_t  buffer_size;
+    } enumeration;
 
-    // Get the length of the full path
-    p_path->full_path.text_len = ( slash_name + strlen(slash_name) ) - p_path->full_path.text;
+    // Open directory
+    struct
+    {
+        int  fd;            // The path, if it is a directory, else the directory that contains it
+        bool contains_path; // True if fd refers to the directory that contains the path
+    } directory;
 
-    p_path->full_path.text[p_path->full_path.text_len] = '\0';
+    // Directories above the path, with PATH_OPEN_HANDLE. The newest are kept, in a ring
+    struct
+    {
+        path_ancestor *p_entries;
+        size_t         first,
+                       count;
+    } ancestors;
 
-    // Clear dirty flag
-    p_path->full_path.dirty = false;
+    // Batched metadata requests, when the io_uring metadata backend is used
+    struct path_statx_batch_s *p_statx_batch;
 
-    // Success
-    return 1;
+    // Names that don't match are left out of listings. Owned by the caller
+    const path_pattern *p_pattern;
+};
 
-    no_path:
+// Directory reader. Yields the names in a directory, one at a time, from 
+// either a batched getdents64 buffer or from readdir
+typedef struct
+{
+    path_enumeration_backend backend;
+    DIR                     *p_directory;
+    int                      fd;
+    char                    *p_buffer;
+    size_t                   buffer_size,
+                             buffer_len,
+                             buffer_position;
+    bool                     failed; // True if the directory could not be read to the end
+} path_directory_reader;
+
+// A listing of a directory that was visited before, and the timestamps it was valid for
+typedef struct path_listing_cache_entry_s
+{
+    unsigned long long  device,
+                        inode,
+                        used;
+    struct timespec     modified,
+                        changed,
+                        listed_at;
+    path_listing        listing;
+} path_listing_cache_entry;
+
+// A streaming cursor over the contents of a directory
+struct path_dir_cursor_s
+{
+    path_allocator         allocator;
+    path_directory_reader  reader;
+    int                    fd;          // The cursor's own descriptor, so its offset is independent of the path
+    char                  *p_buffer;
+    size_t                 buffer_size;
+    const path_pattern    *p_pattern;   // Names that don't match are skipped
+};
 
-    // Error
-    return 0;
-}
+#ifdef __linux__
 
-int path_update_data ( path *p_path ) 
+// Layout of the records written by the getdents64 system call
+struct path_linux_dirent64
 {
+    unsigned long long d_ino;
+    long long          d_off;
+    unsigned short     d_reclen;
+    unsigned char      d_type;
+    char               d_name[];
+};
+#endif
 
-    // Argument check
-    if ( p_path == (void *) 0 ) goto no_path;
-    
-    // Clear the dirty bit
-    if ( p_path->data.dirty == false ) goto not_dirty;
+#ifdef PATH_HAS_IO_URING
 
-    // Initialized data
-    size_t path_name_len = strlen(p_path->full_path.text_name);
-    size_t full_path_len = strlen(p_path->full_path.text);
-    struct stat st = { 0 };
+// Mask of the fields requested from statx
+#define PATH_STATX_BASIC_STATS 0x000007ffU
 
-    // Check path
-    if ( stat(p_path->full_path.text, &st) == -1 ) 
-    {
+// Layout of the buffer written by the statx system call
+struct path_statx_timestamp
+{
+    long long    tv_sec;
+    unsigned int tv_nsec;
+    int          __reserved;
+};
 
-        // Set invalid state
-        p_path->type = 0;
+struct path_statx
+{
+    unsigned int                stx_mask,
+                                stx_blksize;
+    unsigned long long          stx_attributes;
+    unsigned int                stx_nlink,
+                                stx_uid,
+                                stx_gid;
+    unsigned short              stx_mode,
+                                __spare0;
+    unsigned long long          stx_ino,
+                                stx_size,
+                                stx_blocks,
+                                stx_attributes_mask;
+    struct path_statx_timestamp stx_atime,
+                                stx_btime,
+                                stx_ctime,
+                                stx_mtime;
+    unsigned int                stx_rdev_major,
+                                stx_rdev_minor,
+                                stx_dev_major,
+                                stx_dev_minor;
+    unsigned long long          __spare2[14];
+};
 
-        // Error
-        goto no_file;
-    }
+// An io_uring instance, and its memory mapped rings
+typedef struct
+{
+    int                  fd;
+    unsigned int        *p_sq_head,
+                        *p_sq_tail,
+                        *p_sq_mask,
+                        *p_sq_array,
+                        *p_cq_head,
+                        *p_cq_tail,
+                        *p_cq_mask;
+    struct io_uring_sqe *p_sqes;
+    struct io_uring_cqe *p_cqes;
+    void                *p_sq_ring,
+                        *p_cq_ring;
+    size_t               sq_ring_size,
+                         cq_ring_size,
+                         sqes_size;
+} path_io_uring;
+
+// A batch of statx requests, relative to one directory
+typedef struct path_statx_batch_s
+{
+    path_io_uring      ring;
+    size_t             count;
+    size_t             entries[PATH_IO_URING_QUEUE_DEPTH]; // Index of each entry in the listing
+    struct path_statx  statx[PATH_IO_URING_QUEUE_DEPTH];
+    path_allocator     allocator;
+} path_statx_batch;
+#endif
 
-    // Directory
-    if ( ( st.st_mode & S_IFMT ) == S_IFDIR )
-    {
+// Initial capacity of a work stealing deque. Must be a power of two
+#define PATH_DEQUE_INITIAL_CAPACITY 64
 
-        // Initialized data
-        dict *p_dict      = p_path->data.directory;
-        DIR  *p_directory = { 0 };
-        struct dirent *p_file_directory_entry = { 0 };
+// Forward declarations
+struct path_worker_s;
 
-        // State check
-        if ( p_path->type != PATH_TYPE_DIRECTORY )
-        {
+// Type definitions
+typedef void (*fn_path_task)(struct path_worker_s *p_worker, void *p_argument);
 
-            // Set the type            
-            p_path->type = PATH_TYPE_DIRECTORY;
-            
-            // Allocate a dictionary
-            dict_construct(&p_dict, 32, 0);
-        }
+// A unit of work
+typedef struct
+{
+    fn_path_task  pfn_task;
+    void         *p_argument;
+} path_task;
 
-        // Free the contents of the old dictionary
-        else;
-            //if ( dict_clear(p_dict) == 0 ) goto failed_to_clear_dict;
+// A double ended queue of tasks. The owner pushes and pops
+// at the bottom, and idle workers steal from the top
+typedef struct
+{
+    mutex      _lock;
+    path_task *p_tasks;
+    size_t     capacity,
+               top,
+               bottom;
+} path_deque;
+
+// A pool of work stealing workers
+typedef struct
+{
+    struct path_worker_s *p_workers;
+    size_t                worker_count,
+                          pending;
+    bool                  abort,
+                          failed; // True if a task failed, rather than stopped the work early
+    void                 *p_context;
+} path_pool;
+
+// A worker, and its scratch memory
+typedef struct path_worker_s
+{
+    path_pool  *p_pool;
+    size_t      index;
+    path_deque  deque;
+    pthread_t   thread;
+    char       *p_buffer;
+    size_t      buffer_size;
+    char       *p_text;
+    size_t      text_max_len;
+} path_worker;
+
+// Shared state of a tree walk
+typedef struct
+{
+    fn_path_walk  pfn_walk;
+    void         *p_context;
+} path_walk_context;
 
-        // Open the directory
-        p_directory = opendir(p_path->full_path.text);
+// A directory waiting to be walked. It is opened relative to its parent, which stays 
+// open until each of its children has opened itself
+typedef struct path_walk_item_s
+{
+    struct path_walk_item_s *p_parent;
+    size_t                   pending,     // The directory, and each child that isn't open yet
+                             depth,
+                             name_offset; // Offset of the name in the full path
+    int                      fd;
+    char                     full_path[];
+} path_walk_item;
+
+// Components of a glob are tracked as bits of a mask
+#define PATH_GLOB_MAX_COMPONENTS 64
+
+// A component of a glob, between two '/'
+typedef struct
+{
+    enum
+    {
+        PATH_GLOB_LITERAL,  // A name, opened directly
+        PATH_GLOB_PATTERN,  // A pattern, matched against each entry
+        PATH_GLOB_GLOBSTAR  // "**" matches any quantity of directories
+    } kind;
+    char         *literal;
+    path_pattern *p_pattern;
+} path_glob_component;
+
+// A glob in progress
+typedef struct
+{
+    path_glob_component  components[PATH_GLOB_MAX_COMPONENTS];
+    size_t               component_count;
+    fn_path_walk         pfn_glob;
+    void                *p_context;
+    path_allocator       allocator;
+    char                *p_text;    // Full path of the current entry
+    size_t               text_len,
+                         text_max;
+    struct
+    {
+        char   *p_buffer;
+        size_t  buffer_size;
+    }                   *p_levels;  // A directory entry buffer for each depth
+    size_t               level_count;
+    bool                 stop,
+                         failed;
+} path_glob_context;
+
+// Quantity of independently locked shards in an inode set. Must be a power of two
+#define PATH_INODE_SET_SHARDS 64
+
+// A set of ( device, inode ) pairs. Inode 0 marks an empty slot
+typedef struct
+{
+    mutex               _lock;
+    unsigned long long *p_keys;    // Pairs of device and inode
+    size_t              count,
+                        capacity;
+} path_inode_shard;
 
-        // Error check
-        if ( p_directory == NULL ) goto path_not_found;
+typedef struct
+{
+    path_inode_shard shards[PATH_INODE_SET_SHARDS];
+} path_inode_set;
 
-        // Skip "."
-        p_file_directory_entry = readdir(p_directory);
+// Shared state of a disk usage scan
+typedef struct
+{
+    path_inode_set  inodes;
+    fn_path_usage   pfn_usage;
+    void           *p_context;
+    path_usage      total;
+    bool            failed;
+} path_usage_context;
+
+// A directory being measured. It is done when it, and each directory beneath it, is done.
+// It is opened relative to its parent, which stays open until each of its children has opened itself
+typedef struct path_usage_item_s
+{
+    struct path_usage_item_s *p_parent;
+    size_t                    pending,      // The directory, and each directory beneath it that isn't done
+                              open_pending, // The directory, and each child that isn't open yet
+                              depth,
+                              name_offset;  // Offset of the name in the full path
+    int                       fd;
+    path_usage                usage;
+    char                      full_path[];
+} path_usage_item;
+
+// Identifies a snapshot file, and the version of its layout
+#define PATH_SNAPSHOT_MAGIC   "PATHSNAP"
+#define PATH_SNAPSHOT_VERSION 1
+
+// The header of a snapshot file. Each column is an array of count
+// values, at an 8 byte aligned offset from the start of the file
+typedef struct
+{
+    char               magic[8];
+    unsigned int       version,
+                       reserved;
+    unsigned long long count,
+                       device,         // Device of the root
+                       names_size,
+                       name_offsets,   // unsigned long long, offset of each name in names
+                       sizes,          // unsigned long long
+                       modified,       // long long, nanoseconds
+                       inodes,         // unsigned long long
+                       parents,        // unsigned int
+                       first_children, // unsigned int
+                       child_counts,   // unsigned int
+                       modes,          // unsigned int
+                       types,          // unsigned char
+                       names;          // char, each name null terminated
+} path_snapshot_header;
+
+// An open snapshot. Every column points into the mapping
+struct path_snapshot_s
+{
+    void                       *p_map;
+    size_t                      map_size;
+    const path_snapshot_header *p_header;
+    const unsigned long long   *p_name_offsets,
+                               *p_sizes,
+                               *p_inodes;
+    const long long            *p_modified;
+    const unsigned int         *p_parents,
+                               *p_first_children,
+                               *p_child_counts,
+                               *p_modes;
+    const unsigned char        *p_types;
+    const char                 *p_names;
+};
 
-        // Skip ".."
-        p_file_directory_entry = readdir(p_directory);
+// A snapshot being built, in breadth first order
+typedef struct
+{
+    path_allocator      allocator;
+    size_t              count,
+                        max,
+                        names_size,
+                        names_max;
+    unsigned long long *p_name_offsets,
+                       *p_sizes,
+                       *p_inodes;
+    long long          *p_modified;
+    unsigned int       *p_parents,
+                       *p_first_children,
+                       *p_child_counts,
+                       *p_modes;
+    unsigned char      *p_types;
+    char               *p_names;
+    int                *p_fds;     // The open directory of each entry waiting to be read, or -1. Not saved
+    size_t              fd_count;  // Quantity of open directories
+} path_snapshot_builder;
+
+// A difference that is reported after the trees are compared
+typedef struct
+{
+    path_diff_kind  kind;
+    path_metadata   metadata;
+    char           *path;
+    bool            paired;    // Part of a rename
+} path_diff_record;
+
+// Shared state of a diff
+typedef struct
+{
+    const path_snapshot *p_old,
+                        *p_new;        // Null pointer when comparing against the live tree
+    int                  root_fd,      // Root of the live tree
+                         flags;
+    fn_path_diff         pfn_diff;
+    void                *p_context;
+    mutex                _lock;        // Guards the records
+    path_diff_record    *p_records;
+    size_t               record_count,
+                         record_max;
+    bool                 failed;
+} path_diff_context;
+
+// A directory that is in both trees
+typedef struct
+{
+    size_t old_index,
+           new_index;  // Unused when comparing against the live tree
+    char   path[];     // Relative to the roots. Empty for the roots
+} path_diff_item;
 
-        // Iterate over each path
-        while ( ( p_file_directory_entry = readdir(p_directory) ) )
-        {
+// A bounded queue of full paths. Walkers wait while it is full, and hashing threads wait while it is empty
+typedef struct
+{
+    semaphore  free,
+               used;
+    mutex      _lock;
+    char      *p_paths[PATH_HASH_QUEUE_SIZE];
+    size_t     head,
+               tail;
+} path_hash_queue;
+
+// Shared state of a tree hash
+typedef struct
+{
+    path_hash_queue  queue;
+    fn_path_hash     pfn_hash;
+    void            *p_context;
+    bool             failed;
+} path_hash_context;
 
-            // Initialized data
-            size_t  path_len      = strlen(p_file_directory_entry->d_name);
-            char   *p_i_path_text = PATH_REALLOC(0, path_len+1);
+// Bytes hashed from each end of a file, before files of the same size are hashed in full
+#define PATH_DUPLICATE_PARTIAL_SIZE 4096
 
-            // Copy the string
-            strncpy(p_i_path_text, p_file_directory_entry->d_name, path_len);
+// A file that may have duplicates
+typedef struct
+{
+    unsigned long long  size,
+                        device,
+                        inode;
+    unsigned char       hash[PATH_HASH_SIZE];
+    char               *full_path;
+    bool                candidate;  // Still may have a duplicate
+} path_duplicate_file;
+
+// Shared state of a duplicate search
+typedef struct
+{
+    mutex                _lock;        // Guards the files, while scanning
+    path_duplicate_file *p_files;
+    size_t               file_count,
+                         file_max,
+                         next;         // Next file to hash
+    unsigned long long   minimum_size;
+    bool                 full,         // Hash whole files, instead of their ends
+                         failed;
+} path_duplicate_context;
+
+// Shared state of a recursive remove
+typedef struct
+{
+    int    directory_fd;  // The directory that contains the root
+    size_t open_fds;      // Directory fds held by queued directories
+    bool   failed;
+} path_remove_context;
 
-            // Set the null terminator
-            p_i_path_text[path_len] = '\0';
+// A directory being emptied. It is removed when it, and each directory beneath it, is empty
+typedef struct path_remove_item_s
+{
+    struct path_remove_item_s *p_parent;
+    size_t                     pending;
+    int                        fd;
+    char                       name[];
+} path_remove_item;
+
+// A directory being emptied on one thread. Frames are kept on a heap stack, so deep trees can't overflow the thread's stack
+typedef struct
+{
+    int          fd;
+    size_t       next;        // The next directory to empty
+    path_listing directories;
+} path_remove_frame;
 
-            // File status
-            stat(p_path->full_path.text, &st);
+// Data
+static path_enumeration_backend _path_enumeration_backend = PATH_ENUMERATION_DEFAULT;
+static path_metadata_backend    _path_metadata_backend    = PATH_METADATA_DEFAULT;
 
-            // Parse the path as a directory
-            if ( (st.st_mode & S_IFMT) == S_IFDIR )
-            {
+#ifdef __linux__
 
-                // Store a property
-                dict_add(p_dict, p_i_path_text, (void *)PATH_TYPE_DIRECTORY);
-            }
+// One inotify instance, shared by every watched path
+static struct
+{
+    mutex   _lock;
+    int     fd;
+    size_t  count;
+    path  **pp_paths;
+} _path_watcher = { .fd = -1 };
 
-            // Parse the path as a file
-            else 
-            {
+static pthread_once_t _path_watcher_once = PTHREAD_ONCE_INIT;
+#endif
 
-                // Store a file property
-                dict_add(p_dict, p_i_path_text, (void *)PATH_TYPE_FILE);
-            }
+void *path_realloc ( const path_allocator *const p_allocator, void *p_memory, size_t size )
+{
 
-        }
+    // Runtime allocator
+    if ( p_allocator && p_allocator->pfn_realloc ) return p_allocator->pfn_realloc(p_memory, size, p_allocator->p_context);
 
-        // Store the contents of the directory
-        p_path->data.directory = p_dict;
+    // Compile time allocator
+    return PATH_REALLOC(p_memory, size);
+}
 
-        // Set the correct type
-        p_path->type = PATH_TYPE_DIRECTORY;
-    }
+void *path_arena_realloc ( void *p_memory, size_t size, void *p_context )
+{
 
-    // File
-    else if ( (st.st_mode & S_IFMT) == S_IFREG )
+    // Initialized data
+    path_arena       *p_arena  = p_context;
+    path_arena_block *p_block  = p_arena->p_current;
+    size_t            old_size = ( p_memory ) ? ((size_t *) p_memory)[-1] : 0,
+                      required = PATH_ARENA_ALIGN(size) + PATH_ARENA_HEADER_SIZE;
+    char             *p_result = 0;
+
+    // Free. Only the newest allocation gives its memory back
+    if ( size == 0 )
     {
 
-        // Store the file type
-        p_path->type = PATH_TYPE_FILE;
+        // Roll back the newest allocation
+        if ( p_memory && (char *) p_memory + PATH_ARENA_ALIGN(old_size) == &p_block->data[p_block->used] )
+            p_block->used -= PATH_ARENA_ALIGN(old_size) + PATH_ARENA_HEADER_SIZE;
 
-        // Store the file size
-        p_path->data.file = (size_t) st.st_size;
+        // Done
+        return 0;
     }
 
-    // Socket
-    else if ( (st.st_mode & S_IFMT) == S_IFSOCK )
+    // Grow the newest allocation in place
+    if ( p_memory && (char *) p_memory + PATH_ARENA_ALIGN(old_size) == &p_block->data[p_block->used] &&
+         p_block->used - PATH_ARENA_ALIGN(old_size) + PATH_ARENA_ALIGN(size) <= p_block->size )
     {
 
-        // TODO:
-    }
-
-    // Clear the dirty bit
-    p_path->data.dirty = false;
-    
-    not_dirty:
-
-    //  Success
-    return 1;
+        // Resize
+        p_block->used = p_block->used - PATH_ARENA_ALIGN(old_size) + PATH_ARENA_ALIGN(size);
 
-    // TODO: 
-    failed_to_clear_dict:
-    path_not_found:
-    no_file:
+        // Store the size
+        ((size_t *) p_memory)[-1] = size;
 
-    return 0;
+        // Success
+        return p_memory;
+    }
 
-    // Error handling
+    // Add a block
+    if ( p_block->size - p_block->used < required )
     {
 
-        // Argument errors
-        {
-            no_path:
-                #ifndef NDEBUG
-                    printf("[path] Null pointer provided for parameter \"p_path\" in call to function \"%s\"\n", __FUNCTION__);
-                #endif
+        // Initialized data
+        size_t block_size = ( required > p_arena->block_size ) ? required : p_arena->block_size;
 
-                // Error
-                return 0;
-        }
+        // Allocate memory for the block
+        p_block = PATH_REALLOC(0, sizeof(path_arena_block) + block_size);
 
-        ////
-        //
-        {
+        // Error check
+        if ( p_block == (void *) 0 ) return 0;
 
-        }
+        // Populate the block
+        *p_block = (path_arena_block) { .p_next = p_arena->p_current, .size = block_size, .used = 0 };
+
+        // Store the block
+        p_arena->p_current = p_block;
     }
-}
 
-void pfn_path_free( void *vp_memory )
-{
+    // Take memory from the block
+    p_result = &p_block->data[p_block->used + PATH_ARENA_HEADER_SIZE];
+    p_block->used += required;
 
-    return;
+    // Store the size
+    ((size_t *) p_result)[-1] = size;
+
+    // Move the old contents
+    if ( p_memory ) memcpy(p_result, p_memory, ( old_size < size ) ? old_size : size);
+
+    // Success
+    return p_result;
 }
 
-int path_create ( path **pp_path )
+int path_arena_create ( path_arena **pp_arena, size_t block_size )
 {
 
     // Argument check
-    if ( pp_path == (void *) 0 ) goto no_path;    
+    if ( pp_arena == (void *) 0 ) goto no_arena;
 
     // Initialized data
-    path *p_path = PATH_REALLOC(0, sizeof(path));
-    
+    path_arena *p_arena = 0;
+
+    // Default block size
+    if ( block_size == 0 ) block_size = PATH_ARENA_BLOCK_SIZE;
+
+    // Round up the block size
+    block_size = PATH_ARENA_ALIGN(block_size);
+
+    // Allocate memory for the arena, and its first block
+    p_arena = PATH_REALLOC(0, PATH_ARENA_ALIGN(sizeof(path_arena)) + sizeof(path_arena_block) + block_size);
+
     // Error check
-    if ( p_path == (void *) 0 ) goto no_mem;
+    if ( p_arena == (void *) 0 ) goto no_mem;
 
-    // Zero set
-    memset(p_path, 0, sizeof(path));
+    // Populate the arena
+    p_arena->block_size = block_size;
+    p_arena->p_first    = (path_arena_block *) ( (char *) p_arena + PATH_ARENA_ALIGN(sizeof(path_arena)) );
+    p_arena->p_current  = p_arena->p_first;
+    *p_arena->p_first   = (path_arena_block) { .p_next = 0, .size = block_size, .used = 0 };
 
-    // Return 
-    *pp_path = p_path;
+    // Return a pointer to the caller
+    *pp_arena = p_arena;
 
     // Success
     return 1;
@@ -262,9 +780,9 @@ int path_create ( path **pp_path )
 
         // Argument errors
         {
-            no_path:
+            no_arena:
                 #ifndef NDEBUG
-                    printf("[path] Null pointer provided for parameter \"pp_path\" in call to function \"%s\"\n", __FUNCTION__);
+                    printf("[path] Null pointer provided for parameter \"pp_arena\" in call to function \"%s\"\n", __FUNCTION__);
                 #endif
 
                 // Error
@@ -284,20 +802,19 @@ int path_create ( path **pp_path )
     }
 }
 
-int path_open ( path **pp_path, const char *path_string )
+int path_arena_allocator ( path_arena *p_arena, path_allocator *p_allocator )
 {
 
     // Argument check
-    if ( pp_path == (void *) 0 ) goto no_path;
+    if ( p_arena     == (void *) 0 ) goto no_arena;
+    if ( p_allocator == (void *) 0 ) goto no_allocator;
 
-    // Initialized data
-    path *p_path = 0;
-
-    // Navigate 
-    path_navigate(&p_path, path_string);
-
-    // Return a pointer to the caller
-    *pp_path = p_path;
+    // Populate the allocator
+    *p_allocator = (path_allocator)
+    {
+        .pfn_realloc = path_arena_realloc,
+        .p_context   = p_arena
+    };
 
     // Success
     return 1;
@@ -307,20 +824,17 @@ int path_open ( path **pp_path, const char *path_string )
 
         // Argument errors
         {
-            no_path:
+            no_arena:
                 #ifndef NDEBUG
-                    printf("[path] Null pointer provided for parameter \"pp_path\" in call to function \"%s\"\n", __FUNCTION__);
+                    printf("[path] Null pointer provided for parameter \"p_arena\" in call to function \"%s\"\n", __FUNCTION__);
                 #endif
 
-                // Error 
+                // Error
                 return 0;
-        }
-    
-        // path
-        {
-            failed_to_navigate:
+
+            no_allocator:
                 #ifndef NDEBUG
-                    printf("[path] path_navigate returned an erroneous value in call to function \"%s\"\n", __FUNCTION__);
+                    printf("[path] Null pointer provided for parameter \"p_allocator\" in call to function \"%s\"\n", __FUNCTION__);
                 #endif
 
                 // Error
@@ -329,616 +843,9618 @@ int path_open ( path **pp_path, const char *path_string )
     }
 }
 
-/*
-    // Platform dependent initialized data
-    #ifdef _WIN64
+int path_arena_reset ( path_arena *p_arena )
+{
 
-    // Windows initialized data
-    WIN32_FIND_DATA  find_data      = { 0 };
-    char             _path[2048]    = "";
-    HANDLE           find_handle    = 0;
-    DWORD            path_attribute = 0;
-    DWORD            low_file_size  = 0;
-    DWORD            high_file_size = 0;
-    size_t           file_size      = 0;
-    char            *full_path      = 0;
-    char            *name           = 0;
-    #else
+    // Argument check
+    if ( p_arena == (void *) 0 ) goto no_arena;
 
-    // Unix like initialized data
-    struct dirent *p_file_directory_entry;
-    DIR           *p_directory;
-    char           _path[2048]    = "";
-    size_t         file_size      = 0;
-    struct stat    st             = { 0 };
-    #endif
-    
-    // Platform dependent path_open implementation
-    #ifdef _WIN64
+    // Free the blocks that were added after the first
+    while ( p_arena->p_current != p_arena->p_first )
+    {
 
-    ////////////////////////////
-    // Windows implementation //
-    ////////////////////////////
+        // Initialized data
+        path_arena_block *p_next = p_arena->p_current->p_next;
 
-    // Allocate memory for the path
-    p_path = PATH_REALLOC(0, sizeof(path));
+        // Free the block
+        (void) PATH_REALLOC(p_arena->p_current, 0);
 
-    // Error check
-    if ( p_path == (void *) 0 )
-        goto no_mem;
-    
-    // Zero set
-    memset(p_path, 0, sizeof(path));
-
-    // Copy the user specified path into an internal buffer
-    sprintf(_path, "%s", path_string);
+        // Next
+        p_arena->p_current = p_next;
+    }
 
-    // Get information about the file
-    path_attribute = GetFileAttributesA(_path);
+    // Empty the first block
+    p_arena->p_first->used = 0;
 
-    // Error check
-    if ( path_attribute == INVALID_FILE_ATTRIBUTES )
-        goto failed_to_get_file_attributes;
+    // Success
+    return 1;
 
-    // Parse the file as a directory
-    if ( path_attribute & FILE_ATTRIBUTE_DIRECTORY )
+    // Error handling
     {
-        // Initialized data
-        
-        size_t  directory_item_count = 0;
-        path   *p_directory_contents = 0;
-        path   *p_contents           = 0;
-               
-        // Copy the name
+
+        // Argument errors
         {
+            no_arena:
+                #ifndef NDEBUG
+                    printf("[path] Null pointer provided for parameter \"p_arena\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
 
-            // Initialized data
-            // TODO: This could be better optimized
-            char   *after_backsl = strrchr(_path, '\\'),
-                   *after_fwdsl  = strrchr(_path, '/'),
-                   *after_sl     = 1 + ( after_backsl > after_fwdsl ) ? after_fwdsl : after_backsl;
-            size_t  len          = strlen(after_sl)-1;
-            
-            trim:
-            if ( len == 0 )
-            {
-                *after_sl = '\0';
-                after_backsl = strrchr(_path, '\\'),
-                after_fwdsl  = strrchr(_path, '/'),
-                after_sl     = ( after_backsl < after_fwdsl ) ? after_fwdsl : after_backsl;
-                len          = strlen(after_sl) - 1; 
-                goto trim;
-            }
+                // Error
+                return 0;
+        }
+    }
+}
 
-            // Allocate memory for name
-            name = PATH_REALLOC(0, sizeof(char) * ( len + 1 )); // Don't need to allocate a null terminator
+int path_arena_destroy ( path_arena **pp_arena )
+{
 
-            // Error check
-            if ( name == (void *) 0 )
-                goto no_mem;
-            
-            // Copy the name
-            strncpy(name, after_sl+1, len);
+    // Argument check
+    if ( pp_arena  == (void *) 0 ) goto no_arena;
+    if ( *pp_arena == (void *) 0 ) goto pointer_to_null_pointer;
 
-            // Write a null terminator
-            name[len] = '\0';
-        }
+    // Initialized data
+    path_arena *p_arena = *pp_arena;
 
-        // Copy the full path
-        {
+    // No more pointer for caller
+    *pp_arena = 0;
 
-            // Initialized data
-            size_t len = strlen(_path);
-            
-            // Allocate memory for the full path string
-            full_path = PATH_REALLOC(0, sizeof(char) * ( len + 1024 ));
+    // Free the blocks that were added after the first
+    (void) path_arena_reset(p_arena);
 
-            // Error check
-            if ( full_path == (void *) 0 )
-                goto no_mem;
-            
-            // Copy the full path
-            strncpy(full_path, _path, len);
+    // Free the arena, and its first block
+    (void) PATH_REALLOC(p_arena, 0);
 
-            // Write a null terminator
-            full_path[len] = '\0';
+    // Success
+    return 1;
 
-            // Write a null terminator
-            strncat(full_path, "\\*.*", 4);
-        }   
+    // Error handling
+    {
 
-        // Recursively construct paths from the directory
+        // Argument errors
         {
+            no_arena:
+                #ifndef NDEBUG
+                    printf("[path] Null pointer provided for parameter \"pp_arena\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
 
-            
+                // Error
+                return 0;
 
-            // Get the first file in a directory
-            find_handle = FindFirstFileA(full_path, &find_data);
+            pointer_to_null_pointer:
+                #ifndef NDEBUG
+                    printf("[path] Parameter \"pp_arena\" points to null pointer in call to function \"%s\"\n", __FUNCTION__);
+                #endif
 
-            // Error check
-            if ( find_handle == INVALID_HANDLE_VALUE )
-                goto path_not_found;//printf("Path not found: [%s]\n", path);
+                // Error
+                return 0;
+        }
+    }
+}
 
-            // Parse the path as a directory
-            if ( find_data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY )
-            {
-                
-                // Skip past "." and ".."
-                if ( FindNextFileA(find_handle, &find_data) == 0 )
-                    goto find_next_file_failed;
+int path_listing_reserve ( path_listing *p_listing, size_t count, bool metadata )
+{
 
-                // Iterate over each item in the directory
-                while ( FindNextFileA(find_handle, &find_data) )
-                {
+    // Initialized data
+    size_t max = p_listing->max;
 
-                    // Initialized data
-                    path *i_path = PATH_REALLOC(0, sizeof(path));
+    // Fast exit
+    if ( count <= p_listing->max && ( metadata == false || p_listing->p_metadata ) ) return 1;
 
-                    // Error check
-                    if ( i_path == (void *) 0 )
-                        goto no_mem;
+    // Grow geometrically
+    if ( max == 0 ) max = 64;
+    while ( max < count ) max *= 2;
 
-                    // Increment the directory counter
-                    directory_item_count++;
+    // Grow the offsets
+    {
 
-                    // Zero set
-                    memset(i_path, 0, sizeof(path));
+        // Initialized data
+        unsigned int *p_offsets = path_realloc(&p_listing->allocator, p_listing->p_offsets, max * sizeof(unsigned int));
 
-                    // Build the file path 
-                    sprintf(full_path, "%s\\%s", path_string, find_data.cFileName);
+        // Error check
+        if ( p_offsets == (void *) 0 ) goto no_mem;
 
-                    // Parse the item as a directory
-                    if ( find_data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY )
-                    {
-                        //printf("Directory: %s\n", full_path);
-                        //fflush(stdout);
-                        path_open(&p_contents, p_path, full_path);
-                        path_append_file(&p_directory_contents, p_contents);
-                    }
+        // Store the offsets
+        p_listing->p_offsets = p_offsets;
+    }
 
-                    // Parse the item as a file
-                    else
-                    {
-                        //printf("File: %s\n", full_path);
-                        //fflush(stdout);
-                        path_open(&p_contents, p_path, full_path);
-                        path_append_file(&p_directory_contents, p_contents);
-                    }
-                }
+    // Grow the types
+    {
 
-                // Clean up the scope
-                FindClose(find_handle);
-                
-            }
-        }
+        // Initialized data
+        unsigned char *p_types = path_realloc(&p_listing->allocator, p_listing->p_types, max * sizeof(unsigned char));
 
-        // Populate the path struct
-        *p_path = (path)
-        {
-            .full_path               = full_path,
-            .name                    = name,
-            .type                    = PATH_TYPE_DIRECTORY,
-            .p_parent_directory_path = p_parent_path,
-            .directory = {
-                .p_directory_contents   = p_directory_contents,
-                .directory_content_size = directory_item_count
-            }
-        };
+        // Error check
+        if ( p_types == (void *) 0 ) goto no_mem;
 
-        // Clean up
-        //CloseHandle(file);
+        // Store the types
+        p_listing->p_types = p_types;
     }
 
-    // Parse the path as a file
-    else
+    // Grow the metadata, if there is any
+    if ( metadata || p_listing->p_metadata )
     {
 
         // Initialized data
-        HANDLE file = CreateFile(
-            _path,
-            GENERIC_READ | GENERIC_WRITE,
-            0,
-            NULL,
-            OPEN_EXISTING,
-            FILE_ATTRIBUTE_NORMAL,
-            NULL
-        );
+        path_metadata *p_metadata = path_realloc(&p_listing->allocator, p_listing->p_metadata, max * sizeof(path_metadata));
 
         // Error check
-        if ( file == INVALID_HANDLE_VALUE )
-            goto failed_to_open_file;
+        if ( p_metadata == (void *) 0 ) goto no_mem;
 
-        // Copy the name
-        {
+        // Store the metadata
+        p_listing->p_metadata = p_metadata;
+    }
 
-            // Initialized data
-            // TODO: This could be better optimized
-            char   *after_backsl = strrchr(_path, '\\'),
-                   *after_fwdsl  = strrchr(_path, '/'),
-                   *after_sl     = 1 + ( after_backsl > after_fwdsl ) ? after_fwdsl : after_backsl;
-            size_t  len          = strlen(after_sl)-1;
+    // Store the capacity
+    p_listing->max = max;
 
-            // Allocate memory for name
-            name = PATH_REALLOC(0, sizeof(char) * ( len + 1 ));
+    // Success
+    return 1;
 
-            // Error check
-            if ( name == (void *) 0 )
-                goto no_mem;
-            
-            // Copy the name
-            strncpy(name, after_sl+1, len);
+    // Error handling
+    {
 
-            // Write a null terminator
-            name[len] = '\0';
+        // Standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    printf("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
         }
+    }
+}
 
-        // Copy the full path
-        {
+int path_listing_append ( path_listing *p_listing, const char *name, size_t name_len, path_type type )
+{
 
-            // Initialized data
-            size_t len = strlen(_path);
+    // Initialized data
+    size_t required = p_listing->names_len + name_len + 1;
 
-            // Allocate memory for the full path string
-            full_path = PATH_REALLOC(0, sizeof(char) * ( len + 1 ));
+    // Grow the columns
+    if ( path_listing_reserve(p_listing, p_listing->count + 1, false) == 0 ) goto no_mem;
 
-            // Error check
-            if ( full_path == (void *) 0 )
-                goto no_mem;
-            
-            // Copy the full path
-            strncpy(full_path, _path, len);
+    // Offsets are 32 bits wide
+    if ( required > 0xFFFFFFFF ) goto no_mem;
 
-            // Write a null terminator
-            full_path[len] = '\0';
-        }   
+    // Grow the names
+    if ( required > p_listing->names_max )
+    {
 
-        // Get the file size
-        {
-            low_file_size = GetFileSize(file, &high_file_size);
+        // Initialized data
+        size_t  names_max = p_listing->names_max ? p_listing->names_max : 4096;
+        char   *p_names   = 0;
 
-            file_size = (high_file_size << 32) | low_file_size;
-        }
+        // Grow geometrically
+        while ( names_max < required ) names_max *= 2;
 
-        // Populate the path struct
-        *p_path = (path)
-        {
-            .full_path               = full_path,
-            .name                    = name,
-            .type                    = PATH_TYPE_FILE,
-            .p_next_content          = 0,
-            .p_parent_directory_path = p_parent_path,
-            .file = {
-                .file_size = file_size
-            }
-        };
+        // Reallocate
+        p_names = path_realloc(&p_listing->allocator, p_listing->p_names, names_max);
 
-        // Clean up
-        CloseHandle(file);
+        // Error check
+        if ( p_names == (void *) 0 ) goto no_mem;
+
+        // Store the names
+        p_listing->p_names   = p_names;
+        p_listing->names_max = names_max;
+    }
+
+    // Copy the name, and the null terminator
+    memcpy(&p_listing->p_names[p_listing->names_len], name, name_len);
+    p_listing->p_names[p_listing->names_len + name_len] = '\0';
+
+    // Store the entry
+    p_listing->p_offsets[p_listing->count] = (unsigned int) p_listing->names_len;
+    p_listing->p_types[p_listing->count]   = (unsigned char) type;
+    if ( p_listing->p_metadata ) p_listing->p_metadata[p_listing->count].type = 0;
+
+    // Update the lengths
+    p_listing->names_len = required;
+    p_listing->count++;
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    printf("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int path_listing_sort ( path_listing *p_listing )
+{
+
+    // Initialized data
+    size_t         count      = p_listing->count;
+    unsigned int  *p_order    = 0,
+                  *p_from     = 0,
+                  *p_to       = 0;
+    path_metadata *p_metadata = 0;
+
+    // Fast exit
+    if ( count < 2 ) return 1;
+
+    // Allocate two permutations
+    p_order = path_realloc(&p_listing->allocator, 0, 2 * count * sizeof(unsigned int));
+
+    // Error check
+    if ( p_order == (void *) 0 ) goto no_mem;
+
+    // Start from the order the entries were read in
+    p_from = p_order;
+    p_to   = p_order + count;
+    for (size_t i = 0; i < count; i++) p_from[i] = (unsigned int) i;
+
+    // Merge runs of doubling width. Only the permutation moves
+    for (size_t width = 1; width < count; width *= 2)
+    {
+
+        // Merge each pair of runs
+        for (size_t lo = 0; lo < count; lo += 2 * width)
+        {
+
+            // Initialized data
+            size_t mid = ( lo + width < count ) ? lo + width : count,
+                   hi  = ( lo + 2 * width < count ) ? lo + 2 * width : count,
+                   a   = lo,
+                   b   = mid,
+                   k   = lo;
+
+            // Take the lesser head
+            while ( a < mid && b < hi )
+                p_to[k++] = ( strcmp(&p_listing->p_names[p_listing->p_offsets[p_from[b]]], &p_listing->p_names[p_listing->p_offsets[p_from[a]]]) < 0 ) ? p_from[b++] : p_from[a++];
+
+            // Copy the remainders
+            while ( a < mid ) p_to[k++] = p_from[a++];
+            while ( b < hi  ) p_to[k++] = p_from[b++];
+        }
+
+        // Swap the permutations
+        { unsigned int *p_swap = p_from; p_from = p_to; p_to = p_swap; }
+    }
+
+    // Gather the offsets, through the spare permutation
+    for (size_t i = 0; i < count; i++) p_to[i] = p_listing->p_offsets[p_from[i]];
+    memcpy(p_listing->p_offsets, p_to, count * sizeof(unsigned int));
+
+    // Gather the types
+    for (size_t i = 0; i < count; i++) ((unsigned char *)p_to)[i] = p_listing->p_types[p_from[i]];
+    memcpy(p_listing->p_types, p_to, count * sizeof(unsigned char));
+
+    // Gather the metadata into a new column
+    if ( p_listing->p_metadata )
+    {
+
+        // Allocate a column
+        p_metadata = path_realloc(&p_listing->allocator, 0, p_listing->max * sizeof(path_metadata));
+
+        // Error check
+        if ( p_metadata == (void *) 0 ) goto no_mem;
+
+        // Gather
+        for (size_t i = 0; i < count; i++) p_metadata[i] = p_listing->p_metadata[p_from[i]];
+
+        // Replace the column
+        (void) path_realloc(&p_listing->allocator, p_listing->p_metadata, 0);
+        p_listing->p_metadata = p_metadata;
+    }
+
+    // Free the permutations
+    (void) path_realloc(&p_listing->allocator, p_order, 0);
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    printf("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Clean up
+                if ( p_order ) (void) path_realloc(&p_listing->allocator, p_order, 0);
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+bool path_listing_find ( const path_listing *const p_listing, const char *name, size_t *p_index )
+{
+
+    // Initialized data
+    size_t lo = 0,
+           hi = p_listing->count;
+
+    // Binary search
+    while ( lo < hi )
+    {
+
+        // Initialized data
+        size_t mid        = lo + ( hi - lo ) / 2;
+        int    comparison = strcmp(&p_listing->p_names[p_listing->p_offsets[mid]], name);
+
+        // Match
+        if ( comparison == 0 ) 
+        {
+            *p_index = mid;
+            return true;
+        }
+
+        // Narrow the range
+        if ( comparison < 0 ) lo = mid + 1;
+        else                  hi = mid;
+    }
+
+    // Return the insertion point to the caller
+    *p_index = lo;
+
+    // Miss
+    return false;
+}
+
+int path_listing_insert ( path_listing *p_listing, const char *name, path_type type )
+{
+
+    // Initialized data
+    size_t        index  = 0,
+                  tail   = 0;
+    unsigned int  offset = 0;
+
+    // Replace an entry of the same name
+    if ( path_listing_find(p_listing, name, &index) )
+    {
+
+        // Store the type
+        p_listing->p_types[index] = (unsigned char) type;
+        if ( p_listing->p_metadata ) p_listing->p_metadata[index].type = 0;
+
+        // Success
+        return 1;
+    }
+
+    // Append the entry
+    if ( path_listing_append(p_listing, name, strlen(name), type) == 0 ) return 0;
+
+    // Initialized data
+    tail   = p_listing->count - 1 - index;
+    offset = p_listing->p_offsets[p_listing->count - 1];
+
+    // Move the entry into place
+    memmove(&p_listing->p_offsets[index + 1], &p_listing->p_offsets[index], tail * sizeof(unsigned int));
+    memmove(&p_listing->p_types[index + 1], &p_listing->p_types[index], tail * sizeof(unsigned char));
+    if ( p_listing->p_metadata ) memmove(&p_listing->p_metadata[index + 1], &p_listing->p_metadata[index], tail * sizeof(path_metadata));
+    p_listing->p_offsets[index] = offset;
+    p_listing->p_types[index]   = (unsigned char) type;
+    if ( p_listing->p_metadata ) p_listing->p_metadata[index].type = 0;
+
+    // Success
+    return 1;
+}
+
+int path_listing_compact ( path_listing *p_listing )
+{
+
+    // Initialized data
+    size_t  live      = p_listing->names_len - p_listing->names_dead,
+            names_len = 0;
+    char   *p_names   = 0;
+
+    // Nothing to compact
+    if ( p_listing->names_dead == 0 ) return 1;
+
+    // Allocate a scratch copy of the live names
+    if ( live )
+    {
+        p_names = path_realloc(&p_listing->allocator, 0, live);
+
+        // Error check
+        if ( p_names == (void *) 0 ) goto no_mem;
+    }
+
+    // Copy each live name, in listing order
+    for (size_t i = 0; i < p_listing->count; i++)
+    {
+
+        // Initialized data
+        const char *name     = &p_listing->p_names[p_listing->p_offsets[i]];
+        size_t      name_len = strlen(name) + 1;
+
+        // Copy the name, and the null terminator
+        memcpy(&p_names[names_len], name, name_len);
+
+        // Store the new offset
+        p_listing->p_offsets[i] = (unsigned int) names_len;
+
+        // Update the length
+        names_len += name_len;
+    }
+
+    // Copy the live names back over the old names, and release the scratch copy
+    if ( p_names ) 
+    {
+        memcpy(p_listing->p_names, p_names, names_len);
+        (void) path_realloc(&p_listing->allocator, p_names, 0);
+    }
+
+    // Update the lengths
+    p_listing->names_len  = names_len;
+    p_listing->names_dead = 0;
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    printf("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int path_listing_remove ( path_listing *p_listing, const char *name )
+{
+
+    // Initialized data
+    size_t index = 0,
+           tail  = 0;
+
+    // Find the entry
+    if ( path_listing_find(p_listing, name, &index) == false ) return 1;
+
+    // Initialized data
+    tail = p_listing->count - 1 - index;
+
+    // The name stays in the names until they are compacted
+    p_listing->names_dead += strlen(&p_listing->p_names[p_listing->p_offsets[index]]) + 1;
+
+    // Close the gap
+    memmove(&p_listing->p_offsets[index], &p_listing->p_offsets[index + 1], tail * sizeof(unsigned int));
+    memmove(&p_listing->p_types[index], &p_listing->p_types[index + 1], tail * sizeof(unsigned char));
+    if ( p_listing->p_metadata ) memmove(&p_listing->p_metadata[index], &p_listing->p_metadata[index + 1], tail * sizeof(path_metadata));
+    p_listing->count--;
+
+    // Compact the names once more of them are dead than live
+    if ( p_listing->names_dead > p_listing->names_len - p_listing->names_dead ) return path_listing_compact(p_listing);
+
+    // Success
+    return 1;
+}
+
+int path_listing_reset ( path_listing *p_listing )
+{
+
+    // Empty the listing, but keep the memory
+    p_listing->names_len  = 0;
+    p_listing->names_dead = 0;
+    p_listing->count      = 0;
+
+    // Success
+    return 1;
+}
+
+int path_listing_destroy ( path_listing *p_listing )
+{
+
+    // Free each column
+    if ( p_listing->p_names    ) (void) path_realloc(&p_listing->allocator, p_listing->p_names, 0);
+    if ( p_listing->p_offsets  ) (void) path_realloc(&p_listing->allocator, p_listing->p_offsets, 0);
+    if ( p_listing->p_types    ) (void) path_realloc(&p_listing->allocator, p_listing->p_types, 0);
+    if ( p_listing->p_metadata ) (void) path_realloc(&p_listing->allocator, p_listing->p_metadata, 0);
+
+    // Clear the listing. The allocator stays
+    *p_listing = (path_listing) { .allocator = p_listing->allocator };
+
+    // Success
+    return 1;
+}
+
+size_t path_pattern_class_end ( const char *text, size_t i )
+{
+
+    // Initialized data
+    size_t j = i + 1;
+
+    // Skip the negation
+    if ( text[j] == '!' || text[j] == '^' ) j++;
+
+    // A leading ']' is part of the set
+    if ( text[j] == ']' ) j++;
+
+    // Find the closing bracket
+    while ( text[j] && text[j] != ']' )
+    {
+
+        // Skip escaped characters
+        if ( text[j] == '\\' && text[j + 1] ) j++;
+
+        // Next
+        j++;
+    }
+
+    // Return the closing bracket, or 0 if the class is unterminated
+    return ( text[j] == ']' ) ? j : 0;
+}
+
+int path_pattern_push_op ( path_pattern *p_pattern, path_pattern_op op )
+{
+
+    // Grow the ops
+    if ( p_pattern->op_count == p_pattern->op_max )
+    {
+
+        // Initialized data
+        size_t           op_max = p_pattern->op_max ? p_pattern->op_max * 2 : 16;
+        path_pattern_op *p_ops  = path_realloc(0, p_pattern->p_ops, op_max * sizeof(path_pattern_op));
+
+        // Error check
+        if ( p_ops == (void *) 0 ) return 0;
+
+        // Store the ops
+        p_pattern->p_ops  = p_ops;
+        p_pattern->op_max = op_max;
+    }
+
+    // Store the op
+    p_pattern->p_ops[p_pattern->op_count++] = op;
+
+    // Success
+    return 1;
+}
+
+int path_pattern_push_char ( path_pattern *p_pattern, char c )
+{
+
+    // Grow the text
+    if ( p_pattern->text_len == p_pattern->text_max )
+    {
+
+        // Initialized data
+        size_t  text_max = p_pattern->text_max ? p_pattern->text_max * 2 : 64;
+        char   *p_text   = path_realloc(0, p_pattern->p_text, text_max);
+
+        // Error check
+        if ( p_text == (void *) 0 ) return 0;
+
+        // Store the text
+        p_pattern->p_text   = p_text;
+        p_pattern->text_max = text_max;
+    }
+
+    // Store the character
+    p_pattern->p_text[p_pattern->text_len++] = c;
+
+    // Success
+    return 1;
+}
+
+int path_pattern_compile_alternative ( path_pattern *p_pattern, const char *text )
+{
+
+    // Initialized data
+    path_pattern_alternative  alternative = { .first_op = p_pattern->op_count };
+    path_pattern_op          *p_ops       = 0;
+
+    // Too many alternatives
+    if ( p_pattern->alternative_count == PATH_PATTERN_MAX_ALTERNATIVES ) goto too_many_alternatives;
+
+    // Compile each character
+    for (size_t i = 0; text[i]; i++)
+    {
+
+        // Initialized data
+        char              c      = text[i];
+        size_t            end    = 0;
+        path_pattern_op  *p_last = ( p_pattern->op_count > alternative.first_op ) ? &p_pattern->p_ops[p_pattern->op_count - 1] : 0;
+
+        // Star. Runs of stars are one star
+        if ( c == '*' )
+        {
+            if ( p_last && p_last->kind == PATH_PATTERN_OP_STAR ) continue;
+            if ( path_pattern_push_op(p_pattern, (path_pattern_op) { .kind = PATH_PATTERN_OP_STAR }) == 0 ) goto no_mem;
+        }
+
+        // Any character
+        else if ( c == '?' )
+        {
+            if ( path_pattern_push_op(p_pattern, (path_pattern_op) { .kind = PATH_PATTERN_OP_ANY }) == 0 ) goto no_mem;
+        }
+
+        // Character class
+        else if ( c == '[' && ( end = path_pattern_class_end(text, i) ) )
+        {
+
+            // Initialized data
+            path_pattern_op op     = { .kind = PATH_PATTERN_OP_CLASS };
+            bool            negate = false;
+            size_t          j      = i + 1;
+
+            // Negation
+            if ( text[j] == '!' || text[j] == '^' ) negate = true, j++;
+
+            // Add each character, and each range, to the set. A leading ']' is a character
+            while ( j < end )
+            {
+
+                // Initialized data
+                unsigned char lo = 0,
+                              hi = 0;
+
+                // Character
+                if ( text[j] == '\\' && j + 1 < end ) j++;
+                lo = (unsigned char) text[j++];
+                hi = lo;
+
+                // Range
+                if ( text[j] == '-' && j + 1 < end )
+                {
+                    j++;
+                    if ( text[j] == '\\' && j + 1 < end ) j++;
+                    hi = (unsigned char) text[j++];
+                }
+
+                // Store each character in the range
+                for (unsigned int k = lo; k <= hi; k++) op.set[k >> 3] |= (unsigned char) ( 1 << ( k & 7 ) );
+            }
+
+            // Invert the set
+            if ( negate ) for (size_t k = 0; k < sizeof(op.set); k++) op.set[k] = (unsigned char) ~op.set[k];
+
+            // Store the op
+            if ( path_pattern_push_op(p_pattern, op) == 0 ) goto no_mem;
+
+            // Skip the class
+            i = end;
+        }
+
+        // Literal
+        else
+        {
+
+            // Escaped character
+            if ( c == '\\' && text[i + 1] ) c = text[++i];
+
+            // Start a run of text
+            if ( p_last == (void *) 0 || p_last->kind != PATH_PATTERN_OP_LITERAL )
+                if ( path_pattern_push_op(p_pattern, (path_pattern_op) { .kind = PATH_PATTERN_OP_LITERAL, .offset = p_pattern->text_len }) == 0 ) goto no_mem;
+
+            // Extend the run
+            if ( path_pattern_push_char(p_pattern, c) == 0 ) goto no_mem;
+            p_pattern->p_ops[p_pattern->op_count - 1].length++;
+        }
+    }
+
+    // Initialized data
+    alternative.op_count = p_pattern->op_count - alternative.first_op;
+    p_ops                = &p_pattern->p_ops[alternative.first_op];
+
+    // Hidden names only match patterns that begin with a literal '.'
+    alternative.leading_dot = alternative.op_count && p_ops[0].kind == PATH_PATTERN_OP_LITERAL && p_pattern->p_text[p_ops[0].offset] == '.';
+
+    // Pick a fast path for literal prefixes and suffixes
+    alternative.kind = PATH_PATTERN_GENERAL;
+    if ( alternative.op_count == 0 )
+        alternative.kind = PATH_PATTERN_EXACT;
+    else if ( alternative.op_count == 1 && p_ops[0].kind == PATH_PATTERN_OP_LITERAL )
+        alternative.kind = PATH_PATTERN_EXACT,
+        alternative.prefix_offset = p_ops[0].offset, alternative.prefix_length = p_ops[0].length;
+    else if ( alternative.op_count == 1 && p_ops[0].kind == PATH_PATTERN_OP_STAR )
+        alternative.kind = PATH_PATTERN_PREFIX;
+    else if ( alternative.op_count == 2 && p_ops[0].kind == PATH_PATTERN_OP_LITERAL && p_ops[1].kind == PATH_PATTERN_OP_STAR )
+        alternative.kind = PATH_PATTERN_PREFIX,
+        alternative.prefix_offset = p_ops[0].offset, alternative.prefix_length = p_ops[0].length;
+    else if ( alternative.op_count == 2 && p_ops[0].kind == PATH_PATTERN_OP_STAR && p_ops[1].kind == PATH_PATTERN_OP_LITERAL )
+        alternative.kind = PATH_PATTERN_SUFFIX,
+        alternative.suffix_offset = p_ops[1].offset, alternative.suffix_length = p_ops[1].length;
+    else if ( alternative.op_count == 3 && p_ops[0].kind == PATH_PATTERN_OP_LITERAL && p_ops[1].kind == PATH_PATTERN_OP_STAR && p_ops[2].kind == PATH_PATTERN_OP_LITERAL )
+        alternative.kind = PATH_PATTERN_PREFIX_SUFFIX,
+        alternative.prefix_offset = p_ops[0].offset, alternative.prefix_length = p_ops[0].length,
+        alternative.suffix_offset = p_ops[2].offset, alternative.suffix_length = p_ops[2].length;
+
+    // Grow the alternatives
+    if ( p_pattern->alternative_count == p_pattern->alternative_max )
+    {
+
+        // Initialized data
+        size_t                    alternative_max = p_pattern->alternative_max ? p_pattern->alternative_max * 2 : 4;
+        path_pattern_alternative *p_alternatives  = path_realloc(0, p_pattern->p_alternatives, alternative_max * sizeof(path_pattern_alternative));
+
+        // Error check
+        if ( p_alternatives == (void *) 0 ) goto no_mem;
+
+        // Store the alternatives
+        p_pattern->p_alternatives  = p_alternatives;
+        p_pattern->alternative_max = alternative_max;
+    }
+
+    // Store the alternative
+    p_pattern->p_alternatives[p_pattern->alternative_count++] = alternative;
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // path errors
+        {
+            too_many_alternatives:
+                #ifndef NDEBUG
+                    printf("[path] Pattern expands to more than %d alternatives in call to function \"%s\"\n", PATH_PATTERN_MAX_ALTERNATIVES, __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // Standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    printf("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int path_pattern_expand ( path_pattern *p_pattern, const char *text )
+{
+
+    // Initialized data
+    size_t text_len = strlen(text),
+           open     = 0,
+           close    = 0,
+           depth    = 0;
+    bool   found    = false;
+
+    // Find the first brace group
+    for (size_t i = 0; i < text_len && close == 0; i++)
+    {
+
+        // Skip escaped characters
+        if ( text[i] == '\\' && text[i + 1] ) { i++; continue; }
+
+        // Skip character classes
+        if ( text[i] == '[' ) { size_t end = path_pattern_class_end(text, i); if ( end ) i = end; continue; }
+
+        // Open a group
+        if ( text[i] == '{' ) { if ( depth++ == 0 ) open = i, found = true; continue; }
+
+        // Close a group
+        if ( text[i] == '}' && depth ) { if ( --depth == 0 ) close = i; continue; }
+    }
+
+    // No groups. An unterminated brace is literal text
+    if ( found == false || close == 0 ) return path_pattern_compile_alternative(p_pattern, text);
+
+    // Expand each option of the group, and expand what remains
+    for (size_t start = open + 1, i = open + 1; i <= close; i++)
+    {
+
+        // Skip escaped characters
+        if ( text[i] == '\\' && i + 1 < close ) { i++; continue; }
+
+        // Skip character classes
+        if ( text[i] == '[' ) { size_t end = path_pattern_class_end(text, i); if ( end && end < close ) i = end; continue; }
+
+        // Track nested groups
+        if ( text[i] == '{' ) { depth++; continue; }
+        if ( text[i] == '}' && depth && i != close ) { depth--; continue; }
+
+        // End of an option
+        if ( ( text[i] == ',' && depth == 0 ) || i == close )
+        {
+
+            // Initialized data
+            size_t  option_len   = i - start,
+                    expanded_len = open + option_len + ( text_len - close - 1 );
+            char   *p_expanded   = path_realloc(0, 0, expanded_len + 1);
+            int     result       = 0;
+
+            // Error check
+            if ( p_expanded == (void *) 0 ) goto no_mem;
+
+            // Before the group, the option, and after the group
+            memcpy(p_expanded, text, open);
+            memcpy(p_expanded + open, text + start, option_len);
+            memcpy(p_expanded + open + option_len, text + close + 1, text_len - close - 1);
+            p_expanded[expanded_len] = '\0';
+
+            // Expand
+            result = path_pattern_expand(p_pattern, p_expanded);
+
+            // Clean up
+            (void) path_realloc(0, p_expanded, 0);
+
+            // Error check
+            if ( result == 0 ) return 0;
+
+            // Next option
+            start = i + 1;
+        }
+    }
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    printf("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int path_pattern_compile ( path_pattern **pp_pattern, const char *pattern_text )
+{
+
+    // Argument check
+    if ( pp_pattern   == (void *) 0 ) goto no_pattern;
+    if ( pattern_text == (void *) 0 ) goto no_pattern_text;
+
+    // Initialized data
+    path_pattern *p_pattern = path_realloc(0, 0, sizeof(path_pattern));
+
+    // Error check
+    if ( p_pattern == (void *) 0 ) goto no_mem;
+
+    // Zero set
+    memset(p_pattern, 0, sizeof(path_pattern));
+
+    // Expand alternation, and compile each alternative
+    if ( path_pattern_expand(p_pattern, pattern_text) == 0 ) goto failed_to_compile;
+
+    // Return a pointer to the caller
+    *pp_pattern = p_pattern;
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_pattern:
+                #ifndef NDEBUG
+                    printf("[path] Null pointer provided for parameter \"pp_pattern\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_pattern_text:
+                #ifndef NDEBUG
+                    printf("[path] Null pointer provided for parameter \"pattern_text\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // path errors
+        {
+            failed_to_compile:
+                #ifndef NDEBUG
+                    printf("[path] Failed to compile pattern \"%s\" in call to function \"%s\"\n", pattern_text, __FUNCTION__);
+                #endif
+
+                // Clean up
+                (void) path_pattern_destroy(&p_pattern);
+
+                // Error
+                return 0;
+        }
+
+        // Standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    printf("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+bool path_pattern_match_ops ( const path_pattern *const p_pattern, const path_pattern_op *p_ops, size_t op_count, const char *name, size_t name_len )
+{
+
+    // Initialized data
+    size_t op       = 0,
+           position = 0,
+           star_op  = op_count,
+           star_at  = 0;
+
+    // Match each op, and back up to the last star on a mismatch
+    while ( position < name_len || op < op_count )
+    {
+
+        // Try the next op
+        if ( op < op_count )
+        {
+
+            // Initialized data
+            const path_pattern_op *p_op = &p_ops[op];
+            unsigned char          c    = (unsigned char) name[position];
+
+            // Remember the star, and try matching nothing first
+            if ( p_op->kind == PATH_PATTERN_OP_STAR ) 
+            {
+                star_op = op++;
+                star_at = position;
+                continue;
+            }
+
+            // One character
+            if ( p_op->kind == PATH_PATTERN_OP_ANY && position < name_len ) 
+            {
+                op++, position++;
+                continue;
+            }
+
+            // One character in a set
+            if ( p_op->kind == PATH_PATTERN_OP_CLASS && position < name_len && ( p_op->set[c >> 3] & ( 1 << ( c & 7 ) ) ) )
+            {
+                op++, position++;
+                continue;
+            }
+
+            // A run of text
+            if ( p_op->kind == PATH_PATTERN_OP_LITERAL && name_len - position >= p_op->length && memcmp(&name[position], &p_pattern->p_text[p_op->offset], p_op->length) == 0 )
+            {
+                op++, position += p_op->length;
+                continue;
+            }
+        }
+
+        // Let the last star match one more character
+        if ( star_op < op_count && star_at < name_len )
+        {
+            position = ++star_at;
+            op       = star_op + 1;
+            continue;
+        }
+
+        // Mismatch
+        return false;
+    }
+
+    // Match
+    return true;
+}
+
+bool path_pattern_match ( const path_pattern *const p_pattern, const char *name )
+{
+
+    // Argument check
+    if ( p_pattern == (void *) 0 ) return false;
+    if ( name      == (void *) 0 ) return false;
+
+    // Initialized data
+    size_t name_len = strlen(name);
+
+    // Try each alternative
+    for (size_t i = 0; i < p_pattern->alternative_count; i++)
+    {
+
+        // Initialized data
+        const path_pattern_alternative *p_alternative = &p_pattern->p_alternatives[i];
+        size_t                          prefix_length = p_alternative->prefix_length,
+                                        suffix_length = p_alternative->suffix_length;
+        const char                     *p_prefix      = ( prefix_length ) ? &p_pattern->p_text[p_alternative->prefix_offset] : name,
+                                       *p_suffix      = ( suffix_length ) ? &p_pattern->p_text[p_alternative->suffix_offset] : name;
+
+        // Hidden names
+        if ( name[0] == '.' && p_alternative->leading_dot == false ) continue;
+
+        // Match the alternative
+        switch ( p_alternative->kind )
+        {
+            case PATH_PATTERN_EXACT:
+                if ( name_len == prefix_length && memcmp(name, p_prefix, prefix_length) == 0 ) return true;
+                break;
+
+            case PATH_PATTERN_PREFIX:
+                if ( name_len >= prefix_length && memcmp(name, p_prefix, prefix_length) == 0 ) return true;
+                break;
+
+            case PATH_PATTERN_SUFFIX:
+                if ( name_len >= suffix_length && memcmp(name + name_len - suffix_length, p_suffix, suffix_length) == 0 ) return true;
+                break;
+
+            case PATH_PATTERN_PREFIX_SUFFIX:
+                if ( name_len >= prefix_length + suffix_length && memcmp(name, p_prefix, prefix_length) == 0 && memcmp(name + name_len - suffix_length, p_suffix, suffix_length) == 0 ) return true;
+                break;
+
+            case PATH_PATTERN_GENERAL:
+                if ( path_pattern_match_ops(p_pattern, &p_pattern->p_ops[p_alternative->first_op], p_alternative->op_count, name, name_len) ) return true;
+                break;
+        }
+    }
+
+    // No match
+    return false;
+}
+
+int path_pattern_destroy ( path_pattern **pp_pattern )
+{
+
+    // Argument check
+    if ( pp_pattern == (void *) 0 ) goto no_pattern;
+
+    // Initialized data
+    path_pattern *p_pattern = *pp_pattern;
+
+    // Error check
+    if ( p_pattern == (void *) 0 ) goto pointer_to_null_pointer;
+
+    // No more pointer for caller
+    *pp_pattern = 0;
+
+    // Free the pattern
+    if ( p_pattern->p_text         ) (void) path_realloc(0, p_pattern->p_text, 0);
+    if ( p_pattern->p_ops          ) (void) path_realloc(0, p_pattern->p_ops, 0);
+    if ( p_pattern->p_alternatives ) (void) path_realloc(0, p_pattern->p_alternatives, 0);
+    (void) path_realloc(0, p_pattern, 0);
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_pattern:
+                #ifndef NDEBUG
+                    printf("[path] Null pointer provided for parameter \"pp_pattern\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            pointer_to_null_pointer:
+                #ifndef NDEBUG
+                    printf("[path] Parameter \"pp_pattern\" points to null pointer in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int path_enumeration_backend_set ( path_enumeration_backend backend )
+{
+
+    // Argument check
+    if ( backend > PATH_ENUMERATION_GETDENTS ) goto invalid_backend;
+
+    // Store the backend
+    _path_enumeration_backend = backend;
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            invalid_backend:
+                #ifndef NDEBUG
+                    printf("[path] Invalid value provided for parameter \"backend\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int path_metadata_backend_set ( path_metadata_backend backend )
+{
+
+    // Argument check
+    if ( backend > PATH_METADATA_IO_URING ) goto invalid_backend;
+
+    // Store the backend
+    _path_metadata_backend = backend;
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            invalid_backend:
+                #ifndef NDEBUG
+                    printf("[path] Invalid value provided for parameter \"backend\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int path_directory_reader_open ( path_directory_reader *p_reader, int directory_fd, char **pp_buffer, size_t *p_buffer_size, const path_allocator *const p_allocator )
+{
+
+    // Argument check
+    if ( p_reader     == (void *) 0 ) goto no_reader;
+    if ( directory_fd == -1         ) goto no_directory_fd;
+
+    // Initialized data
+    path_enumeration_backend backend = _path_enumeration_backend;
+    int                      fd      = -1;
+
+    // Zero set
+    memset(p_reader, 0, sizeof(path_directory_reader));
+
+    // Platform specific implementation
+    #ifdef __linux__
+
+        ///////////////////////////////
+        // getdents64 implementation //
+        ///////////////////////////////
+
+        // Default to the batched backend
+        if ( backend == PATH_ENUMERATION_DEFAULT ) backend = PATH_ENUMERATION_GETDENTS;
+
+        if ( backend == PATH_ENUMERATION_GETDENTS )
+        {
+
+            // Allocate the reusable buffer on first use
+            if ( *pp_buffer == (void *) 0 )
+            {
+
+                // Allocate memory for the buffer
+                *pp_buffer = path_realloc(p_allocator, 0, PATH_DIRENT_BUFFER_SIZE);
+
+                // Error check
+                if ( *pp_buffer == (void *) 0 ) goto no_mem;
+
+                // Store the size of the buffer
+                *p_buffer_size = PATH_DIRENT_BUFFER_SIZE;
+            }
+
+            // Rewind the directory
+            if ( lseek(directory_fd, 0, SEEK_SET) == -1 ) goto failed_to_open_directory;
+
+            // Populate the reader
+            p_reader->backend     = PATH_ENUMERATION_GETDENTS;
+            p_reader->fd          = directory_fd;
+            p_reader->p_buffer    = *pp_buffer;
+            p_reader->buffer_size = *p_buffer_size;
+
+            // Success
+            return 1;
+        }
+    #endif
+
+    ////////////////////////////
+    // readdir implementation //
+    ////////////////////////////
+
+    // The directory stream takes ownership of its descriptor
+    fd = fcntl(directory_fd, F_DUPFD_CLOEXEC, 0);
+
+    // Error check
+    if ( fd == -1 ) goto failed_to_open_directory;
+
+    // Open the directory
+    p_reader->p_directory = fdopendir(fd);
+
+    // Error check
+    if ( p_reader->p_directory == NULL ) 
+    {
+
+        // Clean up
+        (void) close(fd);
+
+        // Error
+        goto failed_to_open_directory;
+    }
+
+    // Rewind the directory
+    rewinddir(p_reader->p_directory);
+
+    // Store the backend
+    p_reader->backend = PATH_ENUMERATION_READDIR;
+    p_reader->fd      = directory_fd;
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_reader:
+                #ifndef NDEBUG
+                    printf("[path] Null pointer provided for parameter \"p_reader\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_directory_fd:
+                #ifndef NDEBUG
+                    printf("[path] Invalid file descriptor provided for parameter \"directory_fd\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // Standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    printf("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            failed_to_open_directory:
+                #ifndef NDEBUG
+                    printf("[Standard Library] Failed to open directory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int path_directory_reader_next ( path_directory_reader *p_reader, const char **pp_name, unsigned char *p_d_type )
+{
+
+    // Argument check
+    if ( p_reader == (void *) 0 ) goto no_reader;
+    if ( pp_name  == (void *) 0 ) goto no_name;
+    if ( p_d_type == (void *) 0 ) goto no_d_type;
+
+    // Platform specific implementation
+    #ifdef __linux__
+    if ( p_reader->backend == PATH_ENUMERATION_GETDENTS )
+    {
+
+        // Iterate until a name other than "." or ".." is found
+        while ( true )
+        {
+
+            // Initialized data
+            struct path_linux_dirent64 *p_dirent = 0;
+
+            // Refill the buffer
+            if ( p_reader->buffer_position >= p_reader->buffer_len )
+            {
+
+                // Initialized data
+                long r = syscall(SYS_getdents64, p_reader->fd, p_reader->p_buffer, p_reader->buffer_size);
+
+                // Error check
+                if ( r == -1 ) goto failed_to_read_directory;
+
+                // Done
+                if ( r == 0 ) return 0;
+
+                // Reset the cursor
+                p_reader->buffer_len      = (size_t) r;
+                p_reader->buffer_position = 0;
+            }
+
+            // Get the next record
+            p_dirent = (struct path_linux_dirent64 *) &p_reader->p_buffer[p_reader->buffer_position];
+
+            // Advance the cursor
+            p_reader->buffer_position += p_dirent->d_reclen;
+
+            // Skip "." and ".."
+            if ( p_dirent->d_name[0] == '.' && ( p_dirent->d_name[1] == '\0' || ( p_dirent->d_name[1] == '.' && p_dirent->d_name[2] == '\0' ) ) ) continue;
+
+            // Return the name and the type to the caller
+            *pp_name  = p_dirent->d_name;
+            *p_d_type = p_dirent->d_type;
+
+            // Success
+            return 1;
+        }
+    }
+    #endif
+
+    // Iterate until a name other than "." or ".." is found
+    while ( true )
+    {
+
+        // Initialized data
+        struct dirent *p_dirent = ( errno = 0, readdir(p_reader->p_directory) );
+
+        // Done, or failed
+        if ( p_dirent == (void *) 0 ) 
+        {
+            if ( errno ) goto failed_to_read_directory;
+            return 0;
+        }
+
+        // Skip "." and ".."
+        if ( p_dirent->d_name[0] == '.' && ( p_dirent->d_name[1] == '\0' || ( p_dirent->d_name[1] == '.' && p_dirent->d_name[2] == '\0' ) ) ) continue;
+
+        // Return the name and the type to the caller
+        *pp_name = p_dirent->d_name;
+        #ifdef _DIRENT_HAVE_D_TYPE
+            *p_d_type = p_dirent->d_type;
+        #else
+            *p_d_type = DT_UNKNOWN;
+        #endif
+
+        // Success
+        return 1;
+    }
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_reader:
+                #ifndef NDEBUG
+                    printf("[path] Null pointer provided for parameter \"p_reader\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_name:
+                #ifndef NDEBUG
+                    printf("[path] Null pointer provided for parameter \"pp_name\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_d_type:
+                #ifndef NDEBUG
+                    printf("[path] Null pointer provided for parameter \"p_d_type\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // Standard library errors
+        {
+            failed_to_read_directory:
+                #ifndef NDEBUG
+                    printf("[Standard Library] Failed to read directory. %s in call to function \"%s\"\n", strerror(errno), __FUNCTION__);
+                #endif
+
+                // The end of the directory was not reached
+                p_reader->failed = true;
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int path_directory_reader_close ( path_directory_reader *p_reader )
+{
+
+    // Argument check
+    if ( p_reader == (void *) 0 ) goto no_reader;
+
+    // Close the directory stream. The directory descriptor belongs to the caller
+    if ( p_reader->p_directory ) (void) closedir(p_reader->p_directory);
+
+    // Zero set
+    memset(p_reader, 0, sizeof(path_directory_reader));
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_reader:
+                #ifndef NDEBUG
+                    printf("[path] Null pointer provided for parameter \"p_reader\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+path_type path_type_from_mode ( unsigned int mode )
+{
+
+    // Directory
+    if ( ( mode & S_IFMT ) == S_IFDIR ) return PATH_TYPE_DIRECTORY;
+
+    // Socket
+    if ( ( mode & S_IFMT ) == S_IFSOCK ) return PATH_TYPE_SOCKET;
+
+    // Everything else is treated as a file
+    return PATH_TYPE_FILE;
+}
+
+int path_metadata_from_stat ( const struct stat *const p_st, path_metadata *p_metadata )
+{
+
+    // Populate the metadata
+    *p_metadata = (path_metadata)
+    {
+        .type                 = path_type_from_mode(p_st->st_mode),
+        .mode                 = (unsigned int) p_st->st_mode,
+        .size                 = (size_t) p_st->st_size,
+        .blocks               = (unsigned long long) p_st->st_blocks,
+        .links                = (unsigned long long) p_st->st_nlink,
+        .inode                = (unsigned long long) p_st->st_ino,
+        .device               = (unsigned long long) p_st->st_dev,
+        .modified_seconds     = (long long) p_st->st_mtim.tv_sec,
+        .modified_nanoseconds = (long) p_st->st_mtim.tv_nsec
+    };
+
+    // Success
+    return 1;
+}
+
+path_type path_directory_entry_type ( int directory_fd, const char *name, unsigned char d_type )
+{
+
+    // Initialized data
+    struct stat st = { 0 };
+
+    // The directory knows the type of the entry
+    switch ( d_type )
+    {
+        case DT_DIR:  return PATH_TYPE_DIRECTORY;
+        case DT_SOCK: return PATH_TYPE_SOCKET;
+        case DT_REG:  return PATH_TYPE_FILE;
+
+        // Symbolic links are resolved, and unknown types are looked up
+        case DT_LNK:
+        case DT_UNKNOWN:
+            break;
+
+        // Everything else is treated as a file
+        default: return PATH_TYPE_FILE;
+    }
+
+    // Stat the entry, relative to the directory
+    if ( fstatat(directory_fd, name, &st, 0) == -1 ) return PATH_TYPE_FILE;
+
+    // Success
+    return path_type_from_mode(st.st_mode);
+}
+
+#ifdef PATH_HAS_IO_URING
+int path_io_uring_create ( path_io_uring *p_ring, unsigned int entries )
+{
+
+    // Argument check
+    if ( p_ring == (void *) 0 ) goto no_ring;
+
+    // Initialized data
+    struct io_uring_params  params    = { 0 };
+    char                   *p_sq_ring = 0,
+                           *p_cq_ring = 0;
+
+    // Zero set
+    memset(p_ring, 0, sizeof(path_io_uring));
+
+    // Set up the ring
+    p_ring->fd = (int) syscall(__NR_io_uring_setup, entries, &params);
+
+    // Error check
+    if ( p_ring->fd < 0 ) goto failed_to_set_up_ring;
+
+    // Compute the size of each mapping
+    p_ring->sq_ring_size = params.sq_off.array + params.sq_entries * sizeof(unsigned int);
+    p_ring->cq_ring_size = params.cq_off.cqes  + params.cq_entries * sizeof(struct io_uring_cqe);
+    p_ring->sqes_size    = params.sq_entries * sizeof(struct io_uring_sqe);
+
+    // Both rings share one mapping
+    if ( params.features & IORING_FEAT_SINGLE_MMAP )
+    {
+        if ( p_ring->cq_ring_size > p_ring->sq_ring_size ) p_ring->sq_ring_size = p_ring->cq_ring_size;
+        p_ring->cq_ring_size = p_ring->sq_ring_size;
+    }
+
+    // Map the submission ring
+    p_ring->p_sq_ring = mmap(0, p_ring->sq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, p_ring->fd, IORING_OFF_SQ_RING);
+
+    // Error check
+    if ( p_ring->p_sq_ring == MAP_FAILED ) goto failed_to_map_ring;
+
+    // Map the completion ring
+    if ( params.features & IORING_FEAT_SINGLE_MMAP ) p_ring->p_cq_ring = p_ring->p_sq_ring;
+    else p_ring->p_cq_ring = mmap(0, p_ring->cq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, p_ring->fd, IORING_OFF_CQ_RING);
+
+    // Error check
+    if ( p_ring->p_cq_ring == MAP_FAILED ) goto failed_to_map_ring;
+
+    // Map the submission queue entries
+    p_ring->p_sqes = mmap(0, p_ring->sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, p_ring->fd, IORING_OFF_SQES);
+
+    // Error check
+    if ( p_ring->p_sqes == MAP_FAILED ) goto failed_to_map_ring;
+
+    // Store pointers into the rings
+    p_sq_ring          = p_ring->p_sq_ring,
+    p_cq_ring          = p_ring->p_cq_ring;
+    p_ring->p_sq_head  = (unsigned int *) ( p_sq_ring + params.sq_off.head );
+    p_ring->p_sq_tail  = (unsigned int *) ( p_sq_ring + params.sq_off.tail );
+    p_ring->p_sq_mask  = (unsigned int *) ( p_sq_ring + params.sq_off.ring_mask );
+    p_ring->p_sq_array = (unsigned int *) ( p_sq_ring + params.sq_off.array );
+    p_ring->p_cq_head  = (unsigned int *) ( p_cq_ring + params.cq_off.head );
+    p_ring->p_cq_tail  = (unsigned int *) ( p_cq_ring + params.cq_off.tail );
+    p_ring->p_cq_mask  = (unsigned int *) ( p_cq_ring + params.cq_off.ring_mask );
+    p_ring->p_cqes     = (struct io_uring_cqe *) ( p_cq_ring + params.cq_off.cqes );
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_ring:
+                #ifndef NDEBUG
+                    printf("[path] Null pointer provided for parameter \"p_ring\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // io_uring errors
+        {
+            failed_to_set_up_ring:
+
+                // io_uring is not available. The caller falls back to another backend
+                return 0;
+
+            failed_to_map_ring:
+                #ifndef NDEBUG
+                    printf("[Standard Library] Call to \"mmap\" returned an erroneous value in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Clean up
+                if ( p_ring->p_sqes    && p_ring->p_sqes    != MAP_FAILED ) (void) munmap(p_ring->p_sqes, p_ring->sqes_size);
+                if ( p_ring->p_cq_ring && p_ring->p_cq_ring != MAP_FAILED && p_ring->p_cq_ring != p_ring->p_sq_ring ) (void) munmap(p_ring->p_cq_ring, p_ring->cq_ring_size);
+                if ( p_ring->p_sq_ring && p_ring->p_sq_ring != MAP_FAILED ) (void) munmap(p_ring->p_sq_ring, p_ring->sq_ring_size);
+                (void) close(p_ring->fd);
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+struct io_uring_sqe *path_io_uring_get_sqe ( path_io_uring *p_ring )
+{
+
+    // Initialized data
+    unsigned int         tail  = *p_ring->p_sq_tail,
+                         head  = __atomic_load_n(p_ring->p_sq_head, __ATOMIC_ACQUIRE),
+                         index = tail & *p_ring->p_sq_mask;
+    struct io_uring_sqe *p_sqe = 0;
+
+    // The submission queue is full
+    if ( tail - head > *p_ring->p_sq_mask ) return 0;
+
+    // Get the next entry
+    p_sqe = &p_ring->p_sqes[index];
+
+    // Zero set
+    memset(p_sqe, 0, sizeof(struct io_uring_sqe));
+
+    // Publish the entry. The caller populates it before submitting
+    p_ring->p_sq_array[index] = index;
+    __atomic_store_n(p_ring->p_sq_tail, tail + 1, __ATOMIC_RELEASE);
+
+    // Success
+    return p_sqe;
+}
+
+int path_io_uring_submit_and_wait ( path_io_uring *p_ring, unsigned int submit_count, unsigned int wait_count )
+{
+
+    // Submit, and wait
+    while ( true )
+    {
+
+        // Initialized data
+        long r = syscall(__NR_io_uring_enter, p_ring->fd, submit_count, wait_count, IORING_ENTER_GETEVENTS, (void *) 0, 0);
+
+        // Error check
+        if ( r == -1 )
+        {
+            if ( errno == EINTR ) continue;
+            return 0;
+        }
+
+        // Done
+        if ( (unsigned int) r >= submit_count ) return 1;
+
+        // The kernel took none of the requests, and never will
+        if ( r == 0 ) return 0;
+
+        // The kernel took some of the requests, and didn't wait. Submit the rest
+        submit_count -= (unsigned int) r;
+    }
+}
+
+int path_io_uring_discard ( path_io_uring *p_ring )
+{
+
+    // Forget requests that were queued, but never submitted
+    __atomic_store_n(p_ring->p_sq_tail, __atomic_load_n(p_ring->p_sq_head, __ATOMIC_ACQUIRE), __ATOMIC_RELEASE);
+
+    // Success
+    return 1;
+}
+
+int path_io_uring_destroy ( path_io_uring *p_ring )
+{
+
+    // Unmap the rings
+    (void) munmap(p_ring->p_sqes, p_ring->sqes_size);
+    if ( p_ring->p_cq_ring != p_ring->p_sq_ring ) (void) munmap(p_ring->p_cq_ring, p_ring->cq_ring_size);
+    (void) munmap(p_ring->p_sq_ring, p_ring->sq_ring_size);
+
+    // Close the ring
+    (void) close(p_ring->fd);
+
+    // Success
+    return 1;
+}
+
+int path_metadata_from_statx ( const struct path_statx *const p_statx, path_metadata *p_metadata )
+{
+
+    // Populate the metadata
+    *p_metadata = (path_metadata)
+    {
+        .type                 = path_type_from_mode(p_statx->stx_mode),
+        .mode                 = (unsigned int) p_statx->stx_mode,
+        .size                 = (size_t) p_statx->stx_size,
+        .blocks               = p_statx->stx_blocks,
+        .links                = p_statx->stx_nlink,
+        .inode                = p_statx->stx_ino,
+        .device               = (unsigned long long) makedev(p_statx->stx_dev_major, p_statx->stx_dev_minor),
+        .modified_seconds     = p_statx->stx_mtime.tv_sec,
+        .modified_nanoseconds = (long) p_statx->stx_mtime.tv_nsec
+    };
+
+    // Success
+    return 1;
+}
+
+int path_statx_batch_create ( path_statx_batch **pp_batch, const path_allocator *const p_allocator )
+{
+
+    // Initialized data
+    path_statx_batch *p_batch = path_realloc(p_allocator, 0, sizeof(path_statx_batch));
+
+    // Error check
+    if ( p_batch == (void *) 0 ) goto no_mem;
+
+    // Zero set
+    memset(p_batch, 0, sizeof(path_statx_batch));
+
+    // Store the allocator
+    if ( p_allocator ) p_batch->allocator = *p_allocator;
+
+    // Set up the ring
+    if ( path_io_uring_create(&p_batch->ring, PATH_IO_URING_QUEUE_DEPTH) == 0 ) goto io_uring_unavailable;
+
+    // Return a pointer to the caller
+    *pp_batch = p_batch;
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // io_uring errors
+        {
+            io_uring_unavailable:
+
+                // Clean up
+                (void) path_realloc(p_allocator, p_batch, 0);
+
+                // Error
+                return 0;
+        }
+
+        // Standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    printf("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int path_statx_batch_flush ( path_statx_batch *p_batch, int directory_fd, path_listing *p_listing )
+{
+
+    // Initialized data
+    path_io_uring *p_ring    = &p_batch->ring;
+    size_t         completed = 0;
+
+    // Fast exit
+    if ( p_batch->count == 0 ) return 1;
+
+    // Queue a statx request for each entry
+    for (size_t i = 0; i < p_batch->count; i++)
+    {
+
+        // Initialized data
+        struct io_uring_sqe *p_sqe = path_io_uring_get_sqe(p_ring);
+
+        // Error check
+        if ( p_sqe == (void *) 0 ) goto failed_to_submit;
+
+        // Populate the request
+        p_sqe->opcode      = IORING_OP_STATX;
+        p_sqe->fd          = directory_fd;
+        p_sqe->addr        = (unsigned long long) (size_t) &p_listing->p_names[p_listing->p_offsets[p_batch->entries[i]]];
+        p_sqe->len         = PATH_STATX_BASIC_STATS;
+        p_sqe->off         = (unsigned long long) (size_t) &p_batch->statx[i];
+        p_sqe->statx_flags = 0;
+        p_sqe->user_data   = i;
+    }
+
+    // Submit the whole batch, and wait for every completion
+    if ( path_io_uring_submit_and_wait(p_ring, (unsigned int) p_batch->count, (unsigned int) p_batch->count) == 0 ) goto failed_to_submit;
+
+    // Reap the completions
+    while ( completed < p_batch->count )
+    {
+
+        // Initialized data
+        unsigned int head = *p_ring->p_cq_head,
+                     tail = __atomic_load_n(p_ring->p_cq_tail, __ATOMIC_ACQUIRE);
+
+        // Wait for more completions
+        if ( head == tail )
+        {
+
+            // Wait
+            if ( path_io_uring_submit_and_wait(p_ring, 0, 1) == 0 ) goto failed_to_submit;
+
+            // Try again
+            continue;
+        }
+
+        // Process each available completion
+        for (; head != tail; head++, completed++)
+        {
+
+            // Initialized data
+            struct io_uring_cqe *p_cqe        = &p_ring->p_cqes[head & *p_ring->p_cq_mask];
+            size_t               i            = (size_t) p_cqe->user_data;
+            size_t               entry        = p_batch->entries[i];
+            const char          *name         = &p_listing->p_names[p_listing->p_offsets[entry]];
+            path_metadata       *p_i_metadata = &p_listing->p_metadata[entry];
+            struct stat          st           = { 0 };
+
+            // Success
+            if ( p_cqe->res == 0 ) 
+                path_metadata_from_statx(&p_batch->statx[i], p_i_metadata);
+
+            // Kernels without IORING_OP_STATX, and transient errors, fall back to fstatat
+            else if ( p_cqe->res != -ENOENT && fstatat(directory_fd, name, &st, 0) == 0 )
+                path_metadata_from_stat(&st, p_i_metadata);
+
+            // Dangling symbolic links have no metadata
+            else
+                p_i_metadata->type = 0;
+
+            // Store the type
+            p_listing->p_types[entry] = (unsigned char) ( p_i_metadata->type ? p_i_metadata->type : PATH_TYPE_FILE );
+        }
+
+        // Consume the completions
+        __atomic_store_n(p_ring->p_cq_head, head, __ATOMIC_RELEASE);
+    }
+
+    // Empty the batch
+    p_batch->count = 0;
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // io_uring errors
+        {
+            failed_to_submit:
+                #ifndef NDEBUG
+                    printf("[path] Failed to submit statx requests to io_uring in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Empty the batch
+                (void) path_io_uring_discard(p_ring);
+                p_batch->count = 0;
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int path_statx_batch_destroy ( path_statx_batch **pp_batch )
+{
+
+    // Initialized data
+    path_statx_batch *p_batch = *pp_batch;
+
+    // No more pointer for caller
+    *pp_batch = 0;
+
+    // Destroy the ring
+    (void) path_io_uring_destroy(&p_batch->ring);
+
+    // Free the batch
+    (void) path_realloc(&p_batch->allocator, p_batch, 0);
+
+    // Success
+    return 1;
+}
+#endif
+
+int path_deque_create ( path_deque *p_deque )
+{
+
+    // Zero set
+    memset(p_deque, 0, sizeof(path_deque));
+
+    // Allocate memory for the tasks
+    p_deque->p_tasks = PATH_REALLOC(0, PATH_DEQUE_INITIAL_CAPACITY * sizeof(path_task));
+
+    // Error check
+    if ( p_deque->p_tasks == (void *) 0 ) goto no_mem;
+
+    // Store the capacity
+    p_deque->capacity = PATH_DEQUE_INITIAL_CAPACITY;
+
+    // Create a lock
+    if ( mutex_create(&p_deque->_lock) == 0 ) goto failed_to_create_mutex;
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // sync errors
+        {
+            failed_to_create_mutex:
+                #ifndef NDEBUG
+                    printf("[sync] Failed to create mutex in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Clean up
+                p_deque->p_tasks = PATH_REALLOC(p_deque->p_tasks, 0);
+
+                // Error
+                return 0;
+        }
+
+        // Standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    printf("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int path_deque_push ( path_deque *p_deque, path_task task )
+{
+
+    // Lock
+    mutex_lock(&p_deque->_lock);
+
+    // Grow the deque
+    if ( p_deque->bottom - p_deque->top == p_deque->capacity )
+    {
+
+        // Initialized data
+        size_t     capacity = p_deque->capacity * 2;
+        path_task *p_tasks  = PATH_REALLOC(0, capacity * sizeof(path_task));
+
+        // Error check
+        if ( p_tasks == (void *) 0 ) goto no_mem;
+
+        // Copy the tasks, in order
+        for (size_t i = p_deque->top; i < p_deque->bottom; i++)
+            p_tasks[i & ( capacity - 1 )] = p_deque->p_tasks[i & ( p_deque->capacity - 1 )];
+
+        // Free the old tasks
+        (void) PATH_REALLOC(p_deque->p_tasks, 0);
+
+        // Store the tasks
+        p_deque->p_tasks  = p_tasks;
+        p_deque->capacity = capacity;
+    }
+
+    // Push the task onto the bottom
+    p_deque->p_tasks[p_deque->bottom & ( p_deque->capacity - 1 )] = task;
+    p_deque->bottom++;
+
+    // Unlock
+    mutex_unlock(&p_deque->_lock);
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    printf("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Unlock
+                mutex_unlock(&p_deque->_lock);
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int path_deque_pop ( path_deque *p_deque, path_task *p_task )
+{
+
+    // Initialized data
+    int result = 0;
+
+    // Lock
+    mutex_lock(&p_deque->_lock);
+
+    // Pop the newest task from the bottom
+    if ( p_deque->bottom > p_deque->top )
+    {
+        p_deque->bottom--;
+        *p_task = p_deque->p_tasks[p_deque->bottom & ( p_deque->capacity - 1 )];
+        result = 1;
+    }
+
+    // Unlock
+    mutex_unlock(&p_deque->_lock);
+
+    // Done
+    return result;
+}
+
+int path_deque_steal ( path_deque *p_deque, path_task *p_task )
+{
+
+    // Initialized data
+    int result = 0;
+
+    // Lock
+    mutex_lock(&p_deque->_lock);
+
+    // Steal the oldest task from the top
+    if ( p_deque->bottom > p_deque->top )
+    {
+        *p_task = p_deque->p_tasks[p_deque->top & ( p_deque->capacity - 1 )];
+        p_deque->top++;
+        result = 1;
+    }
+
+    // Unlock
+    mutex_unlock(&p_deque->_lock);
+
+    // Done
+    return result;
+}
+
+int path_deque_destroy ( path_deque *p_deque )
+{
+
+    // Destroy the lock
+    mutex_destroy(&p_deque->_lock);
+
+    // Free the tasks
+    p_deque->p_tasks = PATH_REALLOC(p_deque->p_tasks, 0);
+
+    // Success
+    return 1;
+}
+
+int path_pool_push ( path_worker *p_worker, fn_path_task pfn_task, void *p_argument )
+{
+
+    // Initialized data
+    path_pool *p_pool = p_worker->p_pool;
+
+    // Count the task before it can be stolen
+    __atomic_add_fetch(&p_pool->pending, 1, __ATOMIC_ACQ_REL);
+
+    // Push the task onto this worker's deque
+    if ( path_deque_push(&p_worker->deque, (path_task) { .pfn_task = pfn_task, .p_argument = p_argument }) == 0 )
+    {
+
+        // Uncount the task
+        __atomic_sub_fetch(&p_pool->pending, 1, __ATOMIC_ACQ_REL);
+
+        // Error
+        return 0;
+    }
+
+    // Success
+    return 1;
+}
+
+void *path_pool_worker ( void *p_parameter )
+{
+
+    // Initialized data
+    path_worker *p_worker = p_parameter;
+    path_pool   *p_pool   = p_worker->p_pool;
+    size_t       idle     = 0;
+
+    // Run tasks until there are none left, anywhere
+    while ( true )
+    {
+
+        // Initialized data
+        path_task task  = { 0 };
+        bool      found = false;
+
+        // Take the newest task from this worker
+        found = path_deque_pop(&p_worker->deque, &task);
+
+        // Steal the oldest task from another worker
+        for (size_t i = 1; found == false && i < p_pool->worker_count; i++)
+            found = path_deque_steal(&p_pool->p_workers[( p_worker->index + i ) % p_pool->worker_count].deque, &task);
+
+        // Run the task
+        if ( found )
+        {
+
+            // Run
+            task.pfn_task(p_worker, task.p_argument);
+
+            // Uncount the task
+            __atomic_sub_fetch(&p_pool->pending, 1, __ATOMIC_ACQ_REL);
+
+            // Reset the back off
+            idle = 0;
+
+            // Next
+            continue;
+        }
+
+        // Done
+        if ( __atomic_load_n(&p_pool->pending, __ATOMIC_ACQUIRE) == 0 ) break;
+
+        // Back off
+        if ( idle++ < 64 ) sched_yield();
+        else               (void) nanosleep(&(struct timespec) { .tv_sec = 0, .tv_nsec = 50000 }, 0);
+    }
+
+    // Done
+    return 0;
+}
+
+int path_pool_run ( size_t thread_count, fn_path_task pfn_task, void *p_argument, void *p_context )
+{
+
+    // Argument check
+    if ( pfn_task == (void *) 0 ) goto no_task;
+
+    // Initialized data
+    path_pool pool    = { 0 };
+    size_t    started = 0;
+
+    // Default to one thread per processor
+    if ( thread_count == 0 )
+    {
+
+        // Initialized data
+        long processors = sysconf(_SC_NPROCESSORS_ONLN);
+
+        // Store the thread count
+        thread_count = ( processors > 0 ) ? (size_t) processors : 1;
+    }
+
+    // Populate the pool
+    pool.worker_count = thread_count;
+    pool.p_context    = p_context;
+    pool.p_workers    = PATH_REALLOC(0, thread_count * sizeof(path_worker));
+
+    // Error check
+    if ( pool.p_workers == (void *) 0 ) goto no_mem;
+
+    // Zero set
+    memset(pool.p_workers, 0, thread_count * sizeof(path_worker));
+
+    // Construct each worker
+    for (size_t i = 0; i < thread_count; i++)
+    {
+
+        // Populate the worker
+        pool.p_workers[i].p_pool = &pool;
+        pool.p_workers[i].index  = i;
+
+        // Construct a deque
+        if ( path_deque_create(&pool.p_workers[i].deque) == 0 ) 
+        {
+
+            // Clean up
+            while ( i-- ) path_deque_destroy(&pool.p_workers[i].deque);
+            pool.p_workers = PATH_REALLOC(pool.p_workers, 0);
+            (void) PATH_REALLOC(p_argument, 0);
+
+            // Error
+            goto failed_to_create_deque;
+        }
+    }
+
+    // Give the first task to the first worker
+    if ( path_pool_push(&pool.p_workers[0], pfn_task, p_argument) == 0 ) goto failed_to_start;
+
+    // Start a thread for each worker, except the first. The caller's thread is the first worker
+    for (started = 1; started < thread_count; started++)
+        if ( pthread_create(&pool.p_workers[started].thread, 0, path_pool_worker, &pool.p_workers[started]) != 0 ) break;
+
+    // Work
+    (void) path_pool_worker(&pool.p_workers[0]);
+
+    // Wait for the other workers
+    for (size_t i = 1; i < started; i++) (void) pthread_join(pool.p_workers[i].thread, 0);
+
+    // Clean up
+    for (size_t i = 0; i < thread_count; i++)
+    {
+
+        // Free the worker's scratch memory
+        if ( pool.p_workers[i].p_buffer ) (void) PATH_REALLOC(pool.p_workers[i].p_buffer, 0);
+        if ( pool.p_workers[i].p_text   ) (void) PATH_REALLOC(pool.p_workers[i].p_text, 0);
+
+        // Destroy the deque
+        path_deque_destroy(&pool.p_workers[i].deque);
+    }
+
+    // Free the workers
+    pool.p_workers = PATH_REALLOC(pool.p_workers, 0);
+
+    // Success, unless a task failed
+    return ( pool.failed == false );
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_task:
+                #ifndef NDEBUG
+                    printf("[path] Null pointer provided for parameter \"pfn_task\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Clean up
+                (void) PATH_REALLOC(p_argument, 0);
+
+                // Error
+                return 0;
+        }
+
+        // path errors
+        {
+            failed_to_create_deque:
+                #ifndef NDEBUG
+                    printf("[path] Failed to create work queue in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            failed_to_start:
+                #ifndef NDEBUG
+                    printf("[path] Failed to start work in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Clean up
+                for (size_t i = 0; i < thread_count; i++) path_deque_destroy(&pool.p_workers[i].deque);
+                pool.p_workers = PATH_REALLOC(pool.p_workers, 0);
+                (void) PATH_REALLOC(p_argument, 0);
+
+                // Error
+                return 0;
+        }
+
+        // Standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    printf("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Clean up
+                (void) PATH_REALLOC(p_argument, 0);
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+void path_pool_fail ( path_pool *p_pool )
+{
+
+    // Remember the failure, and stop every worker
+    __atomic_store_n(&p_pool->failed, true, __ATOMIC_RELAXED);
+    __atomic_store_n(&p_pool->abort, true, __ATOMIC_RELEASE);
+}
+
+int path_worker_text ( path_worker *p_worker, const char *directory_path, const char *name )
+{
+
+    // Initialized data
+    size_t directory_path_len = strlen(directory_path),
+           name_len           = strlen(name),
+           required_len       = directory_path_len + 1 + name_len + 1;
+
+    // Grow the text
+    if ( required_len > p_worker->text_max_len )
+    {
+
+        // Initialized data
+        char *p_text = PATH_REALLOC(p_worker->p_text, 2 * required_len);
+
+        // Error check
+        if ( p_text == (void *) 0 ) return 0;
+
+        // Store the text
+        p_worker->p_text       = p_text;
+        p_worker->text_max_len = 2 * required_len;
+    }
+
+    // Write the directory, a '/', the name, and a null terminator
+    memcpy(p_worker->p_text, directory_path, directory_path_len);
+    p_worker->p_text[directory_path_len] = '/';
+    memcpy(&p_worker->p_text[directory_path_len + 1], name, name_len + 1);
+
+    // Success
+    return 1;
+}
+
+int path_update_full_path ( path *p_path )
+{
+
+    // Argument check
+    if ( p_path == (void *) 0 ) goto no_path;
+
+    // Initialized data
+    char *slash      = strrchr(p_path->full_path.text, '/'),
+         *slash_name = ( slash ) ? slash + 1 : p_path->full_path.text;
+
+    // Get the name of the path
+    p_path->full_path.text_name = slash_name;
+
+    // Get the index of the last / character
+    p_path->full_path.i_text_name = ( slash_name - p_path->full_path.text );
+
+    // Get the length of the full path
+    p_path->full_path.text_len = ( slash_name + strlen(slash_name) ) - p_path->full_path.text;
+
+    p_path->full_path.text[p_path->full_path.text_len] = '\0';
+
+    // Clear dirty flag
+    p_path->full_path.dirty = false;
+
+    // Success
+    return 1;
+
+    no_path:
+
+    // Error
+    return 0;
+}
+
+int path_directory_fd_open ( path *p_path )
+{
+
+    // Argument check
+    if ( p_path == (void *) 0 ) goto no_path;
+
+    // Initialized data
+    char *text = p_path->full_path.text;
+    int   fd   = -1;
+
+    // Try to open the path as a directory
+    fd = open(text, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+
+    // The path is a directory
+    if ( fd != -1 )
+    {
+
+        // Store the directory
+        p_path->directory.fd            = fd;
+        p_path->directory.contains_path = false;
+
+        // Success
+        return 1;
+    }
+
+    // Error check
+    if ( errno != ENOTDIR ) goto failed_to_open_directory;
+
+    // The path is not a directory, so open the directory that contains it
+    {
+
+        // Initialized data
+        size_t i_text_name = p_path->full_path.i_text_name;
+        char   c           = 0;
+
+        // Relative to the working directory
+        if ( i_text_name == 0 ) fd = open(".", O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+
+        // Relative to the root directory
+        else if ( i_text_name == 1 ) fd = open("/", O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+
+        // Relative to some other directory
+        else
+        {
+
+            // Terminate the text at the last '/'
+            c = text[i_text_name - 1], text[i_text_name - 1] = '\0';
+
+            // Open the directory
+            fd = open(text, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+
+            // Restore the text
+            text[i_text_name - 1] = c;
+        }
+    }
+
+    // Error check
+    if ( fd == -1 ) goto failed_to_open_directory;
+
+    // Store the directory
+    p_path->directory.fd            = fd;
+    p_path->directory.contains_path = true;
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_path:
+                #ifndef NDEBUG
+                    printf("[path] Null pointer provided for parameter \"p_path\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // Standard library errors
+        {
+            failed_to_open_directory:
+                #ifndef NDEBUG
+                    printf("[Standard Library] Failed to open \"%s\" in call to function \"%s\"\n", p_path->full_path.text, __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int path_ancestor_push ( path *p_path, int fd )
+{
+
+    // Initialized data
+    path_ancestor *p_ancestor = 0;
+
+    // Allocate the ring
+    if ( p_path->ancestors.p_entries == (void *) 0 )
+    {
+
+        // Allocate the entries
+        p_path->ancestors.p_entries = path_realloc(&p_path->allocator, 0, PATH_HANDLE_DEPTH * sizeof(path_ancestor));
+
+        // Error check
+        if ( p_path->ancestors.p_entries == (void *) 0 ) return 0;
+    }
+
+    // The ring is full, so forget the oldest directory
+    if ( p_path->ancestors.count == PATH_HANDLE_DEPTH )
+    {
+
+        // Initialized data
+        path_ancestor *p_oldest = &p_path->ancestors.p_entries[p_path->ancestors.first];
+
+        // Close the directory
+        if ( p_oldest->fd != -1 ) (void) close(p_oldest->fd);
+
+        // Drop it
+        p_path->ancestors.first = ( p_path->ancestors.first + 1 ) % PATH_HANDLE_DEPTH;
+        p_path->ancestors.count--;
+    }
+
+    // Store the directory, and where its name is in the text
+    p_ancestor              = &p_path->ancestors.p_entries[( p_path->ancestors.first + p_path->ancestors.count ) % PATH_HANDLE_DEPTH];
+    p_ancestor->fd          = fd;
+    p_ancestor->i_text_name = p_path->full_path.i_text_name;
+    p_path->ancestors.count++;
+
+    // Success
+    return 1;
+}
+
+void path_ancestor_clear ( path *p_path )
+{
+
+    // Close each directory
+    for (size_t i = 0; i < p_path->ancestors.count; i++)
+    {
+
+        // Initialized data
+        int fd = p_path->ancestors.p_entries[( p_path->ancestors.first + i ) % PATH_HANDLE_DEPTH].fd;
+
+        // Close the directory
+        if ( fd != -1 ) (void) close(fd);
+    }
+
+    // Free the ring
+    if ( p_path->ancestors.p_entries ) p_path->ancestors.p_entries = path_realloc(&p_path->allocator, p_path->ancestors.p_entries, 0);
+
+    // Clear the ring
+    p_path->ancestors.first = 0;
+    p_path->ancestors.count = 0;
+}
+
+int path_directory_listing_clear ( path *p_path )
+{
+
+    // Argument check
+    if ( p_path == (void *) 0 ) goto no_path;
+
+    // Fast exit
+    if ( p_path->data.listed == false ) return 1;
+
+    // Empty the listing, and keep the memory for the next listing
+    (void) path_listing_reset(&p_path->data.listing);
+
+    // Clear the listing
+    p_path->data.listed = false;
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_path:
+                #ifndef NDEBUG
+                    printf("[path] Null pointer provided for parameter \"p_path\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+#ifdef __linux__
+void path_watcher_init ( void )
+{
+
+    // Create a lock
+    if ( mutex_create(&_path_watcher._lock) == 0 ) return;
+
+    // Create an inotify instance, shared by every watched path
+    _path_watcher.fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+
+    // Allocate memory for the watched paths
+    if ( _path_watcher.fd != -1 ) _path_watcher.pp_paths = PATH_REALLOC(0, PATH_WATCH_BUDGET * sizeof(path *));
+
+    // Error check
+    if ( _path_watcher.pp_paths == (void *) 0 && _path_watcher.fd != -1 )
+    {
+
+        // Clean up
+        (void) close(_path_watcher.fd);
+
+        // No watcher
+        _path_watcher.fd = -1;
+    }
+}
+#endif
+
+int path_watch_add ( path *p_path )
+{
+
+    // Fast exit
+    if ( ( p_path->flags & PATH_OPEN_WATCH ) == 0 ) return 1;
+    if ( p_path->watch.wd != -1                   ) return 1;
+
+    // Platform specific implementation
+    #ifdef __linux__
+    {
+
+        // Initialized data
+        char proc_path[64] = { 0 };
+        int  wd            = -1;
+
+        // Set up the watcher on first use
+        (void) pthread_once(&_path_watcher_once, path_watcher_init);
+
+        // inotify is not available. Fall back to timestamps
+        if ( _path_watcher.fd == -1 ) return 1;
+
+        // Lock
+        mutex_lock(&_path_watcher._lock);
+
+        // The budget is spent. Fall back to timestamps
+        if ( _path_watcher.count == PATH_WATCH_BUDGET ) goto done;
+
+        // Watch the open directory, wherever it is now
+        snprintf(proc_path, sizeof(proc_path), "/proc/self/fd/%d", p_path->directory.fd);
+
+        // Add a watch. Metadata listings also go stale when an entry is written to, or its attributes change.
+        // The kernel shares one watch per directory, so the mask is added to, not replaced
+        wd = inotify_add_watch(_path_watcher.fd, proc_path, 
+            IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO | IN_DELETE_SELF | IN_MOVE_SELF | IN_ONLYDIR | IN_MASK_ADD |
+            ( ( p_path->flags & PATH_OPEN_METADATA ) ? IN_MODIFY | IN_ATTRIB : 0 )
+        );
+
+        // Error check
+        if ( wd == -1 ) goto done;
+
+        // Register the path
+        _path_watcher.pp_paths[_path_watcher.count++] = p_path;
+
+        // Store the watch
+        p_path->watch.wd = wd;
+        __atomic_store_n(&p_path->watch.stale, false, __ATOMIC_RELAXED);
+
+        done:
+
+        // Unlock
+        mutex_unlock(&_path_watcher._lock);
+    }
+    #endif
+
+    // Success
+    return 1;
+}
+
+int path_watch_remove ( path *p_path )
+{
+
+    // Fast exit
+    if ( p_path->watch.wd == -1 ) return 1;
+
+    // Platform specific implementation
+    #ifdef __linux__
+    {
+
+        // Initialized data
+        bool shared = false;
+
+        // Lock
+        mutex_lock(&_path_watcher._lock);
+
+        // Unregister the path
+        for (size_t i = 0; i < _path_watcher.count; i++)
+            if ( _path_watcher.pp_paths[i] == p_path )
+            {
+                _path_watcher.pp_paths[i] = _path_watcher.pp_paths[--_path_watcher.count];
+                break;
+            }
+
+        // The kernel hands out one watch per directory, so other paths may share it
+        for (size_t i = 0; i < _path_watcher.count; i++)
+            if ( _path_watcher.pp_paths[i]->watch.wd == p_path->watch.wd ) shared = true;
+
+        // Remove the watch
+        if ( shared == false ) (void) inotify_rm_watch(_path_watcher.fd, p_path->watch.wd);
+
+        // Unlock
+        mutex_unlock(&_path_watcher._lock);
+    }
+    #endif
+
+    // Clear the watch
+    p_path->watch.wd = -1;
+    __atomic_store_n(&p_path->watch.stale, false, __ATOMIC_RELAXED);
+
+    // Success
+    return 1;
+}
+
+#ifdef __linux__
+int path_watch_apply ( path *p_path, const struct inotify_event *const p_event )
+{
+
+    // Nothing to patch
+    if ( p_path->data.listed == false || __atomic_load_n(&p_path->watch.stale, __ATOMIC_ACQUIRE) ) return 1;
+
+    // The directory itself went away, or the kernel dropped the watch
+    if ( p_event->mask & ( IN_DELETE_SELF | IN_MOVE_SELF | IN_IGNORED ) ) goto stale;
+
+    // Metadata isn't patched, so any change to an entry means reading it again
+    if ( p_path->flags & PATH_OPEN_METADATA ) goto stale;
+
+    // Writes, and attribute changes, don't change the listing
+    if ( ( p_event->mask & ( IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO ) ) == 0 ) return 1;
+
+    // Events without a name don't change the listing
+    if ( p_event->len == 0 ) return 1;
+
+    // Names that don't match aren't in the listing
+    if ( p_path->p_pattern && path_pattern_match(p_path->p_pattern, p_event->name) == false ) return 1;
+
+    // An entry left the directory
+    if ( p_event->mask & ( IN_DELETE | IN_MOVED_FROM ) )
+        if ( path_listing_remove(&p_path->data.listing, p_event->name) == 0 ) goto stale;
+
+    // An entry entered the directory. Entries of the same name are replaced
+    if ( p_event->mask & ( IN_CREATE | IN_MOVED_TO ) )
+        if ( path_listing_insert(&p_path->data.listing, p_event->name, path_directory_entry_type(p_path->directory.fd, p_event->name, ( p_event->mask & IN_ISDIR ) ? DT_DIR : DT_UNKNOWN)) == 0 ) goto stale;
+
+    // Success
+    return 1;
+
+    stale:
+
+        // Read the directory again on next use
+        __atomic_store_n(&p_path->watch.stale, true, __ATOMIC_RELEASE);
+
+        // Success
+        return 1;
+}
+#endif
+
+int path_watch_drain ( path *p_self )
+{
+
+    // Platform specific implementation
+    #ifdef __linux__
+    {
+
+        // Initialized data
+        char buffer[16 * 1024] __attribute__((aligned(__alignof__(struct inotify_event))));
+
+        // Set up the watcher on first use
+        (void) pthread_once(&_path_watcher_once, path_watcher_init);
+
+        // No watcher
+        if ( _path_watcher.fd == -1 ) return 1;
+
+        // Lock
+        mutex_lock(&_path_watcher._lock);
+
+        // Drain the queue
+        while ( true )
+        {
+
+            // Initialized data
+            ssize_t r = read(_path_watcher.fd, buffer, sizeof(buffer));
+
+            // No more events
+            if ( r <= 0 ) break;
+
+            // Iterate over each event
+            for (char *p = buffer; p < buffer + r; )
+            {
+
+                // Initialized data
+                const struct inotify_event *p_event = (const struct inotify_event *) p;
+
+                // Events were lost, so every listing is suspect
+                if ( p_event->mask & IN_Q_OVERFLOW )
+                    for (size_t i = 0; i < _path_watcher.count; i++) __atomic_store_n(&_path_watcher.pp_paths[i]->watch.stale, true, __ATOMIC_RELEASE);
+
+                // Update each path watching this directory
+                else
+                    for (size_t i = 0; i < _path_watcher.count; i++)
+                    {
+
+                        // Initialized data
+                        path *p_watched = _path_watcher.pp_paths[i];
+
+                        // Skip paths watching other directories
+                        if ( p_watched->watch.wd != p_event->wd ) continue;
+
+                        // Patch the listing. Listings of other paths may be read by other threads, 
+                        // so they are only marked stale, and read again by their owner
+                        if      ( p_self == (void *) 0 || p_self == p_watched ) (void) path_watch_apply(p_watched, p_event);
+                        else if ( p_watched->data.listed ) __atomic_store_n(&p_watched->watch.stale, true, __ATOMIC_RELEASE);
+                    }
+
+                // Next event
+                p += sizeof(struct inotify_event) + p_event->len;
+            }
+        }
+
+        // Unlock
+        mutex_unlock(&_path_watcher._lock);
+    }
+    #endif
+
+    // Success
+    return 1;
+}
+
+int path_watch_process ( void )
+{
+
+    // Patch the listing of every watched path
+    return path_watch_drain(0);
+}
+
+int path_watch_fd ( void )
+{
+
+    // Platform specific implementation
+    #ifdef __linux__
+
+        // Set up the watcher on first use
+        (void) pthread_once(&_path_watcher_once, path_watcher_init);
+
+        // Return the inotify descriptor
+        return _path_watcher.fd;
+    #else
+
+        // No watcher
+        return -1;
+    #endif
+}
+
+long long path_timespec_ns ( const struct timespec *const p_timespec )
+{
+
+    // Return
+    return (long long) p_timespec->tv_sec * 1000000000LL + (long long) p_timespec->tv_nsec;
+}
+
+int path_listing_cache_put ( path *p_path )
+{
+
+    // Argument check
+    if ( p_path == (void *) 0 ) goto no_path;
+
+    // Initialized data
+    path_listing_cache_entry *p_entry = 0;
+
+    // Fast exit
+    if ( p_path->data.listed == false ) return 1;
+
+    // Caching is disabled
+    if ( PATH_LISTING_CACHE_SIZE == 0 ) return path_directory_listing_clear(p_path);
+
+    // Listings with metadata go stale when a file changes, which the timestamps of the directory don't show
+    if ( p_path->flags & PATH_OPEN_METADATA ) return path_directory_listing_clear(p_path);
+
+    // Allocate the cache on first use
+    if ( p_path->listing_cache.p_entries == (void *) 0 )
+    {
+
+        // Allocate memory for the entries
+        p_path->listing_cache.p_entries = path_realloc(&p_path->allocator, 0, PATH_LISTING_CACHE_SIZE * sizeof(path_listing_cache_entry));
+
+        // Error check
+        if ( p_path->listing_cache.p_entries == (void *) 0 ) goto no_mem;
+    }
+
+    // Replace an older listing of the same directory
+    for (size_t i = 0; i < p_path->listing_cache.count; i++)
+    {
+
+        // Initialized data
+        path_listing_cache_entry *p_i_entry = &p_path->listing_cache.p_entries[i];
+
+        // Match
+        if ( p_i_entry->device == p_path->data.device && p_i_entry->inode == p_path->data.inode )
+        {
+
+            // Free the older listing
+            (void) path_listing_destroy(&p_i_entry->listing);
+
+            // Store the entry
+            p_entry = p_i_entry;
+
+            // Done
+            break;
+        }
+    }
+
+    // Append
+    if ( p_entry == (void *) 0 && p_path->listing_cache.count < PATH_LISTING_CACHE_SIZE )
+        p_entry = &p_path->listing_cache.p_entries[p_path->listing_cache.count++];
+
+    // Evict the least recently used listing
+    if ( p_entry == (void *) 0 )
+    {
+
+        // Initialized data
+        p_entry = &p_path->listing_cache.p_entries[0];
+
+        // Find the oldest entry
+        for (size_t i = 1; i < p_path->listing_cache.count; i++)
+            if ( p_path->listing_cache.p_entries[i].used < p_entry->used ) 
+                p_entry = &p_path->listing_cache.p_entries[i];
+
+        // Free the listing
+        (void) path_listing_destroy(&p_entry->listing);
+    }
+
+    // Populate the entry
+    *p_entry = (path_listing_cache_entry)
+    {
+        .device      = p_path->data.device,
+        .inode       = p_path->data.inode,
+        .modified    = p_path->data.modified,
+        .changed     = p_path->data.changed,
+        .listed_at   = p_path->data.listed_at,
+        .used        = ++p_path->listing_cache.clock,
+        .listing     = p_path->data.listing
+    };
+
+    // The cache owns the listing now
+    p_path->data.listing = (path_listing) { .allocator = p_path->allocator };
+    p_path->data.listed  = false;
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_path:
+                #ifndef NDEBUG
+                    printf("[path] Null pointer provided for parameter \"p_path\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // Standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    printf("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Don't cache
+                return path_directory_listing_clear(p_path);
+        }
+    }
+}
+
+int path_listing_cache_take ( path *p_path )
+{
+
+    // Initialized data
+    path_listing_cache_entry  entry   = { 0 };
+    struct stat               st      = { 0 };
+    bool                      found   = false;
+    long long                 settled = 0;
+
+    // Fast exit
+    if ( p_path->listing_cache.count == 0 ) return 0;
+
+    // Stat the directory. Identity and timestamps are checked right before the listing is used
+    if ( fstat(p_path->directory.fd, &st) == -1 ) return 0;
+
+    // Store the identity and timestamps
+    p_path->data.device   = (unsigned long long) st.st_dev;
+    p_path->data.inode    = (unsigned long long) st.st_ino;
+    p_path->data.modified = st.st_mtim;
+    p_path->data.changed  = st.st_ctim;
+
+    // Find the directory
+    for (size_t i = 0; i < p_path->listing_cache.count; i++)
+    {
+
+        // Initialized data
+        path_listing_cache_entry *p_i_entry = &p_path->listing_cache.p_entries[i];
+
+        // Match
+        if ( p_i_entry->device == p_path->data.device && p_i_entry->inode == p_path->data.inode )
+        {
+
+            // Take the entry out of the cache
+            entry = *p_i_entry;
+            *p_i_entry = p_path->listing_cache.p_entries[--p_path->listing_cache.count];
+            found = true;
+
+            // Done
+            break;
+        }
+    }
+
+    // Miss
+    if ( found == false ) return 0;
+
+    // A listing is stale if the directory changed since it was read
+    if ( path_timespec_ns(&entry.modified) != path_timespec_ns(&st.st_mtim) ) goto stale;
+    if ( path_timespec_ns(&entry.changed)  != path_timespec_ns(&st.st_ctim) ) goto stale;
+
+    // A listing is also stale if the directory changed within one timestamp tick of 
+    // the listing. A second change in the same tick would not move the timestamps
+    settled = path_timespec_ns(&entry.listed_at) - PATH_LISTING_RACY_NS;
+    if ( path_timespec_ns(&entry.modified) >= settled ) goto stale;
+    if ( path_timespec_ns(&entry.changed)  >= settled ) goto stale;
+
+    // Free the empty listing of the path
+    (void) path_listing_destroy(&p_path->data.listing);
+
+    // Reuse the listing
+    p_path->data.listing   = entry.listing;
+    p_path->data.listed_at = entry.listed_at;
+    p_path->data.listed    = true;
+
+    // Hit
+    return 1;
+
+    stale:
+
+        // Keep the memory of the listing, for the next listing
+        if ( p_path->data.listing.max == 0 && p_path->data.listing.names_max == 0 ) 
+        {
+            (void) path_listing_destroy(&p_path->data.listing);
+            p_path->data.listing = entry.listing;
+            (void) path_listing_reset(&p_path->data.listing);
+        }
+        else
+            (void) path_listing_destroy(&entry.listing);
+
+        // Miss
+        return 0;
+}
+
+int path_listing_cache_clear ( path *p_path )
+{
+
+    // Free each listing
+    for (size_t i = 0; i < p_path->listing_cache.count; i++) (void) path_listing_destroy(&p_path->listing_cache.p_entries[i].listing);
+
+    // Free the entries
+    if ( p_path->listing_cache.p_entries ) p_path->listing_cache.p_entries = path_realloc(&p_path->allocator, p_path->listing_cache.p_entries, 0);
+
+    // Zero set
+    memset(&p_path->listing_cache, 0, sizeof(p_path->listing_cache));
+
+    // Success
+    return 1;
+}
+
+int path_directory_list ( path *p_path )
+{
+
+    // Argument check
+    if ( p_path == (void *) 0 ) goto no_path;
+
+    // Initialized data
+    path_listing          *p_listing   = &p_path->data.listing;
+    path_directory_reader  reader      = { 0 };
+    const char            *p_name      = 0;
+    unsigned char          d_type      = DT_UNKNOWN;
+    #ifdef PATH_HAS_IO_URING
+    path_statx_batch      *p_statx_batch = 0;
+    #endif
+
+    // Error checking
+    if ( p_path->type != PATH_TYPE_DIRECTORY ) goto wrong_path_type;
+
+    // Empty the old listing
+    if ( path_directory_listing_clear(p_path) == 0 ) goto failed_to_clear_listing;
+
+    // Watch the directory before it is read, so no change is missed
+    (void) path_watch_add(p_path);
+    __atomic_store_n(&p_path->watch.stale, false, __ATOMIC_RELAXED);
+
+    // Reuse the listing from an earlier visit, if the directory hasn't changed since
+    if ( ( p_path->flags & PATH_OPEN_METADATA ) == 0 && path_listing_cache_take(p_path) ) return 1;
+
+    // Record the time of the listing, before anything is read
+    (void) clock_gettime(CLOCK_REALTIME, &p_path->data.listed_at);
+
+    // Add a column for entry metadata
+    if ( p_path->flags & PATH_OPEN_METADATA )
+        if ( path_listing_reserve(p_listing, 1, true) == 0 ) goto no_mem;
+
+    #ifdef PATH_HAS_IO_URING
+
+        // Set up batched metadata requests. If io_uring is not available, fall back to fstatat
+        if ( ( p_path->flags & PATH_OPEN_METADATA ) && _path_metadata_backend == PATH_METADATA_IO_URING )
+        {
+            if ( p_path->p_statx_batch == (void *) 0 ) (void) path_statx_batch_create(&p_path->p_statx_batch, &p_path->allocator);
+            p_statx_batch = p_path->p_statx_batch;
+
+            // Entries of an earlier listing are never carried into this one
+            if ( p_statx_batch ) p_statx_batch->count = 0;
+        }
+    #endif
+
+    // Open the directory
+    if ( path_directory_reader_open(&reader, p_path->directory.fd, &p_path->enumeration.p_buffer, &p_path->enumeration.buffer_size, &p_path->allocator) == 0 ) goto path_not_found;
+
+    // Iterate over each path
+    while ( path_directory_reader_next(&reader, &p_name, &d_type) )
+    {
+
+        // Initialized data
+        size_t i = p_listing->count;
+
+        // Skip names that don't match, before they are stored or stat'd
+        if ( p_path->p_pattern && path_pattern_match(p_path->p_pattern, p_name) == false ) continue;
+
+        // Store the name. The type is filled in below
+        if ( path_listing_append(p_listing, p_name, strlen(p_name), PATH_TYPE_FILE) == 0 )
+        {
+
+            // Clean up
+            (void) path_directory_reader_close(&reader);
+
+            // Error
+            goto no_mem;
+        }
+
+        // Full metadata
+        if ( p_path->flags & PATH_OPEN_METADATA )
+        {
+
+            #ifdef PATH_HAS_IO_URING
+
+                // Queue the entry, and read the metadata of a whole batch at once
+                if ( p_statx_batch )
+                {
+
+                    // Add the entry to the batch
+                    p_statx_batch->entries[p_statx_batch->count++] = i;
+
+                    // Flush a full batch
+                    if ( p_statx_batch->count == PATH_IO_URING_QUEUE_DEPTH )
+                        if ( path_statx_batch_flush(p_statx_batch, reader.fd, p_listing) == 0 )
+                        {
+
+                            // Clean up
+                            (void) path_directory_reader_close(&reader);
+
+                            // Error
+                            goto failed_to_read_metadata;
+                        }
+
+                    // Next entry
+                    continue;
+                }
+            #endif
+
+            // Initialized data
+            struct stat i_st = { 0 };
+
+            // Stat the entry, relative to the directory. Dangling symbolic links have no metadata
+            if ( fstatat(reader.fd, p_name, &i_st, 0) == 0 )
+            {
+
+                // Store the metadata
+                path_metadata_from_stat(&i_st, &p_listing->p_metadata[i]);
+
+                // Store the type
+                p_listing->p_types[i] = (unsigned char) p_listing->p_metadata[i].type;
+            }
+        }
+
+        // Type only
+        else
+            p_listing->p_types[i] = (unsigned char) path_directory_entry_type(reader.fd, p_name, d_type);
+    }
+
+    // A listing that stopped short is never published
+    if ( reader.failed )
+    {
+
+        // Clean up
+        (void) path_directory_reader_close(&reader);
+
+        // Error
+        goto path_not_found;
+    }
+
+    #ifdef PATH_HAS_IO_URING
+
+        // Flush the last batch
+        if ( p_statx_batch )
+            if ( path_statx_batch_flush(p_statx_batch, reader.fd, p_listing) == 0 )
+            {
+
+                // Clean up
+                (void) path_directory_reader_close(&reader);
+
+                // Error
+                goto failed_to_read_metadata;
+            }
+    #endif
+
+    // Close the directory
+    (void) path_directory_reader_close(&reader);
+
+    // Sort the listing by name
+    if ( path_listing_sort(p_listing) == 0 ) goto no_mem;
+
+    // The listing is ready
+    p_path->data.listed = true;
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_path:
+                #ifndef NDEBUG
+                    printf("[path] Null pointer provided for parameter \"p_path\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // path errors
+        {
+            wrong_path_type:
+                #ifndef NDEBUG
+                    printf("[path] Parameter \"p_path\" is not of type directory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            failed_to_clear_listing:
+                #ifndef NDEBUG
+                    printf("[path] Failed to clear directory listing in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            path_not_found:
+                #ifndef NDEBUG
+                    printf("[path] Failed to read directory \"%s\" in call to function \"%s\"\n", p_path->full_path.text, __FUNCTION__);
+                #endif
+
+                // Clean up
+                (void) path_listing_reset(p_listing);
+                #ifdef PATH_HAS_IO_URING
+                    if ( p_statx_batch ) p_statx_batch->count = 0;
+                #endif
+
+                // Error
+                return 0;
+
+            failed_to_read_metadata:
+                #ifndef NDEBUG
+                    printf("[path] Failed to read the metadata of the contents of \"%s\" in call to function \"%s\"\n", p_path->full_path.text, __FUNCTION__);
+                #endif
+
+                // Clean up
+                (void) path_listing_reset(p_listing);
+
+                // The ring may still have requests in flight, so the next listing makes a new one
+                #ifdef PATH_HAS_IO_URING
+                    if ( p_path->p_statx_batch ) (void) path_statx_batch_destroy(&p_path->p_statx_batch);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // Standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    printf("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Clean up
+                (void) path_listing_reset(p_listing);
+                #ifdef PATH_HAS_IO_URING
+                    if ( p_statx_batch ) p_statx_batch->count = 0;
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int path_directory_materialize ( const path *const p_path )
+{
+
+    // Apply changes to watched listings
+    if ( p_path->watch.wd != -1 ) 
+    {
+
+        // Patch the listing of this path. Other watched paths are only marked stale
+        (void) path_watch_drain((path *) p_path);
+
+        // Events were lost, or the listing can't be patched. Read the directory again
+        if ( __atomic_load_n(&p_path->watch.stale, __ATOMIC_ACQUIRE) ) return path_directory_list((path *) p_path);
+    }
+
+    // Already listed
+    if ( p_path->data.listed ) return 1;
+
+    // List the directory on first use. The listing is a cache, so it is filled in through a const path
+    return path_directory_list((path *) p_path);
+}
+
+int path_update_data ( path *p_path ) 
+{
+
+    // Argument check
+    if ( p_path == (void *) 0 ) goto no_path;
+    
+    // Clear the dirty bit
+    if ( p_path->data.dirty == false ) goto not_dirty;
+
+    // Initialized data
+    struct stat st = { 0 };
+    int         r  = 0;
+
+    // Open the directory
+    if ( p_path->directory.fd == -1 )
+        if ( path_directory_fd_open(p_path) == 0 ) 
+        {
+
+            // Set invalid state
+            p_path->type = 0;
+
+            // Error
+            goto no_file;
+        }
+
+    // Check path, relative to the directory that contains it
+    if ( p_path->directory.contains_path ) r = fstatat(p_path->directory.fd, p_path->full_path.text_name, &st, 0);
+
+    // Check path
+    else r = fstat(p_path->directory.fd, &st);
+
+    // Error check
+    if ( r == -1 ) 
+    {
+
+        // Set invalid state
+        p_path->type = 0;
+
+        // Error
+        goto no_file;
+    }
+
+    // A watched listing is kept current by events, so refreshing the same directory keeps it
+    if ( p_path->watch.wd != -1 && __atomic_load_n(&p_path->watch.stale, __ATOMIC_ACQUIRE) == false && p_path->data.listed &&
+         p_path->data.device == (unsigned long long) st.st_dev && p_path->data.inode == (unsigned long long) st.st_ino ) 
+    {
+
+        // Clear the dirty bit
+        p_path->data.dirty = false;
+
+        // Success
+        return 1;
+    }
+
+    // Stop watching the old directory
+    (void) path_watch_remove(p_path);
+
+    // Keep the listing of the old directory, for the next visit
+    if ( path_listing_cache_put(p_path) == 0 ) goto failed_to_clear_dict;
+
+    // Directory
+    if ( ( st.st_mode & S_IFMT ) == S_IFDIR )
+    {
+
+        // Set the type. The contents are listed on first use
+        p_path->type = PATH_TYPE_DIRECTORY;
+
+        // Store the identity and timestamps
+        p_path->data.device   = (unsigned long long) st.st_dev;
+        p_path->data.inode    = (unsigned long long) st.st_ino;
+        p_path->data.modified = st.st_mtim;
+        p_path->data.changed  = st.st_ctim;
+    }
+
+    // File
+    else if ( (st.st_mode & S_IFMT) == S_IFREG )
+    {
+
+        // Store the file type
+        p_path->type = PATH_TYPE_FILE;
+
+        // Store the file size
+        p_path->data.file = (size_t) st.st_size;
+    }
+
+    // Socket
+    else if ( (st.st_mode & S_IFMT) == S_IFSOCK )
+    {
+
+        // TODO:
+    }
+
+    // Clear the dirty bit
+    p_path->data.dirty = false;
+    
+    not_dirty:
+
+    //  Success
+    return 1;
+
+    // TODO: 
+    failed_to_clear_dict:
+    path_not_found:
+    no_file:
+
+    return 0;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_path:
+                #ifndef NDEBUG
+                    printf("[path] Null pointer provided for parameter \"p_path\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+void pfn_path_free( void *vp_memory )
+{
+
+    return;
+}
+
+int path_create_with_allocator ( path **pp_path, const path_allocator *const p_allocator )
+{
+
+    // Argument check
+    if ( pp_path == (void *) 0 ) goto no_path;    
+
+    // Initialized data
+    path *p_path = path_realloc(p_allocator, 0, sizeof(path));
+    
+    // Error check
+    if ( p_path == (void *) 0 ) goto no_mem;
+
+    // Zero set
+    memset(p_path, 0, sizeof(path));
+
+    // Store the allocator
+    if ( p_allocator ) p_path->allocator = *p_allocator;
+
+    // The listing uses the same allocator
+    p_path->data.listing.allocator = p_path->allocator;
+
+    // No directory
+    p_path->directory.fd = -1;
+
+    // No watch
+    p_path->watch.wd = -1;
+
+    // Return 
+    *pp_path = p_path;
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_path:
+                #ifndef NDEBUG
+                    printf("[path] Null pointer provided for parameter \"pp_path\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // Standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    printf("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int path_create ( path **pp_path )
+{
+
+    // Success
+    return path_create_with_allocator(pp_path, 0);
+}
+
+int path_construct ( path **pp_path, const char *path_text, int flags, const path_allocator *const p_allocator )
+{
+
+    // Argument check
+    if ( pp_path   == (void *) 0 ) goto no_path;
+    if ( path_text == (void *) 0 ) goto no_path_text;
+
+    // Initialized data
+    path   *p_path = 0;
+    size_t  path_text_len = strlen(path_text);
+
+    // Allocate a path
+    if ( path_create_with_allocator(&p_path, p_allocator) == 0 ) goto failed_to_allocate_path;
+
+    // Store the flags
+    p_path->flags = flags;
+
+    // Allocate memory for path
+    p_path->full_path.text_max_len = 1024+1+path_text_len;
+    p_path->full_path.text = path_realloc(&p_path->allocator, 0, sizeof(char)*(p_path->full_path.text_max_len));
+
+    // Error check
+    if ( p_path->full_path.text == (void *) 0 ) goto no_mem;
+
+    // Copy the string
+    strncpy(p_path->full_path.text, path_text, p_path->full_path.text_max_len);
+
+    p_path->full_path.dirty = true;
+    p_path->data.dirty = true;
+
+    path_update_full_path(p_path);
+    if ( path_update_data(p_path) == 0 )
+        goto failed_to_update_data;
+
+    // Return a pointer to the path
+    *pp_path = p_path;
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_path:
+                #ifndef NDEBUG
+                    printf("[path] Null pointer provided for parameter \"pp_path\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_path_text:
+                #ifndef NDEBUG
+                    printf("[path] Null pointer provided for parameter \"path_text\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // path errors
+        {
+            failed_to_allocate_path:
+                #ifndef NDEBUG
+                    printf("[path] Failed to allocate path in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            failed_to_update_data:
+                #ifndef NDEBUG
+                    printf("[path] Failed to read \"%s\" in call to function \"%s\"\n", path_text, __FUNCTION__);
+                #endif
+
+                // Clean up
+                (void) path_close(&p_path);
+
+                // Error
+                return 0;
+        }
+
+        // Standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    printf("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Clean up
+                (void) path_realloc(p_allocator, p_path, 0);
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int path_open ( path **pp_path, const char *path_string )
+{
+
+    // Success
+    return path_open_with_flags(pp_path, path_string, PATH_OPEN_DEFAULT);
+}
+
+int path_open_with_flags ( path **pp_path, const char *path_string, int flags )
+{
+
+    // Success
+    return path_open_with_allocator(pp_path, path_string, flags, 0);
+}
+
+int path_open_with_allocator ( path **pp_path, const char *path_string, int flags, const path_allocator *const p_allocator )
+{
+
+    // Argument check
+    if ( pp_path == (void *) 0 ) goto no_path;
+
+    // Initialized data
+    path *p_path = 0;
+
+    // Construct the path
+    if ( path_construct(&p_path, path_string, flags, p_allocator) == 0 ) goto failed_to_navigate;
+
+    // Return a pointer to the caller
+    *pp_path = p_path;
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_path:
+                #ifndef NDEBUG
+                    printf("[path] Null pointer provided for parameter \"pp_path\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error 
+                return 0;
+        }
+    
+        // path
+        {
+            failed_to_navigate:
+                #ifndef NDEBUG
+                    printf("[path] path_navigate returned an erroneous value in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+/*
+    // Platform dependent initialized data
+    #ifdef _WIN64
+
+    // Windows initialized data
+    WIN32_FIND_DATA  find_data      = { 0 };
+    char             _path[2048]    = "";
+    HANDLE           find_handle    = 0;
+    DWORD            path_attribute = 0;
+    DWORD            low_file_size  = 0;
+    DWORD            high_file_size = 0;
+    size_t           file_size      = 0;
+    char            *full_path      = 0;
+    char            *name           = 0;
+    #else
+
+    // Unix like initialized data
+    struct dirent *p_file_directory_entry;
+    DIR           *p_directory;
+    char           _path[2048]    = "";
+    size_t         file_size      = 0;
+    struct stat    st             = { 0 };
+    #endif
+    
+    // Platform dependent path_open implementation
+    #ifdef _WIN64
+
+    ////////////////////////////
+    // Windows implementation //
+    ////////////////////////////
+
+    // Allocate memory for the path
+    p_path = PATH_REALLOC(0, sizeof(path));
+
+    // Error check
+    if ( p_path == (void *) 0 )
+        goto no_mem;
+    
+    // Zero set
+    memset(p_path, 0, sizeof(path));
+
+    // Copy the user specified path into an internal buffer
+    sprintf(_path, "%s", path_string);
+
+    // Get information about the file
+    path_attribute = GetFileAttributesA(_path);
+
+    // Error check
+    if ( path_attribute == INVALID_FILE_ATTRIBUTES )
+        goto failed_to_get_file_attributes;
+
+    // Parse the file as a directory
+    if ( path_attribute & FILE_ATTRIBUTE_DIRECTORY )
+    {
+        // Initialized data
+        
+        size_t  directory_item_count = 0;
+        path   *p_directory_contents = 0;
+        path   *p_contents           = 0;
+               
+        // Copy the name
+        {
+
+            // Initialized data
+            // TODO: This could be better optimized
+            char   *after_backsl = strrchr(_path, '\\'),
+                   *after_fwdsl  = strrchr(_path, '/'),
+                   *after_sl     = 1 + ( after_backsl > after_fwdsl ) ? after_fwdsl : after_backsl;
+            size_t  len          = strlen(after_sl)-1;
+            
+            trim:
+            if ( len == 0 )
+            {
+                *after_sl = '\0';
+                after_backsl = strrchr(_path, '\\'),
+                after_fwdsl  = strrchr(_path, '/'),
+                after_sl     = ( after_backsl < after_fwdsl ) ? after_fwdsl : after_backsl;
+                len          = strlen(after_sl) - 1; 
+                goto trim;
+            }
+
+            // Allocate memory for name
+            name = PATH_REALLOC(0, sizeof(char) * ( len + 1 )); // Don't need to allocate a null terminator
+
+            // Error check
+            if ( name == (void *) 0 )
+                goto no_mem;
+            
+            // Copy the name
+            strncpy(name, after_sl+1, len);
+
+            // Write a null terminator
+            name[len] = '\0';
+        }
+
+        // Copy the full path
+        {
+
+            // Initialized data
+            size_t len = strlen(_path);
+            
+            // Allocate memory for the full path string
+            full_path = PATH_REALLOC(0, sizeof(char) * ( len + 1024 ));
+
+            // Error check
+            if ( full_path == (void *) 0 )
+                goto no_mem;
+            
+            // Copy the full path
+            strncpy(full_path, _path, len);
+
+            // Write a null terminator
+            full_path[len] = '\0';
+
+            // Write a null terminator
+            strncat(full_path, "\\*.*", 4);
+        }   
+
+        // Recursively construct paths from the directory
+        {
+
+            
+
+            // Get the first file in a directory
+            find_handle = FindFirstFileA(full_path, &find_data);
+
+            // Error check
+            if ( find_handle == INVALID_HANDLE_VALUE )
+                goto path_not_found;//printf("Path not found: [%s]\n", path);
+
+            // Parse the path as a directory
+            if ( find_data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY )
+            {
+                
+                // Skip past "." and ".."
+                if ( FindNextFileA(find_handle, &find_data) == 0 )
+                    goto find_next_file_failed;
+
+                // Iterate over each item in the directory
+                while ( FindNextFileA(find_handle, &find_data) )
+                {
+
+                    // Initialized data
+                    path *i_path = PATH_REALLOC(0, sizeof(path));
+
+                    // Error check
+                    if ( i_path == (void *) 0 )
+                        goto no_mem;
+
+                    // Increment the directory counter
+                    directory_item_count++;
+
+                    // Zero set
+                    memset(i_path, 0, sizeof(path));
+
+                    // Build the file path 
+                    sprintf(full_path, "%s\\%s", path_string, find_data.cFileName);
+
+                    // Parse the item as a directory
+                    if ( find_data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY )
+                    {
+                        //printf("Directory: %s\n", full_path);
+                        //fflush(stdout);
+                        path_open(&p_contents, p_path, full_path);
+                        path_append_file(&p_directory_contents, p_contents);
+                    }
+
+                    // Parse the item as a file
+                    else
+                    {
+                        //printf("File: %s\n", full_path);
+                        //fflush(stdout);
+                        path_open(&p_contents, p_path, full_path);
+                        path_append_file(&p_directory_contents, p_contents);
+                    }
+                }
+
+                // Clean up the scope
+                FindClose(find_handle);
+                
+            }
+        }
+
+        // Populate the path struct
+        *p_path = (path)
+        {
+            .full_path               = full_path,
+            .name                    = name,
+            .type                    = PATH_TYPE_DIRECTORY,
+            .p_parent_directory_path = p_parent_path,
+            .directory = {
+                .p_directory_contents   = p_directory_contents,
+                .directory_content_size = directory_item_count
+            }
+        };
+
+        // Clean up
+        //CloseHandle(file);
+    }
+
+    // Parse the path as a file
+    else
+    {
+
+        // Initialized data
+        HANDLE file = CreateFile(
+            _path,
+            GENERIC_READ | GENERIC_WRITE,
+            0,
+            NULL,
+            OPEN_EXISTING,
+            FILE_ATTRIBUTE_NORMAL,
+            NULL
+        );
+
+        // Error check
+        if ( file == INVALID_HANDLE_VALUE )
+            goto failed_to_open_file;
+
+        // Copy the name
+        {
+
+            // Initialized data
+            // TODO: This could be better optimized
+            char   *after_backsl = strrchr(_path, '\\'),
+                   *after_fwdsl  = strrchr(_path, '/'),
+                   *after_sl     = 1 + ( after_backsl > after_fwdsl ) ? after_fwdsl : after_backsl;
+            size_t  len          = strlen(after_sl)-1;
+
+            // Allocate memory for name
+            name = PATH_REALLOC(0, sizeof(char) * ( len + 1 ));
+
+            // Error check
+            if ( name == (void *) 0 )
+                goto no_mem;
+            
+            // Copy the name
+            strncpy(name, after_sl+1, len);
+
+            // Write a null terminator
+            name[len] = '\0';
+        }
+
+        // Copy the full path
+        {
+
+            // Initialized data
+            size_t len = strlen(_path);
+
+            // Allocate memory for the full path string
+            full_path = PATH_REALLOC(0, sizeof(char) * ( len + 1 ));
+
+            // Error check
+            if ( full_path == (void *) 0 )
+                goto no_mem;
+            
+            // Copy the full path
+            strncpy(full_path, _path, len);
+
+            // Write a null terminator
+            full_path[len] = '\0';
+        }   
+
+        // Get the file size
+        {
+            low_file_size = GetFileSize(file, &high_file_size);
+
+            file_size = (high_file_size << 32) | low_file_size;
+        }
+
+        // Populate the path struct
+        *p_path = (path)
+        {
+            .full_path               = full_path,
+            .name                    = name,
+            .type                    = PATH_TYPE_FILE,
+            .p_next_content          = 0,
+            .p_parent_directory_path = p_parent_path,
+            .file = {
+                .file_size = file_size
+            }
+        };
+
+        // Clean up
+        CloseHandle(file);
+    }
+
+    #else
+
+    /////////////////////////
+    // UNIX implementation //
+    /////////////////////////
+
+    // Initialized data
+    char *full_path = 0;
+
+    // Allocate a path
+    if ( path_create(&p_path) == (void *) 0 ) goto no_mem;
+    
+    // Copy the path parameter into an internal buffer
+    sprintf(_path, "%s", path_string);
+
+    // Get the path properties
+    if ( stat(path_string, &st) != 0 ) goto failed_to_get_file_properties;
+
+    // Copy the full path
+    {
+
+        // Initialized data
+        size_t len = strlen(_path);
+        
+        // Allocate memory for the full path string
+        full_path = PATH_REALLOC(0, sizeof(char) * ( len + 1024 ));
+
+        // Error check
+        if ( full_path == (void *) 0 ) goto no_mem;
+        
+        // Copy the full path
+        strncpy(full_path, _path, len);
+
+        // Write a null terminator
+        full_path[len] = '\0';
+
+        // Write a null terminator
+        strncat(full_path, "\\*.*", 4);
+    }  
+
+    // Parse the path as a directory
+    if ( (st.st_mode & S_IFMT) == S_IFDIR )
+    {
+
+        // Initialized data
+        size_t  directory_item_count = 0,
+                _path_len = strlen(_path);
+        char   *directory_name       = 0;
+        dict   *directory_dict       = 0;
+
+        // Copy the name
+        {
+
+            // Initialized data
+            // TODO: This could be better optimized
+            char   *after_backsl = strrchr(_path, '\\'),
+                   *after_fwdsl  = strrchr(_path, '/'),
+                   *after_sl     = 1 + ( after_backsl > after_fwdsl ) ? after_fwdsl : after_backsl;
+            size_t  len          = strlen(after_sl)-1;
+            
+            trim:
+            if ( len == 0 )
+            {
+                *after_sl = '\0';
+                after_backsl = strrchr(_path, '\\'),
+                after_fwdsl  = strrchr(_path, '/'),
+                after_sl     = ( after_backsl < after_fwdsl ) ? after_fwdsl : after_backsl;
+                len          = strlen(after_sl) - 1; 
+                goto trim;
+            }
+
+            // Allocate memory for name
+            directory_name = PATH_REALLOC(0, sizeof(char) * ( len + 1 )); // Don't need to allocate a null terminator
+
+            // Error check
+            if ( directory_name == (void *) 0 ) goto no_mem;
+            
+            // Copy the name
+            strncpy(directory_name, after_sl+1, len);
+
+            // Write a null terminator
+            directory_name[len] = '\0';
+        }
+
+        // Copy the full path
+        {
+            
+            // Allocate memory for the full path string
+            full_path = PATH_REALLOC(0, sizeof(char) * ( _path_len + 1024 ));
+
+            // Error check
+            if ( full_path == (void *) 0 ) goto no_mem;
+            
+            // Copy the full path
+            strncpy(full_path, _path, _path_len);
+
+            // Write a null terminator
+            full_path[_path_len] = '\0';
+        }   
+
+        // Construct paths from the directory contents
+        {
+
+            // Open the directory
+            p_directory = opendir(full_path);
+
+            // Error check
+            if ( p_directory == NULL ) goto path_not_found;
+            
+            // Skip "."
+            p_file_directory_entry = readdir(p_directory);
+
+            // Skip ".."
+            p_file_directory_entry = readdir(p_directory);
+
+            dict_construct(&directory_dict, 32);
+
+            // Iterate over each path
+            while ( ( p_file_directory_entry = readdir(p_directory) ) )
+            {
+
+                // Initialized data
+                path *i_path = PATH_REALLOC(0, sizeof(path));
+
+                // Error check
+                if ( i_path == (void *) 0 ) goto no_mem;
+
+                // Zero set
+                memset(i_path, 0, sizeof(path));
+
+                // Build the path 
+                sprintf(full_path, "%s/%s", path_string, p_file_directory_entry->d_name);
+
+                // Parse the path as a directory
+                if ( (st.st_mode & S_IFMT) == S_IFDIR ) dict_add(directory_dict, full_path, (void *)PATH_TYPE_DIRECTORY);
+
+                // Parse the path as a file
+                else dict_add(directory_dict, full_path, (void *)PATH_TYPE_FILE);
+                
+            }
+
+            // Write a null terminator
+            full_path[_path_len] = '\0';
+        }
+
+        // Populate the path struct
+        *p_path = (path)
+        {
+            .full_path = full_path,
+            .name      = directory_name,
+            .type      = PATH_TYPE_DIRECTORY,
+            .directory = directory_dict
+        };
+    }
+
+    // Parse the path as a file
+    else if ( (st.st_mode & S_IFMT) == S_IFREG )
+    {
+
+        // Initialized data
+        char *full_path = 0;
+        char *file_name = 0;
+
+        // Copy the name
+        {
+
+            // Initialized data
+            // TODO: This could be better optimized
+            char   *after_backsl = strrchr(_path, '\\'),
+                   *after_fwdsl  = strrchr(_path, '/'),
+                   *after_sl     = 1 + ( after_backsl > after_fwdsl ) ? after_fwdsl : after_backsl;
+            size_t  len          = strlen(after_sl)-1;
+            
+            // Allocate memory for the file name
+            file_name = PATH_REALLOC(0, ( len + 1 ) * sizeof(char));
+
+            // Error check
+            if ( file_name == (void *) 0 ) goto no_mem;
+            
+            // Copy the name
+            strncpy(file_name, after_sl+1, len);
+
+            // Write a null terminator
+            file_name[len] = '\0';
+        }
+
+        // Copy the full path
+        {
+
+            // Initialized data
+            size_t len = strlen(_path);
+
+            // Allocate memory for the full path string
+            full_path = PATH_REALLOC(0, sizeof(char) * ( len + 1 ));
+
+            // Error check
+            if ( full_path == (void *) 0 ) goto no_mem;
+            
+            // Copy the full path
+            strncpy(full_path, _path, len);
+
+            // Write a null terminator
+            full_path[len] = '\0';
+        }   
+
+        // Populate the path struct
+        *p_path = (path)
+        {
+            .full_path = full_path,
+            .name      = file_name,
+            .type      = PATH_TYPE_FILE,
+            .file      = st.st_size
+        };
+    }
+    #endif
+
+*/
+
+const char *path_name_text ( const path *const p_path )
+{
+
+    // Argument check
+    if ( p_path == (void *) 0 ) goto no_path;
+
+    // 
+    if ( p_path->full_path.dirty ) path_update_full_path( p_path );
+
+    // Success
+    return p_path->full_path.text_name;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_path:
+                #ifndef NDEBUG
+                    printf("[path] Null pointer provided for parameter \"p_path\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+path_type path_type_path ( const path *const p_path )
+{
+
+    // Argument check
+    if ( p_path == (void *) 0 ) goto no_path;
+
+    // Success
+    return p_path->type;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_path:
+                #ifndef NDEBUG
+                    printf("[path] Null pointer provided for parameter \"p_path\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+const char *path_full_path_text ( const path *const p_path )
+{
+
+    // Argument check
+    if ( p_path == (void *) 0 ) goto no_path;
+
+    // Find the name in the text, only if it changed
+    if ( p_path->full_path.dirty ) 
+        if ( path_update_full_path(p_path) == 0 )
+            goto failed_to_update_full_path; 
+
+    // Success
+    return p_path->full_path.text;
+
+    failed_to_update_full_path:
+
+    // Error
+    return 0;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_path:
+                #ifndef NDEBUG
+                    printf("[path] Null pointer provided for parameter \"p_path\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+bool path_is_file ( const path * const p_path )
+{
+
+    // Argument check
+    if ( p_path == (void *) 0 ) goto no_path;
+
+    // Success
+    return ( p_path->type == PATH_TYPE_FILE) ? true : false;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_path:
+                #ifndef NDEBUG
+                    printf("[path] Null pointer provided for parameter \"p_path\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int path_file_size ( const path *const p_path, size_t *p_size_in_bytes )
+{
+    
+    // Argument check
+    if ( p_path          == (void *) 0 ) goto no_path;
+    if ( p_size_in_bytes == (void *) 0 ) goto no_size_in_bytes;
+
+    // Error checking
+    if ( p_path->type != PATH_TYPE_FILE ) goto wrong_path_type;
+
+    // State checking
+    if ( p_path->data.dirty == true ) path_update_data(p_path);
+
+    // Return
+    *p_size_in_bytes = p_path->data.file;
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_path:
+                #ifndef NDEBUG
+                    printf("[path] Null pointer provided for parameter \"p_path\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_size_in_bytes:
+                #ifndef NDEBUG
+                    printf("[path] Null pointer provided for parameter \"p_size_in_bytes\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    
+        // Path errors
+        {
+            wrong_path_type:
+                #ifndef NDEBUG
+                    printf("[path] Parameter \"p_path\" was of wrong type in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+size_t path_directory_content_types ( const path *const p_path, path_type *const types )
+{
+
+    // List the directory
+    if ( path_directory_materialize(p_path) == 0 ) return 0;
+
+    // Return the quantity of contents
+    if ( types == (void *) 0 ) return p_path->data.listing.count;
+
+    // Widen each type
+    for (size_t i = 0; i < p_path->data.listing.count; i++) types[i] = (path_type) p_path->data.listing.p_types[i];
+
+    // Success
+    return 1;
+}
+
+int path_directory_content_metadata ( const path *const p_path, const char *name, path_metadata *p_metadata )
+{
+
+    // Argument check
+    if ( p_path     == (void *) 0 ) goto no_path;
+    if ( name       == (void *) 0 ) goto no_name;
+    if ( p_metadata == (void *) 0 ) goto no_metadata;
+
+    // Initialized data
+    const path_listing *p_listing = &p_path->data.listing;
+    size_t              index     = 0;
+    struct stat         st        = { 0 };
+
+    // Error checking
+    if ( p_path->type != PATH_TYPE_DIRECTORY ) goto wrong_path_type;
+
+    // Read the metadata of every entry at once, when the path was opened with PATH_OPEN_METADATA
+    if ( p_path->flags & PATH_OPEN_METADATA )
+        if ( path_directory_materialize(p_path) == 0 ) goto failed_to_stat;
+
+    // Metadata was read when the directory was listed
+    if ( p_listing->p_metadata && p_path->data.listed )
+    {
+
+        // Look up the entry
+        if ( path_listing_find(p_listing, name, &index) == false ) goto failed_to_stat;
+
+        // Error check
+        if ( p_listing->p_metadata[index].type == 0 ) goto failed_to_stat;
+
+        // Return a copy to the caller
+        *p_metadata = p_listing->p_metadata[index];
+
+        // Success
+        return 1;
+    }
+
+    // Stat the entry, relative to the directory
+    if ( fstatat(p_path->directory.fd, name, &st, 0) == -1 ) goto failed_to_stat;
+
+    // Return the metadata to the caller
+    path_metadata_from_stat(&st, p_metadata);
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_path:
+                #ifndef NDEBUG
+                    printf("[path] Null pointer provided for parameter \"p_path\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_name:
+                #ifndef NDEBUG
+                    printf("[path] Null pointer provided for parameter \"name\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_metadata:
+                #ifndef NDEBUG
+                    printf("[path] Null pointer provided for parameter \"p_metadata\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // Path errors
+        {
+            wrong_path_type:
+                #ifndef NDEBUG
+                    printf("[path] Parameter \"p_path\" is not of type directory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // Standard library errors
+        {
+            failed_to_stat:
+                #ifndef NDEBUG
+                    printf("[path] Failed to stat \"%s\" in call to function \"%s\"\n", name, __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+void path_navigate_retire ( int fd, int current_fd, const path_navigate_ancestor *p_ancestors, size_t ancestor_count )
+{
+
+    // A file has no directory of its own, and the directory navigation ended in is kept
+    if ( fd == -1 || fd == current_fd ) return;
+
+    // Directories navigation passed through are kept, for ".."
+    for (size_t i = 0; i < ancestor_count; i++) if ( p_ancestors[i].fd == fd ) return;
+
+    // Close the directory
+    (void) close(fd);
+}
+
+int path_navigate_resolve ( path *p_path, const char *path_text )
+{
+
+    // Initialized data
+    size_t                  path_text_len  = strlen(path_text),
+                            text_len       = p_path->full_path.text_len,
+                            text_max_len   = text_len + 2 * path_text_len + 4,
+                            i_text_name    = p_path->full_path.i_text_name,
+                            ancestor_count = 0,
+                            ancestor_max   = 1,
+                            popped         = 0;
+    int                     fd             = p_path->directory.fd;
+    bool                    owned          = false,
+                            contains_path  = p_path->directory.contains_path;
+    char                   *p_text         = 0,
+                           *p_names        = 0;
+    path_navigate_ancestor *p_ancestors    = 0;
+
+    // Each name may pass through one directory
+    for (size_t i = 0; i < path_text_len; i++) if ( path_text[i] == '/' ) ancestor_max++;
+
+    // Allocate the text, a copy of the names, and the directories navigation passes through
+    p_text      = path_realloc(&p_path->allocator, 0, text_max_len);
+    p_names     = path_realloc(&p_path->allocator, 0, path_text_len + 1);
+    p_ancestors = path_realloc(&p_path->allocator, 0, ancestor_max * sizeof(path_navigate_ancestor));
+
+    // Error check
+    if ( p_text == (void *) 0 || p_names == (void *) 0 || p_ancestors == (void *) 0 ) goto failed;
+
+    // Copy the text, and the names
+    memcpy(p_text, p_path->full_path.text, text_len + 1);
+    memcpy(p_names, path_text, path_text_len + 1);
+
+    // Resolve each name. The path is untouched until every name resolves
+    for (char *p_name = p_names, *p_next = 0; p_name; p_name = p_next)
+    {
+
+        // Initialized data
+        size_t name_len = 0;
+
+        // Split the name from the rest of the path text
+        p_next = strchr(p_name, '/');
+        if ( p_next ) *p_next++ = '\0';
+        name_len = strlen(p_name);
+
+        // Empty names, and ".", are this path
+        if ( name_len == 0 || strcmp(p_name, ".") == 0 ) continue;
+
+        // ".." returns to the directory the path came from
+        if ( strcmp(p_name, "..") == 0 )
+        {
+
+            // Initialized data
+            path_navigate_ancestor  ancestor   = { 0 },
+                                   *p_ancestor = 0;
+
+            // A directory this navigation passed through
+            if ( ancestor_count ) p_ancestor = &p_ancestors[--ancestor_count];
+
+            // A directory the path passed through before
+            else if ( ( p_path->flags & PATH_OPEN_HANDLE ) && popped < p_path->ancestors.count )
+            {
+
+                // Initialized data
+                path_ancestor *p_entry = &p_path->ancestors.p_entries[( p_path->ancestors.first + p_path->ancestors.count - ++popped ) % PATH_HANDLE_DEPTH];
+
+                // The path still owns the directory
+                ancestor   = (path_navigate_ancestor) { .fd = p_entry->fd, .i_text_name = p_entry->i_text_name, .owned = false };
+                p_ancestor = &ancestor;
+            }
+
+            // Return to the directory
+            if ( p_ancestor )
+            {
+
+                // The path was a file, in the directory that is already open
+                if ( p_ancestor->fd != -1 )
+                {
+                    if ( owned ) (void) close(fd);
+                    fd    = p_ancestor->fd;
+                    owned = p_ancestor->owned;
+                }
+                contains_path = false;
+
+                // Remove the last name from the text
+                text_len         = i_text_name - 1;
+                p_text[text_len] = '\0';
+                i_text_name      = p_ancestor->i_text_name;
+
+                // Next name
+                continue;
+            }
+
+            // The directory that contains a file is its parent
+            if ( contains_path ) contains_path = false;
+
+            // Open the parent
+            else
+            {
+
+                // Initialized data
+                int parent_fd = openat(fd, "..", O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+
+                // Error check
+                if ( parent_fd == -1 ) goto failed;
+
+                // Release the child
+                if ( owned ) (void) close(fd);
+
+                // Store the parent
+                fd    = parent_fd;
+                owned = true;
+            }
+
+            // The parent of "." is ".."
+            if ( strcmp(&p_text[i_text_name], ".") == 0 )
+            {
+                memcpy(&p_text[i_text_name], "..", 3);
+                text_len = i_text_name + 2;
+            }
+
+            // The parent of ".." is "../.."
+            else if ( strcmp(&p_text[i_text_name], "..") == 0 )
+            {
+                memcpy(&p_text[text_len], "/..", 4);
+                i_text_name  = text_len + 1;
+                text_len    += 3;
+            }
+
+            // The parent of a relative name is the working directory
+            else if ( i_text_name == 0 )
+            {
+                memcpy(p_text, ".", 2);
+                text_len = 1;
+            }
+
+            // The parent of "/name" is the root, and the root is its own parent
+            else if ( i_text_name == 1 )
+            {
+                p_text[1] = '\0';
+                text_len  = 1;
+            }
+
+            // Remove the last name
+            else
+            {
+
+                // Initialized data
+                char *slash = 0;
+
+                // Remove the name, and its '/'
+                text_len         = i_text_name - 1;
+                p_text[text_len] = '\0';
+
+                // Find the name before it
+                slash       = strrchr(p_text, '/');
+                i_text_name = ( slash ) ? (size_t) ( slash - p_text ) + 1 : 0;
+            }
+
+            // Next name
+            continue;
+        }
+
+        // Only a directory has names in it
+        if ( contains_path ) goto failed;
+
+        // Open the child, relative to the directory
+        {
+
+            // Initialized data
+            int child_fd = openat(fd, p_name, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+
+            // Error check. A child that is not a directory is kept in its parent
+            if ( child_fd == -1 && errno != ENOTDIR ) goto failed;
+
+            // Keep the parent open, for "..". Otherwise, release it
+            if ( p_path->flags & PATH_OPEN_HANDLE )
+                p_ancestors[ancestor_count++] = ( child_fd == -1 ) ? (path_navigate_ancestor) { .fd = -1, .i_text_name = i_text_name, .owned = false }
+                                                                   : (path_navigate_ancestor) { .fd = fd, .i_text_name = i_text_name, .owned = owned };
+            else if ( child_fd != -1 && owned ) (void) close(fd);
+
+            // The child is a file
+            if ( child_fd == -1 ) contains_path = true;
+
+            // The child is a directory
+            else
+            {
+                fd    = child_fd;
+                owned = true;
+            }
+        }
+
+        // Write a '/', and the name
+        if ( text_len == 0 || p_text[text_len - 1] != '/' ) p_text[text_len++] = '/';
+        i_text_name = text_len;
+        memcpy(&p_text[text_len], p_name, name_len + 1);
+        text_len += name_len;
+    }
+
+    // Release directories the path passed through, and navigation returned through
+    for (size_t i = 0; i < popped; i++)
+    {
+        p_path->ancestors.count--;
+        path_navigate_retire(p_path->ancestors.p_entries[( p_path->ancestors.first + p_path->ancestors.count ) % PATH_HANDLE_DEPTH].fd, fd, p_ancestors, ancestor_count);
+    }
+
+    // Release the directory the path was in
+    path_navigate_retire(p_path->directory.fd, fd, p_ancestors, ancestor_count);
+
+    // Keep each directory navigation passed through, for ".."
+    for (size_t i = 0; i < ancestor_count; i++)
+    {
+        if ( path_ancestor_push(p_path, p_ancestors[i].fd) )
+            p_path->ancestors.p_entries[( p_path->ancestors.first + p_path->ancestors.count - 1 ) % PATH_HANDLE_DEPTH].i_text_name = p_ancestors[i].i_text_name;
+        else if ( p_ancestors[i].fd != -1 )
+            (void) close(p_ancestors[i].fd);
+    }
+
+    // Store the directory
+    p_path->directory.fd            = fd;
+    p_path->directory.contains_path = contains_path;
+
+    // Store the text
+    (void) path_realloc(&p_path->allocator, p_path->full_path.text, 0);
+    p_path->full_path.text         = p_text;
+    p_path->full_path.text_max_len = text_max_len;
+    p_path->full_path.text_len     = text_len;
+    p_path->full_path.i_text_name  = i_text_name;
+    p_path->full_path.text_name    = &p_text[i_text_name];
+    p_path->full_path.dirty        = false;
+
+    // Clean up
+    (void) path_realloc(&p_path->allocator, p_ancestors, 0);
+    (void) path_realloc(&p_path->allocator, p_names, 0);
+
+    // Success
+    return 1;
+
+    failed:
+
+    // Release each directory navigation opened
+    if ( owned ) (void) close(fd);
+    for (size_t i = 0; i < ancestor_count; i++) if ( p_ancestors[i].owned ) (void) close(p_ancestors[i].fd);
+
+    // Clean up
+    if ( p_ancestors ) (void) path_realloc(&p_path->allocator, p_ancestors, 0);
+    if ( p_names )     (void) path_realloc(&p_path->allocator, p_names, 0);
+    if ( p_text )      (void) path_realloc(&p_path->allocator, p_text, 0);
+
+    // Error
+    return 0;
+}
+
+int path_navigate ( path **pp_path, const char *path_text )
+{
+
+    // Argument check
+    if ( pp_path   == (void *) 0 ) goto no_path;
+    if ( path_text == (void *) 0 ) goto no_path_text;
+    if ( *pp_path  == (void *) 0 ) goto construct_path;
+
+    // Navigate branch
+    {
+
+        // Initialized data
+        path *p_path = (void *) *pp_path;
+        
+        // Special cases
+        if ( p_path->full_path.dirty ) path_update_full_path(p_path);
+        if ( path_update_data(p_path) == 0 )
+            goto failed_to_navigate;
+
+        // Resolve each name, then store the result. On error, the path is unchanged
+        if ( path_navigate_resolve(p_path, path_text) == 0 ) goto failed_to_navigate;
+
+        // Update the data
+        p_path->data.dirty = true;
+        if ( path_update_data(p_path) == 0 )
+            goto failed_to_navigate;
+
+        // Success
+        return 1;
+    }
+
+    // Constructor branch
+    construct_path:
+
+        // Success
+        return path_construct(pp_path, path_text, PATH_OPEN_DEFAULT, 0);
+    
+    failed_to_clear_dict:
+    path_not_found:
+    no_mem:
+    failed_to_allocate_path:
+    wrong_path_type:
+
+    // Error
+    return 0;
+    
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_path:
+                #ifndef NDEBUG
+                    printf("[path] Null pointer provided for parameter \"pp_path\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_path_text:
+                #ifndef NDEBUG
+                    printf("[path] Null pointer provided for parameter \"path_text\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+        
+        // path errors
+        {
+            failed_to_store_path:
+                #ifndef NDEBUG
+                    printf("[path] Failed to store path in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            failed_to_navigate:
+                #ifndef NDEBUG
+                    printf("[path] Failed to navigate in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int path_create_file ( path *p_path, const char *file_name )
+{
+
+    // Argument check
+    if ( p_path    == (void *) 0 ) goto no_path;
+    if ( file_name == (void *) 0 ) goto no_file_name;
+
+    // Initialized data
+    int fd = -1;
+
+    // Error checking
+    if ( p_path->type != PATH_TYPE_DIRECTORY ) goto wrong_path_type;
+
+    // Create the file, relative to the directory
+    fd = openat(p_path->directory.fd, file_name, O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0666);
+
+    // Error check
+    if ( fd == -1 ) goto failed_to_open_file;
+
+    // Close the file
+    (void) close(fd);
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_path:
+                #ifndef NDEBUG
+                    printf("[path] Null pointer provided for parameter \"pp_path\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_file_name:
+                #ifndef NDEBUG
+                    printf("[path] Null pointer provided for parameter \"file_name\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // Path errors
+        {
+            wrong_path_type:
+                #ifndef NDEBUG
+                    printf("[path] Parameter \"p_path\" is not of type directory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    
+        // Standard library errors
+        {
+            failed_to_open_file:
+                #ifndef NDEBUG
+                    printf("[path] Failed to create file \"%s\" in call to function \"%s\"\n", file_name, __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;          
+        }
+    }
+}
+
+#ifdef PATH_HAS_IO_URING
+int path_create_files_io_uring ( int directory_fd, const char *const *names, size_t count, size_t *p_created, bool *p_failed )
+{
+
+    // Initialized data
+    path_io_uring ring                           = { 0 };
+    int           fds[PATH_IO_URING_QUEUE_DEPTH] = { 0 };
+    size_t        batch_count                    = 0;
+
+    // Nothing was created yet
+    *p_created = 0;
+
+    // Set up the ring. Without io_uring, the caller creates each file
+    if ( path_io_uring_create(&ring, PATH_IO_URING_QUEUE_DEPTH) == 0 ) return 0;
+
+    // Create the files, one batch at a time
+    for (size_t base = 0; base < count; base += PATH_IO_URING_QUEUE_DEPTH)
+    {
+
+        // Initialized data
+        size_t close_count  = 0;
+        bool   batch_failed = false;
+
+        // No file in this batch is open yet
+        batch_count = ( count - base < PATH_IO_URING_QUEUE_DEPTH ) ? count - base : PATH_IO_URING_QUEUE_DEPTH;
+        for (size_t i = 0; i < batch_count; i++) fds[i] = -1;
+
+        // Queue an openat request for each file, and a close request for each fd it returns
+        for (int pass = 0; pass < 2; pass++)
+        {
+
+            // Initialized data
+            size_t submit_count = ( pass == 0 ) ? batch_count : close_count,
+                   completed    = 0;
+
+            // Nothing to close
+            if ( submit_count == 0 ) break;
+
+            // Queue the requests
+            for (size_t i = 0, j = 0; i < batch_count; i++)
+            {
+
+                // Initialized data
+                struct io_uring_sqe *p_sqe = 0;
+
+                // Only files that were opened are closed
+                if ( pass == 1 && fds[i] < 0 ) continue;
+
+                // Get an entry
+                p_sqe = path_io_uring_get_sqe(&ring);
+
+                // Error check
+                if ( p_sqe == (void *) 0 ) goto failed_to_submit;
+
+                // Populate the request
+                if ( pass == 0 )
+                {
+                    p_sqe->opcode     = IORING_OP_OPENAT;
+                    p_sqe->fd         = directory_fd;
+                    p_sqe->addr       = (unsigned long long) (size_t) names[base + i];
+                    p_sqe->len        = 0666;
+                    p_sqe->open_flags = O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC;
+                }
+                else
+                {
+                    p_sqe->opcode = IORING_OP_CLOSE;
+                    p_sqe->fd     = fds[i];
+                }
+                p_sqe->user_data = i;
+                j++;
+            }
+
+            // Submit the batch, and wait for every completion
+            if ( path_io_uring_submit_and_wait(&ring, (unsigned int) submit_count, (unsigned int) submit_count) == 0 ) goto failed_to_submit;
+
+            // Reap the completions
+            while ( completed < submit_count )
+            {
+
+                // Initialized data
+                unsigned int head = *ring.p_cq_head,
+                             tail = __atomic_load_n(ring.p_cq_tail, __ATOMIC_ACQUIRE);
+
+                // Wait for more completions
+                if ( head == tail )
+                {
+                    if ( path_io_uring_submit_and_wait(&ring, 0, 1) == 0 ) goto failed_to_submit;
+                    continue;
+                }
+
+                // Process each available completion
+                for (; head != tail; head++, completed++)
+                {
+
+                    // Initialized data
+                    struct io_uring_cqe *p_cqe = &ring.p_cqes[head & *ring.p_cq_mask];
+                    size_t               i     = (size_t) p_cqe->user_data;
+
+                    // An opened file
+                    if ( pass == 0 )
+                    {
+
+                        // Store the fd
+                        fds[i] = p_cqe->res;
+
+                        // Kernels without IORING_OP_OPENAT fall back to openat
+                        if ( fds[i] == -EINVAL ) fds[i] = openat(directory_fd, names[base + i], O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0666);
+
+                        // Error check
+                        if ( fds[i] < 0 ) batch_failed = true;
+                        else              close_count++;
+                    }
+
+                    // A closed file
+                    else
+                    {
+
+                        // Kernels without IORING_OP_CLOSE fall back to close
+                        if ( p_cqe->res == -EINVAL ) (void) close(fds[i]);
+
+                        // The fd is gone
+                        fds[i] = -1;
+                    }
+                }
+
+                // Consume the completions
+                __atomic_store_n(ring.p_cq_head, head, __ATOMIC_RELEASE);
+            }
+        }
+
+        // Every file in this batch was created, or failed to be
+        if ( batch_failed ) *p_failed = true;
+        *p_created = base + batch_count;
+    }
+
+    // Clean up
+    (void) path_io_uring_destroy(&ring);
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // io_uring errors
+        {
+            failed_to_submit:
+                #ifndef NDEBUG
+                    printf("[path] Failed to submit requests to io_uring in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Forget requests that were never submitted
+                (void) path_io_uring_discard(&ring);
+
+                // Close each file this batch opened
+                for (size_t i = 0; i < batch_count; i++) if ( fds[i] >= 0 ) (void) close(fds[i]);
+
+                // Clean up
+                (void) path_io_uring_destroy(&ring);
+
+                // Error. The caller creates the rest of the files, starting with this batch
+                return 0;
+        }
+    }
+}
+#endif
+
+int path_create_files ( path *p_path, const char *const *names, size_t count, int flags )
+{
+
+    // Argument check
+    if ( p_path == (void *) 0 ) goto no_path;
+    if ( names  == (void *) 0 ) goto no_names;
+
+    // Initialized data
+    bool   failed  = false;
+    size_t created = 0;
+
+    // Error checking
+    if ( p_path->type != PATH_TYPE_DIRECTORY ) goto wrong_path_type;
+
+    // Submit every file through io_uring, where it is available
+    #ifdef PATH_HAS_IO_URING
+        if ( ( flags & PATH_CREATE_IO_URING ) && path_create_files_io_uring(p_path->directory.fd, names, count, &created, &failed) ) goto done;
+    #endif
+
+    // Create each file the ring didn't, relative to the directory
+    for (size_t i = created; i < count; i++)
+    {
+
+        // Initialized data
+        int fd = openat(p_path->directory.fd, names[i], O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0666);
+
+        // Error check. Keep creating the rest
+        if ( fd == -1 )
+        {
+            failed = true;
+            continue;
+        }
+
+        // Close the file
+        (void) close(fd);
+    }
+
+    done:
+
+    // Error check
+    if ( failed ) goto failed_to_create_file;
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_path:
+                #ifndef NDEBUG
+                    printf("[path] Null pointer provided for parameter \"p_path\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_names:
+                #ifndef NDEBUG
+                    printf("[path] Null pointer provided for parameter \"names\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // Path errors
+        {
+            wrong_path_type:
+                #ifndef NDEBUG
+                    printf("[path] Parameter \"p_path\" is not of type directory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // Standard library errors
+        {
+            failed_to_create_file:
+                #ifndef NDEBUG
+                    printf("[path] Failed to create one or more files in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int path_create_directory( path *p_path, const char *directory_name )
+{
+    
+    // Argument check
+    if ( p_path         == (void *) 0 ) goto no_path;
+    if ( directory_name == (void *) 0 ) goto no_directory_name;
+
+    // Error checking
+    if ( p_path->type != PATH_TYPE_DIRECTORY ) goto wrong_path_type;
+    
+    // Platform specific implementation
+    #ifdef _WIN64
+        ////////////////////////////
+        // Windows implementation //
+        ////////////////////////////
+    #else
+
+        /////////////////////////
+        // UNIX implementation //
+        /////////////////////////
+
+        // Make a directory, relative to the directory
+        if ( mkdirat(p_path->directory.fd, directory_name, 0777) != 0 ) goto failed_to_create_directory;
+
+    #endif
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_path:
+                #ifndef NDEBUG
+                    printf("[path] Null pointer provided for parameter \"pp_path\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_directory_name:
+                #ifndef NDEBUG
+                    printf("[path] Null pointer provided for parameter \"directory_name\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // Path errors
+        {
+            wrong_path_type:
+                #ifndef NDEBUG
+                    printf("[path] Parameter \"p_path\" is not of type directory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    
+        // Standard library errors
+        {
+            failed_to_create_directory:
+                #ifndef NDEBUG
+                    printf("[path] Failed to create directory \"%s\" in call to function \"%s\"\n", directory_name, __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;          
+        }
+    }
+}
+
+int path_create_directories_at ( const path_allocator *const p_allocator, int base_fd, const char *path_text )
+{
+
+    // Initialized data
+    char        *text  = 0;
+    size_t       len   = strlen(path_text),
+                 start = 0;
+    int          fd    = -1,
+                 r     = 0;
+    struct stat  st    = { 0 };
+
+    // Error check
+    if ( len == 0 ) return 0;
+
+    // Allocate a copy of the text, so it can be split in place
+    text = path_realloc(p_allocator, 0, len + 1);
+
+    // Error check
+    if ( text == (void *) 0 ) return 0;
+
+    // Copy the text, without trailing slashes
+    memcpy(text, path_text, len + 1);
+    while ( len > 1 && text[len - 1] == '/' ) text[--len] = '\0';
+
+    // Fast path. The parent exists, so make the directory in one call. An existing directory is fine
+    if ( mkdirat(base_fd, text, 0777) == 0 ) goto done;
+    if ( errno == EEXIST ) 
+    {
+        r = ( fstatat(base_fd, text, &st, 0) == 0 && S_ISDIR(st.st_mode) );
+        goto free_text;
+    }
+
+    // Text too long for the kernel is made one name at a time
+    if ( errno != ENOENT && errno != ENAMETOOLONG ) goto free_text;
+
+    // Find the deepest ancestor that exists
+    for (size_t end = len; ; )
+    {
+
+        // Initialized data
+        size_t slash = end;
+
+        // Find the previous separator
+        while ( slash > 0 && text[slash - 1] != '/' ) slash--;
+        while ( slash > 1 && text[slash - 2] == '/' ) slash--;
+
+        // No ancestor in the text exists. Start from the base
+        if ( slash == 0 ) 
+        {
+            fd    = base_fd;
+            start = 0;
+            break;
+        }
+
+        // Open the ancestor
+        text[slash - 1] = '\0';
+        fd = ( slash == 1 ) ? open("/", O_RDONLY | O_DIRECTORY | O_CLOEXEC) : openat(base_fd, text, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+        text[slash - 1] = '/';
+
+        // Found it
+        if ( fd != -1 )
+        {
+            start = slash;
+            break;
+        }
+
+        // Error check
+        if ( errno != ENOENT && errno != ENAMETOOLONG ) goto free_text;
+
+        // Try the parent of the ancestor
+        end = slash - 1;
+    }
+
+    // Make each missing directory, relative to its parent
+    for (char *p_name = &text[start], *p_next = 0; *p_name; p_name = p_next)
+    {
+
+        // Initialized data
+        int child_fd = -1;
+
+        // Split the next name
+        p_next = strchr(p_name, '/');
+        if ( p_next ) *p_next++ = '\0';
+        else          p_next = p_name + strlen(p_name);
+
+        // Skip repeated separators, and "."
+        if ( p_name[0] == '\0' || strcmp(p_name, ".") == 0 ) continue;
+
+        // Make the directory. Another process may have made it first
+        if ( mkdirat(fd, p_name, 0777) == -1 && errno != EEXIST ) goto close_fd;
+
+        // Open it, to make the next directory in it
+        child_fd = openat(fd, p_name, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+
+        // Release the parent
+        if ( fd != base_fd ) (void) close(fd);
+        fd = child_fd;
+
+        // Error check
+        if ( fd == -1 ) goto free_text;
+    }
+
+    done:
+
+    // Success
+    r = 1;
+
+    close_fd:
+
+    // Clean up
+    if ( fd != -1 && fd != base_fd ) (void) close(fd);
+
+    free_text:
+
+    // Clean up
+    (void) path_realloc(p_allocator, text, 0);
+
+    // Done
+    return r;
+}
+
+int path_create_directories ( path *p_path, const char *path_text )
+{
+
+    // Argument check
+    if ( p_path    == (void *) 0 ) goto no_path;
+    if ( path_text == (void *) 0 ) goto no_path_text;
+
+    // Error checking
+    if ( p_path->type != PATH_TYPE_DIRECTORY ) goto wrong_path_type;
+
+    // Make each directory
+    if ( path_create_directories_at(&p_path->allocator, p_path->directory.fd, path_text) == 0 ) goto failed_to_create_directory;
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_path:
+                #ifndef NDEBUG
+                    printf("[path] Null pointer provided for parameter \"p_path\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_path_text:
+                #ifndef NDEBUG
+                    printf("[path] Null pointer provided for parameter \"path_text\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // Path errors
+        {
+            wrong_path_type:
+                #ifndef NDEBUG
+                    printf("[path] Parameter \"p_path\" is not of type directory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // Standard library errors
+        {
+            failed_to_create_directory:
+                #ifndef NDEBUG
+                    printf("[path] Failed to create directory \"%s\". %s in call to function \"%s\"\n", path_text, strerror(errno), __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int path_create_directory_trees ( path *p_path, const char *const *paths, size_t count )
+{
+
+    // Argument check
+    if ( p_path == (void *) 0 ) goto no_path;
+    if ( paths  == (void *) 0 ) goto no_paths;
+
+    // Initialized data
+    bool failed = false;
+
+    // Error checking
+    if ( p_path->type != PATH_TYPE_DIRECTORY ) goto wrong_path_type;
+
+    // Make each tree, relative to the same directory. Keep making the rest after an error
+    for (size_t i = 0; i < count; i++)
+        if ( path_create_directories_at(&p_path->allocator, p_path->directory.fd, paths[i]) == 0 ) failed = true;
+
+    // Error check
+    if ( failed ) goto failed_to_create_directory;
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_path:
+                #ifndef NDEBUG
+                    printf("[path] Null pointer provided for parameter \"p_path\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_paths:
+                #ifndef NDEBUG
+                    printf("[path] Null pointer provided for parameter \"paths\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // Path errors
+        {
+            wrong_path_type:
+                #ifndef NDEBUG
+                    printf("[path] Parameter \"p_path\" is not of type directory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // Standard library errors
+        {
+            failed_to_create_directory:
+                #ifndef NDEBUG
+                    printf("[path] Failed to create one or more directories in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+// A file that path_write_atomic_files has written, but not yet renamed into place
+typedef struct
+{
+    int  fd;
+    char temp_name[48]; // Empty for an O_TMPFILE, which has no name until it is linked
+} path_write_file;
+
+// Files are written without a name, where the kernel supports it, so a crash never leaves one behind
+#if defined(__linux__) && !defined(O_TMPFILE) && defined(__O_TMPFILE)
+#define O_TMPFILE __O_TMPFILE
+#endif
+
+int path_write_temp_name ( char *p_temp_name, size_t size )
+{
+
+    // Initialized data
+    static size_t counter = 0;
+
+    // Make a name that no other write in this process, or in any other, is using
+    return snprintf(p_temp_name, size, ".path-write.%ld.%zu", (long) getpid(), __atomic_fetch_add(&counter, 1, __ATOMIC_RELAXED)) < (int) size;
+}
+
+int path_write_open ( int directory_fd, const void *p_buffer, size_t size, path_write_file *p_file )
+{
+
+    // Initialized data
+    const char *p = p_buffer;
+    size_t      written = 0;
+
+    // Clear the file
+    p_file->fd           = -1;
+    p_file->temp_name[0] = '\0';
+
+    // Make a file without a name. Linking it later needs /proc
+    #ifdef O_TMPFILE
+    {
+
+        // Initialized data
+        static int tmpfile_supported = -1;
+        int        supported         = __atomic_load_n(&tmpfile_supported, __ATOMIC_RELAXED);
+
+        // Check for /proc, once
+        if ( supported == -1 )
+        {
+            supported = ( access("/proc/self/fd", X_OK) == 0 );
+            __atomic_store_n(&tmpfile_supported, supported, __ATOMIC_RELAXED);
+        }
+
+        // Open the file. Some file systems don't support O_TMPFILE
+        if ( supported ) p_file->fd = openat(directory_fd, ".", O_TMPFILE | O_WRONLY | O_CLOEXEC, 0666);
+    }
+    #endif
+
+    // Otherwise, make a file with a temporary name
+    if ( p_file->fd == -1 )
+    {
+
+        // Make the name
+        if ( path_write_temp_name(p_file->temp_name, sizeof(p_file->temp_name)) == 0 ) return 0;
+
+        // Open the file
+        p_file->fd = openat(directory_fd, p_file->temp_name, O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC, 0666);
+
+        // Error check
+        if ( p_file->fd == -1 ) return 0;
+    }
+
+    // Write the contents
+    while ( written < size )
+    {
+
+        // Initialized data
+        ssize_t n = write(p_file->fd, p + written, size - written);
+
+        // Error check
+        if ( n == -1 )
+        {
+            if ( errno == EINTR ) continue;
+            goto failed_to_write;
+        }
+
+        // Advance
+        written += (size_t) n;
+    }
+
+    // Success
+    return 1;
+
+    failed_to_write:
+
+    // Clean up
+    if ( p_file->temp_name[0] ) (void) unlinkat(directory_fd, p_file->temp_name, 0);
+    (void) close(p_file->fd);
+    p_file->fd = -1;
+
+    // Error
+    return 0;
+}
+
+int path_write_publish ( int directory_fd, const char *name, path_write_file *p_file )
+{
+
+    // Link a file without a name
+    if ( p_file->temp_name[0] == '\0' )
+    {
+
+        // Initialized data
+        char proc_path[32] = { 0 };
+
+        // The file is linked through its fd in /proc
+        snprintf(proc_path, sizeof(proc_path), "/proc/self/fd/%d", p_file->fd);
+
+        // Nothing has the name yet, so it can be linked into place
+        if ( linkat(AT_FDCWD, proc_path, directory_fd, name, AT_SYMLINK_FOLLOW) == 0 ) return 1;
+
+        // Error check
+        if ( errno != EEXIST ) return 0;
+
+        // Otherwise, link it with a temporary name, and rename it over the old file
+        if ( path_write_temp_name(p_file->temp_name, sizeof(p_file->temp_name)) == 0 ) return 0;
+        if ( linkat(AT_FDCWD, proc_path, directory_fd, p_file->temp_name, AT_SYMLINK_FOLLOW) == -1 ) 
+        {
+            p_file->temp_name[0] = '\0';
+            return 0;
+        }
+    }
+
+    // Rename the file into place. Readers see the old file, or the new one, never a part of either
+    if ( renameat(directory_fd, p_file->temp_name, directory_fd, name) == -1 ) return 0;
+
+    // The temporary name is gone
+    p_file->temp_name[0] = '\0';
+
+    // Success
+    return 1;
+}
+
+int path_write_atomic_files ( path *p_path, const char *const *names, const void *const *buffers, const size_t *sizes, size_t count, int flags )
+{
+
+    // Argument check
+    if ( p_path  == (void *) 0 ) goto no_path;
+    if ( names   == (void *) 0 ) goto no_names;
+    if ( buffers == (void *) 0 ) goto no_buffers;
+    if ( sizes   == (void *) 0 ) goto no_sizes;
+
+    // Initialized data
+    path_write_file files[PATH_WRITE_BATCH_SIZE];
+    bool            failed    = false,
+                    published = false;
+    int             directory_fd;
+
+    // Error checking
+    if ( p_path->type != PATH_TYPE_DIRECTORY ) goto wrong_path_type;
+
+    // Store the directory
+    directory_fd = p_path->directory.fd;
+
+    // Write each batch of files
+    for (size_t base = 0; base < count; base += PATH_WRITE_BATCH_SIZE)
+    {
+
+        // Initialized data
+        size_t batch       = ( count - base < PATH_WRITE_BATCH_SIZE ) ? count - base : PATH_WRITE_BATCH_SIZE;
+        bool   synchronize = !( flags & PATH_WRITE_NO_SYNC );
+
+        // Write each file, with a temporary name, or none. Keep writing the rest
+        for (size_t i = 0; i < batch; i++)
+            if ( path_write_open(directory_fd, buffers[base + i], sizes[base + i], &files[i]) == 0 ) failed = true;
+
+        // Flush every file in the batch with one system call
+        #ifdef SYS_syncfs
+            if ( synchronize && ( flags & PATH_WRITE_SYNCFS ) && syscall(SYS_syncfs, directory_fd) == 0 ) synchronize = false;
+        #endif
+
+        // Otherwise, flush each file. The contents must be durable before they have the name
+        if ( synchronize )
+            for (size_t i = 0; i < batch; i++)
+                if ( files[i].fd != -1 && fdatasync(files[i].fd) == -1 )
+                {
+                    failed = true;
+                    if ( files[i].temp_name[0] ) (void) unlinkat(directory_fd, files[i].temp_name, 0);
+                    (void) close(files[i].fd);
+                    files[i].fd = -1;
+                }
+
+        // Rename each file into place
+        for (size_t i = 0; i < batch; i++)
+        {
+
+            // Skip files that failed
+            if ( files[i].fd == -1 ) continue;
+
+            // Publish the file
+            if ( path_write_publish(directory_fd, names[base + i], &files[i]) ) published = true;
+            else
+            {
+                failed = true;
+                if ( files[i].temp_name[0] ) (void) unlinkat(directory_fd, files[i].temp_name, 0);
+            }
+
+            // Close the file
+            (void) close(files[i].fd);
+        }
+    }
+
+    // Flush the names, once for every file
+    if ( published && !( flags & PATH_WRITE_NO_SYNC ) && fsync(directory_fd) == -1 ) failed = true;
+
+    // Error check
+    if ( failed ) goto failed_to_write_file;
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_path:
+                #ifndef NDEBUG
+                    printf("[path] Null pointer provided for parameter \"p_path\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_names:
+                #ifndef NDEBUG
+                    printf("[path] Null pointer provided for parameter \"names\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_buffers:
+                #ifndef NDEBUG
+                    printf("[path] Null pointer provided for parameter \"buffers\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_sizes:
+                #ifndef NDEBUG
+                    printf("[path] Null pointer provided for parameter \"sizes\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // Path errors
+        {
+            wrong_path_type:
+                #ifndef NDEBUG
+                    printf("[path] Parameter \"p_path\" is not of type directory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // Standard library errors
+        {
+            failed_to_write_file:
+                #ifndef NDEBUG
+                    printf("[path] Failed to write one or more files in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int path_write_atomic ( path *p_path, const char *name, const void *p_buffer, size_t size, int flags )
+{
+
+    // Argument check
+    if ( name                            == (void *) 0 ) goto no_name;
+    if ( p_buffer == (void *) 0 && size  != 0          ) goto no_buffer;
+
+    // Write the file, as a batch of one
+    return path_write_atomic_files(p_path, &name, &p_buffer, &size, 1, flags);
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_name:
+                #ifndef NDEBUG
+                    printf("[path] Null pointer provided for parameter \"name\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_buffer:
+                #ifndef NDEBUG
+                    printf("[path] Null pointer provided for parameter \"p_buffer\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int path_copy_fd ( int source_fd, int destination_fd, unsigned long long size, const path_allocator *const p_allocator )
+{
+
+    // Initialized data
+    unsigned long long  copied   = 0;
+    char               *p_buffer = 0;
+
+    #ifdef __linux__
+
+        // Share the extents of the source, on file systems that support reflinks
+        if ( ioctl(destination_fd, FICLONE, source_fd) == 0 ) return 1;
+
+        // Copy in the kernel, which may offload the copy to the file system or the device
+        while ( copied < size )
+        {
+
+            // Initialized data
+            ssize_t n = (ssize_t) syscall(SYS_copy_file_range, source_fd, 0, destination_fd, 0, (size_t) ( size - copied ), 0);
+
+            // Error check
+            if ( n == -1 && errno == EINTR ) continue;
+
+            // Not supported between these files. Fall back from where the copy stopped
+            if ( n == -1 && ( errno == EXDEV || errno == ENOSYS || errno == EOPNOTSUPP || errno == EINVAL ) ) break;
+
+            // Error check
+            if ( n == -1 ) return 0;
+
+            // The source got shorter
+            if ( n == 0 ) return 1;
+
+            // Advance
+            copied += (unsigned long long) n;
+        }
+
+        // Copy through the page cache, without a user space buffer
+        while ( copied < size )
+        {
+
+            // Initialized data
+            ssize_t n = sendfile(destination_fd, source_fd, 0, (size_t) ( size - copied ));
+
+            // Error check
+            if ( n == -1 && errno == EINTR ) continue;
+
+            // Not supported between these files. Fall back from where the copy stopped
+            if ( n == -1 && ( errno == ENOSYS || errno == EINVAL ) ) break;
+
+            // Error check
+            if ( n == -1 ) return 0;
+
+            // The source got shorter
+            if ( n == 0 ) return 1;
+
+            // Advance
+            copied += (unsigned long long) n;
+        }
+
+        // Done. Files that report a size of 0, like those in /proc, are read until the end
+        if ( size && copied == size ) return 1;
+    #endif
+
+    // Allocate a buffer
+    p_buffer = path_realloc(p_allocator, 0, PATH_COPY_BUFFER_SIZE);
+
+    // Error check
+    if ( p_buffer == (void *) 0 ) goto no_mem;
+
+    // Read and write until the end of the source
+    for (;;)
+    {
+
+        // Initialized data
+        ssize_t n = read(source_fd, p_buffer, PATH_COPY_BUFFER_SIZE);
+
+        // Error check
+        if ( n == -1 && errno == EINTR ) continue;
+        if ( n == -1 ) goto failed_to_copy;
+
+        // End of file
+        if ( n == 0 ) break;
+
+        // Write the data
+        for (ssize_t written = 0; written < n; )
+        {
+
+            // Initialized data
+            ssize_t w = write(destination_fd, p_buffer + written, (size_t) ( n - written ));
+
+            // Error check
+            if ( w == -1 && errno == EINTR ) continue;
+            if ( w == -1 ) goto failed_to_copy;
+
+            // Advance
+            written += w;
+        }
+    }
+
+    // Clean up
+    (void) path_realloc(p_allocator, p_buffer, 0);
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    printf("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            failed_to_copy:
+
+                // Clean up
+                (void) path_realloc(p_allocator, p_buffer, 0);
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int path_copy_file ( const path *const p_source, const char *source_name, const path *const p_destination, const char *destination_name, int flags )
+{
+
+    // Argument check
+    if ( p_source         == (void *) 0 ) goto no_source;
+    if ( source_name      == (void *) 0 ) goto no_source_name;
+    if ( p_destination    == (void *) 0 ) goto no_destination;
+    if ( destination_name == (void *) 0 ) goto no_destination_name;
+
+    // Initialized data
+    struct stat     st             = { 0 },
+                    destination_st = { 0 };
+    path_write_file destination    = { .fd = -1 };
+    int             source_fd      = -1,
+                    destination_fd = -1;
+
+    // Error checking
+    if ( p_source->type      != PATH_TYPE_DIRECTORY ) goto wrong_path_type;
+    if ( p_destination->type != PATH_TYPE_DIRECTORY ) goto wrong_path_type;
+
+    // Open the source, relative to its directory
+    source_fd = openat(p_source->directory.fd, source_name, O_RDONLY | O_CLOEXEC);
+
+    // Error check
+    if ( source_fd == -1 ) goto failed_to_open_source;
+
+    // Only regular files are copied
+    if ( fstat(source_fd, &st) == -1 || S_ISREG(st.st_mode) == 0 ) goto failed_to_open_source;
+
+    // A file can't be copied onto itself, or onto another name for it
+    if ( fstatat(p_destination->directory.fd, destination_name, &destination_st, 0) == 0 && destination_st.st_dev == st.st_dev && destination_st.st_ino == st.st_ino ) goto same_file;
+
+    // Create the copy without a name, or with a temporary one, beside the destination. The destination isn't touched until the copy is done
+    if ( path_write_open(p_destination->directory.fd, 0, 0, &destination) == 0 ) goto failed_to_open_destination;
+    destination_fd = destination.fd;
+
+    // Copy the contents
+    if ( path_copy_fd(source_fd, destination_fd, (unsigned long long) st.st_size, &p_destination->allocator) == 0 ) goto failed_to_copy;
+
+    // Copy the mode, which the umask may have changed, and the timestamps
+    if ( flags & PATH_COPY_PRESERVE )
+    {
+
+        // Initialized data
+        struct timespec times[2] = { st.st_atim, st.st_mtim };
+
+        // Set the mode, and the timestamps
+        if ( fchmod(destination_fd, st.st_mode & 07777) == -1 ) goto failed_to_copy;
+        if ( futimens(destination_fd, times)            == -1 ) goto failed_to_copy;
+    }
+
+    // Replace the destination with the copy
+    if ( path_write_publish(p_destination->directory.fd, destination_name, &destination) == 0 ) goto failed_to_copy;
+
+    // Clean up
+    (void) close(source_fd);
+    (void) close(destination_fd);
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_source:
+                #ifndef NDEBUG
+                    printf("[path] Null pointer provided for parameter \"p_source\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_source_name:
+                #ifndef NDEBUG
+                    printf("[path] Null pointer provided for parameter \"source_name\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_destination:
+                #ifndef NDEBUG
+                    printf("[path] Null pointer provided for parameter \"p_destination\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_destination_name:
+                #ifndef NDEBUG
+                    printf("[path] Null pointer provided for parameter \"destination_name\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // Path errors
+        {
+            wrong_path_type:
+                #ifndef NDEBUG
+                    printf("[path] Parameter \"p_source\" and \"p_destination\" must be of type directory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            same_file:
+                #ifndef NDEBUG
+                    printf("[path] \"%s\" and \"%s\" are the same file in call to function \"%s\"\n", source_name, destination_name, __FUNCTION__);
+                #endif
+
+                // Clean up
+                (void) close(source_fd);
+
+                // Error
+                return 0;
+        }
+
+        // Standard library errors
+        {
+            failed_to_open_source:
+                #ifndef NDEBUG
+                    printf("[path] Failed to open file \"%s\" in call to function \"%s\"\n", source_name, __FUNCTION__);
+                #endif
+
+                // Clean up
+                if ( source_fd != -1 ) (void) close(source_fd);
+
+                // Error
+                return 0;
+
+            failed_to_open_destination:
+                #ifndef NDEBUG
+                    printf("[path] Failed to create file \"%s\" in call to function \"%s\"\n", destination_name, __FUNCTION__);
+                #endif
+
+                // Clean up
+                (void) close(source_fd);
+
+                // Error
+                return 0;
+
+            failed_to_copy:
+                #ifndef NDEBUG
+                    printf("[path] Failed to copy \"%s\" to \"%s\". %s in call to function \"%s\"\n", source_name, destination_name, strerror(errno), __FUNCTION__);
+                #endif
+
+                // Clean up. A partial copy is removed, and the destination is left as it was
+                (void) close(source_fd);
+                if ( destination.temp_name[0] ) (void) unlinkat(p_destination->directory.fd, destination.temp_name, 0);
+                (void) close(destination_fd);
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+bool path_name_is_dot ( const char *path_name )
+{
+
+    // Initialized data
+    size_t end   = strlen(path_name),
+           start = 0;
+
+    // Skip trailing separators
+    while ( end && path_name[end - 1] == '/' ) end--;
+
+    // An empty name is the directory itself
+    if ( end == 0 ) return true;
+
+    // Find the last component
+    start = end;
+    while ( start && path_name[start - 1] != '/' ) start--;
+
+    // Match "." and ".."
+    if ( end - start == 1 && path_name[start] == '.'                              ) return true;
+    if ( end - start == 2 && path_name[start] == '.' && path_name[start + 1] == '.' ) return true;
+
+    // Not a dot
+    return false;
+}
+
+int path_remove_read ( path_worker *p_worker, int directory_fd, path_listing *p_directories, path_remove_context *p_remove )
+{
+
+    // Initialized data
+    path_directory_reader  reader = { 0 };
+    const char            *name   = 0;
+    unsigned char          d_type = 0;
+
+    // Read the directory into this worker's buffer
+    if ( path_directory_reader_open(&reader, directory_fd, &p_worker->p_buffer, &p_worker->buffer_size, 0) == 0 ) return 0;
+
+    // Iterate over each entry
+    while ( path_directory_reader_next(&reader, &name, &d_type) )
+    {
+
+        // Remove anything that isn't a directory now. Unlinking a directory fails with EISDIR
+        if ( d_type != DT_DIR )
+        {
+            if ( unlinkat(directory_fd, name, 0) == 0 ) continue;
+            if ( errno == ENOENT ) continue;
+            if ( errno != EISDIR && errno != EPERM ) 
+            {
+                p_remove->failed = true;
+                continue;
+            }
+        }
+
+        // Remember the directory, to empty it after the reader is done with the buffer
+        if ( path_listing_append(p_directories, name, strlen(name), PATH_TYPE_DIRECTORY) == 0 )
+        {
+            (void) path_directory_reader_close(&reader);
+            return 0;
+        }
+    }
+
+    // Clean up
+    (void) path_directory_reader_close(&reader);
+
+    // Success, if every entry was read
+    return ( reader.failed == false );
+}
+
+int path_remove_serial_open ( path_worker *p_worker, path_remove_frame **pp_frames, size_t *p_depth, size_t *p_max, int parent_fd, const char *name, path_remove_context *p_remove )
+{
+
+    // Initialized data
+    path_remove_frame *p_frame = 0;
+
+    // Grow the stack
+    if ( *p_depth == *p_max )
+    {
+
+        // Initialized data
+        size_t             max      = *p_max ? *p_max * 2 : 16;
+        path_remove_frame *p_frames = PATH_REALLOC(*pp_frames, max * sizeof(path_remove_frame));
+
+        // Error check
+        if ( p_frames == (void *) 0 ) return 0;
+
+        // Store the stack
+        *pp_frames = p_frames;
+        *p_max     = max;
+    }
+
+    // Initialized data
+    p_frame  = &(*pp_frames)[*p_depth];
+    *p_frame = (path_remove_frame) { .fd = openat(parent_fd, name, O_RDONLY | O_DIRECTORY | O_NOFOLLOW | O_CLOEXEC) };
+
+    // Error check
+    if ( p_frame->fd == -1 ) return 0;
+
+    // Remove the files in the directory, and find the directories in it
+    if ( path_remove_read(p_worker, p_frame->fd, &p_frame->directories, p_remove) == 0 )
+    {
+
+        // Clean up
+        (void) close(p_frame->fd);
+        (void) path_listing_destroy(&p_frame->directories);
+
+        // Error
+        return 0;
+    }
+
+    // Push the directory
+    (*p_depth)++;
+
+    // Success
+    return 1;
+}
+
+void path_remove_serial ( path_worker *p_worker, int parent_fd, const char *name, path_remove_context *p_remove )
+{
+
+    // Initialized data
+    path_remove_frame *p_frames = 0;
+    size_t             depth    = 0,
+                       max      = 0;
+
+    // Open the directory
+    if ( path_remove_serial_open(p_worker, &p_frames, &depth, &max, parent_fd, name, p_remove) == 0 ) p_remove->failed = true;
+
+    // Empty each directory, depth first
+    while ( depth )
+    {
+
+        // Initialized data
+        path_remove_frame *p_top = &p_frames[depth - 1];
+
+        // Empty the next directory beneath this one. Its name stays in this frame until the frame is popped
+        if ( p_top->next < p_top->directories.count )
+        {
+
+            // Initialized data
+            const char *child = &p_top->directories.p_names[p_top->directories.p_offsets[p_top->next++]];
+
+            // Open the child. A directory that can't be emptied can't be removed
+            if ( path_remove_serial_open(p_worker, &p_frames, &depth, &max, p_top->fd, child, p_remove) == 0 ) p_remove->failed = true;
+
+            // Next
+            continue;
+        }
+
+        // The directory is empty
+        (void) close(p_top->fd);
+        (void) path_listing_destroy(&p_top->directories);
+        depth--;
+
+        // Remove the directory, relative to its parent
+        if ( depth ) 
+        {
+            path_remove_frame *p_parent = &p_frames[depth - 1];
+            if ( unlinkat(p_parent->fd, &p_parent->directories.p_names[p_parent->directories.p_offsets[p_parent->next - 1]], AT_REMOVEDIR) == -1 && errno != ENOENT ) p_remove->failed = true;
+        }
+        else if ( unlinkat(parent_fd, name, AT_REMOVEDIR) == -1 && errno != ENOENT ) p_remove->failed = true;
+    }
+
+    // Clean up
+    (void) PATH_REALLOC(p_frames, 0);
+}
+
+void path_remove_finish ( path_remove_context *p_remove, path_remove_item *p_item )
+{
+
+    // Walk up the tree while each directory is empty
+    while ( p_item && __atomic_sub_fetch(&p_item->pending, 1, __ATOMIC_ACQ_REL) == 0 )
+    {
+
+        // Initialized data
+        path_remove_item *p_parent = p_item->p_parent;
+
+        // Release the directory
+        if ( p_item->fd != -1 )
+        {
+            (void) close(p_item->fd);
+            __atomic_sub_fetch(&p_remove->open_fds, 1, __ATOMIC_RELAXED);
+        }
+
+        // Remove the directory, relative to its parent, which stays open until this is done
+        if ( unlinkat(p_parent ? p_parent->fd : p_remove->directory_fd, p_item->name, AT_REMOVEDIR) == -1 && errno != ENOENT ) p_remove->failed = true;
+
+        // Free the directory
+        (void) PATH_REALLOC(p_item, 0);
+
+        // Next
+        p_item = p_parent;
+    }
+}
+
+void path_remove_task ( path_worker *p_worker, void *p_argument )
+{
+
+    // Initialized data
+    path_pool           *p_pool      = p_worker->p_pool;
+    path_remove_context *p_remove    = p_pool->p_context;
+    path_remove_item    *p_item      = p_argument;
+    path_listing         directories = { 0 };
+
+    // Open the directory, relative to its parent
+    p_item->fd = openat(p_item->p_parent ? p_item->p_parent->fd : p_remove->directory_fd, p_item->name, O_RDONLY | O_DIRECTORY | O_NOFOLLOW | O_CLOEXEC);
+
+    // Error check
+    if ( p_item->fd == -1 ) goto failed;
+
+    // Count the fd
+    __atomic_add_fetch(&p_remove->open_fds, 1, __ATOMIC_RELAXED);
+
+    // Remove the files in the directory, and find the directories in it
+    if ( path_remove_read(p_worker, p_item->fd, &directories, p_remove) == 0 ) goto failed;
+
+    // Empty each directory
+    for (size_t i = 0; i < directories.count; i++)
+    {
+
+        // Initialized data
+        const char       *name     = &directories.p_names[directories.p_offsets[i]];
+        size_t            name_len = strlen(name);
+        path_remove_item *p_child  = 0;
+
+        // Past the fd budget, empty the directory on this thread, holding one fd per level
+        if ( __atomic_load_n(&p_remove->open_fds, __ATOMIC_RELAXED) >= PATH_REMOVE_FD_BUDGET )
+        {
+            path_remove_serial(p_worker, p_item->fd, name, p_remove);
+            continue;
+        }
+
+        // Allocate memory for the child
+        p_child = PATH_REALLOC(0, sizeof(path_remove_item) + name_len + 1);
+
+        // Error check
+        if ( p_child == (void *) 0 ) goto failed;
+
+        // Populate the child
+        *p_child = (path_remove_item) { .p_parent = p_item, .pending = 1, .fd = -1 };
+        memcpy(p_child->name, name, name_len + 1);
+
+        // The directory isn't empty until the child is removed
+        __atomic_add_fetch(&p_item->pending, 1, __ATOMIC_RELAXED);
+
+        // Queue the child
+        if ( path_pool_push(p_worker, path_remove_task, p_child) == 0 )
+        {
+            __atomic_sub_fetch(&p_item->pending, 1, __ATOMIC_RELAXED);
+            (void) PATH_REALLOC(p_child, 0);
+            goto failed;
+        }
+    }
+
+    done:
+
+    // Clean up
+    (void) path_listing_destroy(&directories);
+
+    // This directory is read
+    path_remove_finish(p_remove, p_item);
+
+    // Done
+    return;
+
+    failed:
+
+    // Keep removing the rest of the tree
+    p_remove->failed = true;
+    goto done;
+}
+
+int path_remove ( path *p_path, const char *path_name )
+{
+
+    // Argument check
+    if ( p_path    == (void *) 0 ) goto no_path;
+    if ( path_name == (void *) 0 ) goto no_path_name;
+
+    // Initialized data
+    path_remove_context  remove   = { 0 };
+    path_remove_item    *p_root   = 0;
+    size_t               name_len = strlen(path_name);
+
+    // Error checking
+    if ( p_path->type != PATH_TYPE_DIRECTORY ) goto wrong_path_type;
+    if ( path_name_is_dot(path_name)         ) goto dot_path_name;
+
+    // Remove anything that isn't a directory
+    if ( unlinkat(p_path->directory.fd, path_name, 0) == 0 ) return 1;
+
+    // Error check
+    if ( errno != EISDIR && errno != EPERM ) goto failed_to_remove;
+
+    // Allocate memory for the root
+    p_root = PATH_REALLOC(0, sizeof(path_remove_item) + name_len + 1);
+
+    // Error check
+    if ( p_root == (void *) 0 ) goto no_mem;
+
+    // Populate the root
+    *p_root = (path_remove_item) { .p_parent = 0, .pending = 1, .fd = -1 };
+    memcpy(p_root->name, path_name, name_len + 1);
+    remove.directory_fd = p_path->directory.fd;
+
+    // Remove the tree
+    if ( path_pool_run(0, path_remove_task, p_root, &remove) == 0 ) goto failed_to_remove;
+
+    // Error check
+    if ( remove.failed ) goto failed_to_remove;
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_path:
+                #ifndef NDEBUG
+                    printf("[path] Null pointer provided for parameter \"p_path\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_path_name:
+                #ifndef NDEBUG
+                    printf("[path] Null pointer provided for parameter \"path_name\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // Path errors
+        {
+            wrong_path_type:
+                #ifndef NDEBUG
+                    printf("[path] Parameter \"p_path\" is not of type directory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            dot_path_name:
+                #ifndef NDEBUG
+                    printf("[path] Refusing to remove \"%s\", which names the directory itself, or its parent, in call to function \"%s\"\n", path_name, __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // Standard library errors
+        {
+            failed_to_remove:
+                #ifndef NDEBUG
+                    printf("[path] Failed to remove \"%s\" in call to function \"%s\"\n", path_name, __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_mem:
+                #ifndef NDEBUG
+                    printf("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int path_directory_filter ( path *p_path, const path_pattern *const p_pattern )
+{
+
+    // Argument check
+    if ( p_path == (void *) 0 ) goto no_path;
+
+    // Store the pattern
+    p_path->p_pattern = p_pattern;
+
+    // Listings read with another pattern are no good
+    if ( path_directory_listing_clear(p_path) == 0 ) goto failed_to_clear_listing;
+    (void) path_listing_cache_clear(p_path);
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_path:
+                #ifndef NDEBUG
+                    printf("[path] Null pointer provided for parameter \"p_path\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // path errors
+        {
+            failed_to_clear_listing:
+                #ifndef NDEBUG
+                    printf("[path] Failed to clear directory listing in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+size_t path_directory_content_names ( const path *const p_path, const char **const names )
+{
+
+    // List the directory
+    if ( path_directory_materialize(p_path) == 0 ) return 0;
+
+    // Return the quantity of contents
+    if ( names == (void *) 0 ) return p_path->data.listing.count;
+
+    // Point at each name, in sorted order
+    for (size_t i = 0; i < p_path->data.listing.count; i++) names[i] = &p_path->data.listing.p_names[p_path->data.listing.p_offsets[i]];
+
+    // Success
+    return 1;
+}
+
+int path_directory_foreach_i ( const path *const p_path, void (*pfn_path_iter)(const char *full_path, path_type type, size_t i))
+{
+
+    // Argument check
+    if ( p_path        == (void *) 0 ) goto no_path;
+    if ( pfn_path_iter == (void *) 0 ) goto no_path_iter;
+
+    // Initialized data
+    const path_listing *p_listing = &p_path->data.listing;
+
+    // Error checking
+    if ( p_path->type != PATH_TYPE_DIRECTORY ) goto path_is_not_a_directory;
+
+    // List the directory
+    if ( path_directory_materialize(p_path) == 0 ) goto failed_to_list_directory;
+
+    // Iterate over each path in the directory
+    for (size_t i = 0; i < p_listing->count; i++)
+
+        // Call the function
+        pfn_path_iter(&p_listing->p_names[p_listing->p_offsets[i]], (path_type) p_listing->p_types[i], i);
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+        
+        // Argument errors
+        {
+            no_path:
+                #ifndef NDEBUG
+                    printf("[path] Null pointer provided for parameter \"p_path\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+                    
+            no_path_iter:
+                #ifndef NDEBUG
+                    printf("[path] Null pointer provided for parameter \"pfn_path_iter\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+                
+        }
+
+        // path errors
+        {
+            path_is_not_a_directory:
+                #ifndef NDEBUG
+                    printf("[path] Parameter \"p_path\" is not of type directory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+            
+            failed_to_list_directory:
+                #ifndef NDEBUG
+                    printf("[path] Failed to list directory contents in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int path_directory_foreach ( const path *const p_path, fn_path_foreach pfn_foreach, void *p_context )
+{
+
+    // Every entry
+    return path_directory_foreach_match(p_path, 0, pfn_foreach, p_context);
+}
+
+int path_directory_foreach_match ( const path *const p_path, const path_pattern *const p_pattern, fn_path_foreach pfn_foreach, void *p_context )
+{
+
+    // Argument check
+    if ( p_path      == (void *) 0 ) goto no_path;
+    if ( pfn_foreach == (void *) 0 ) goto no_foreach;
+
+    // Initialized data
+    const path_listing *p_listing = &p_path->data.listing;
+    path_entry          entry     = { 0 };
+
+    // Error checking
+    if ( p_path->type != PATH_TYPE_DIRECTORY ) goto path_is_not_a_directory;
+
+    // List the directory
+    if ( path_directory_materialize(p_path) == 0 ) goto failed_to_list_directory;
+
+    // Iterate over each entry. The columns are read again on each step, in case the callback relists the directory
+    for (size_t i = 0; i < p_listing->count; i++)
+    {
+
+        // Skip names that don't match
+        if ( p_pattern && path_pattern_match(p_pattern, &p_listing->p_names[p_listing->p_offsets[i]]) == false ) continue;
+
+        // Populate the entry
+        entry.name       = &p_listing->p_names[p_listing->p_offsets[i]];
+        entry.type       = (path_type) p_listing->p_types[i];
+        entry.index      = i;
+        entry.p_metadata = ( p_listing->p_metadata && p_listing->p_metadata[i].type ) ? &p_listing->p_metadata[i] : 0;
+
+        // Call the function, and stop early if asked
+        if ( pfn_foreach(&entry, p_context) == 0 ) break;
+    }
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+        
+        // Argument errors
+        {
+            no_path:
+                #ifndef NDEBUG
+                    printf("[path] Null pointer provided for parameter \"p_path\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+                    
+            no_foreach:
+                #ifndef NDEBUG
+                    printf("[path] Null pointer provided for parameter \"pfn_foreach\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // path errors
+        {
+            path_is_not_a_directory:
+                #ifndef NDEBUG
+                    printf("[path] Parameter \"p_path\" is not of type directory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+            
+            failed_to_list_directory:
+                #ifndef NDEBUG
+                    printf("[path] Failed to list directory contents in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int path_dir_cursor_open ( path_dir_cursor **pp_cursor, const path *const p_path )
+{
+
+    // Argument check
+    if ( pp_cursor == (void *) 0 ) goto no_cursor;
+    if ( p_path    == (void *) 0 ) goto no_path;
+
+    // Initialized data
+    path_dir_cursor *p_cursor = 0;
+
+    // Error checking
+    if ( p_path->type != PATH_TYPE_DIRECTORY ) goto path_is_not_a_directory;
+
+    // Allocate memory for the cursor
+    p_cursor = path_realloc(&p_path->allocator, 0, sizeof(path_dir_cursor));
+
+    // Error check
+    if ( p_cursor == (void *) 0 ) goto no_mem;
+
+    // Zero set
+    memset(p_cursor, 0, sizeof(path_dir_cursor));
+
+    // Use the allocator of the path
+    p_cursor->allocator = p_path->allocator;
+    p_cursor->p_pattern = p_path->p_pattern;
+
+    // Allocate memory for the buffer
+    p_cursor->p_buffer    = path_realloc(&p_cursor->allocator, 0, PATH_CURSOR_BUFFER_SIZE);
+    p_cursor->buffer_size = PATH_CURSOR_BUFFER_SIZE;
+
+    // Error check
+    if ( p_cursor->p_buffer == (void *) 0 ) goto no_mem;
+
+    // Open the directory again, so the cursor has its own offset
+    p_cursor->fd = openat(p_path->directory.fd, ".", O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+
+    // Error check
+    if ( p_cursor->fd == -1 ) goto failed_to_open_directory;
+
+    // Start reading
+    if ( path_directory_reader_open(&p_cursor->reader, p_cursor->fd, &p_cursor->p_buffer, &p_cursor->buffer_size, &p_cursor->allocator) == 0 ) goto failed_to_open_directory;
+
+    // Return a pointer to the caller
+    *pp_cursor = p_cursor;
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_cursor:
+                #ifndef NDEBUG
+                    printf("[path] Null pointer provided for parameter \"pp_cursor\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_path:
+                #ifndef NDEBUG
+                    printf("[path] Null pointer provided for parameter \"p_path\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // path errors
+        {
+            path_is_not_a_directory:
+                #ifndef NDEBUG
+                    printf("[path] Parameter \"p_path\" is not of type directory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // Standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    printf("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Clean up
+                if ( p_cursor ) (void) path_realloc(&p_path->allocator, p_cursor, 0);
+
+                // Error
+                return 0;
+
+            failed_to_open_directory:
+                #ifndef NDEBUG
+                    printf("[Standard Library] Failed to open directory \"%s\" in call to function \"%s\"\n", p_path->full_path.text, __FUNCTION__);
+                #endif
+
+                // Clean up
+                if ( p_cursor->fd != -1 ) (void) close(p_cursor->fd);
+                (void) path_realloc(&p_path->allocator, p_cursor->p_buffer, 0);
+                (void) path_realloc(&p_path->allocator, p_cursor, 0);
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int path_dir_cursor_next ( path_dir_cursor *p_cursor, const char **pp_name, path_type *p_type )
+{
+
+    // Argument check
+    if ( p_cursor == (void *) 0 ) goto no_cursor;
+    if ( pp_name  == (void *) 0 ) goto no_name;
+
+    // Initialized data
+    unsigned char d_type = DT_UNKNOWN;
+
+    // Read the next entry that matches the pattern of the path
+    do if ( path_directory_reader_next(&p_cursor->reader, pp_name, &d_type) == 0 ) return 0;
+    while ( p_cursor->p_pattern && path_pattern_match(p_cursor->p_pattern, *pp_name) == false );
+
+    // Type the entry
+    if ( p_type ) *p_type = path_directory_entry_type(p_cursor->fd, *pp_name, d_type);
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_cursor:
+                #ifndef NDEBUG
+                    printf("[path] Null pointer provided for parameter \"p_cursor\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_name:
+                #ifndef NDEBUG
+                    printf("[path] Null pointer provided for parameter \"pp_name\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int path_dir_cursor_close ( path_dir_cursor **pp_cursor )
+{
+
+    // Argument check
+    if ( pp_cursor == (void *) 0 ) goto no_cursor;
+
+    // Initialized data
+    path_dir_cursor *p_cursor = *pp_cursor;
+
+    // Error check
+    if ( p_cursor == (void *) 0 ) goto pointer_to_null_pointer;
+
+    // No more pointer for caller
+    *pp_cursor = 0;
+
+    // Stop reading
+    (void) path_directory_reader_close(&p_cursor->reader);
+
+    // Close the directory
+    (void) close(p_cursor->fd);
+
+    // Free the buffer
+    (void) path_realloc(&p_cursor->allocator, p_cursor->p_buffer, 0);
+
+    // Free the cursor
+    (void) path_realloc(&p_cursor->allocator, p_cursor, 0);
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_cursor:
+                #ifndef NDEBUG
+                    printf("[path] Null pointer provided for parameter \"pp_cursor\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            pointer_to_null_pointer:
+                #ifndef NDEBUG
+                    printf("[path] Parameter \"pp_cursor\" points to null pointer in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+path_walk_item *path_walk_item_create ( path_walk_item *p_parent, const char *full_path )
+{
+
+    // Initialized data
+    size_t          full_path_len = strlen(full_path);
+    path_walk_item *p_item        = PATH_REALLOC(0, sizeof(path_walk_item) + full_path_len + 1);
+
+    // Error check
+    if ( p_item == (void *) 0 ) return 0;
+
+    // Populate the item. The name follows the last '/' of the full path
+    *p_item = (path_walk_item)
+    {
+        .p_parent    = p_parent,
+        .pending     = 1,
+        .depth       = p_parent ? p_parent->depth + 1 : 0,
+        .name_offset = p_parent ? strlen(p_parent->full_path) + 1 : 0,
+        .fd          = -1
+    };
+    memcpy(p_item->full_path, full_path, full_path_len + 1);
+
+    // The parent stays open until the child has opened itself
+    if ( p_parent ) __atomic_add_fetch(&p_parent->pending, 1, __ATOMIC_RELAXED);
+
+    // Success
+    return p_item;
+}
+
+void path_walk_item_release ( path_walk_item *p_item )
+{
+
+    // Walk up the tree while nothing needs each directory
+    while ( p_item && __atomic_sub_fetch(&p_item->pending, 1, __ATOMIC_ACQ_REL) == 0 )
+    {
+
+        // Initialized data
+        path_walk_item *p_parent = p_item->p_parent;
+
+        // Close the directory, and free it
+        if ( p_item->fd != -1 ) (void) close(p_item->fd);
+        (void) PATH_REALLOC(p_item, 0);
+
+        // Next
+        p_item = p_parent;
+    }
+}
+
+int path_walk_item_open ( path_walk_item *p_item )
+{
+
+    // Open the directory, relative to its parent, so the full path isn't resolved again
+    if ( p_item->p_parent ) p_item->fd = openat(p_item->p_parent->fd, &p_item->full_path[p_item->name_offset], O_RDONLY | O_DIRECTORY | O_NOFOLLOW | O_CLOEXEC);
+    else                    p_item->fd = open(p_item->full_path, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+
+    // The parent is no longer needed
+    path_walk_item_release(p_item->p_parent);
+    p_item->p_parent = 0;
+
+    // Done
+    return ( p_item->fd != -1 );
+}
+
+void path_walk_task ( path_worker *p_worker, void *p_argument )
+{
+
+    // Initialized data
+    path_pool             *p_pool       = p_worker->p_pool;
+    path_walk_context     *p_walk       = p_pool->p_context;
+    path_walk_item        *p_item       = p_argument;
+    path_directory_reader  reader       = { 0 };
+    int                    directory_fd = -1;
+    const char            *name         = 0;
+    unsigned char          d_type       = 0;
+
+    // Don't start new work after the walk is stopped
+    if ( __atomic_load_n(&p_pool->abort, __ATOMIC_ACQUIRE) ) goto done;
+
+    // Open the directory. Unreadable directories are skipped
+    if ( path_walk_item_open(p_item) == 0 ) goto done;
+
+    // Store the directory
+    directory_fd = p_item->fd;
+
+    // Read the directory into this worker's buffer
+    if ( path_directory_reader_open(&reader, directory_fd, &p_worker->p_buffer, &p_worker->buffer_size, 0) == 0 ) goto done;
+
+    // Iterate over each entry
+    while ( path_directory_reader_next(&reader, &name, &d_type) )
+    {
+
+        // Initialized data
+        path_type        type    = PATH_TYPE_FILE;
+        bool             is_link = ( d_type == DT_LNK );
+        path_walk_result result  = PATH_WALK_CONTINUE;
+
+        // Stop early
+        if ( __atomic_load_n(&p_pool->abort, __ATOMIC_RELAXED) ) break;
+
+        // Make the full path of the entry
+        if ( path_worker_text(p_worker, p_item->full_path, name) == 0 ) goto no_mem;
+
+        // The file system didn't report the type, so find out if it is a link
+        if ( d_type == DT_UNKNOWN )
+        {
+
+            // Initialized data
+            struct stat st = { 0 };
+
+            // Skip entries that disappear
+            if ( fstatat(directory_fd, name, &st, AT_SYMLINK_NOFOLLOW) == -1 ) continue;
+
+            // Store the type
+            if ( S_ISLNK(st.st_mode) ) is_link = true;
+            else                        type    = path_type_from_mode(st.st_mode);
+        }
+        else
+            type = path_directory_entry_type(directory_fd, name, d_type);
+
+        // Report the type of the link target
+        if ( is_link ) type = path_directory_entry_type(directory_fd, name, DT_LNK);
+
+        // Call the function
+        result = p_walk->pfn_walk(p_worker->p_text, type, p_item->depth + 1, p_walk->p_context);
+
+        // Stop the walk
+        if ( result == PATH_WALK_STOP ) 
+        {
+
+            // Signal every worker
+            __atomic_store_n(&p_pool->abort, true, __ATOMIC_RELEASE);
+
+            // Done
+            break;
+        }
+
+        // Descend into the directory, unless it is a link or the callback skipped it
+        if ( type == PATH_TYPE_DIRECTORY && is_link == false && result != PATH_WALK_SKIP )
+        {
+
+            // Initialized data
+            path_walk_item *p_child = path_walk_item_create(p_item, p_worker->p_text);
+
+            // Error check
+            if ( p_child == (void *) 0 ) goto no_mem;
+
+            // Queue the child
+            if ( path_pool_push(p_worker, path_walk_task, p_child) == 0 )
+            {
+
+                // Clean up
+                (void) __atomic_sub_fetch(&p_item->pending, 1, __ATOMIC_RELAXED);
+                (void) PATH_REALLOC(p_child, 0);
+
+                // Error
+                goto no_mem;
+            }
+        }
+    }
+
+    // Clean up
+    (void) path_directory_reader_close(&reader);
+
+    done:
+
+    // Release the directory. It is closed once each child has opened itself
+    path_walk_item_release(p_item);
+
+    // Done
+    return;
+
+    // Error handling
+    {
+
+        // Standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    printf("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Stop the walk
+                path_pool_fail(p_pool);
+
+                // Clean up
+                (void) path_directory_reader_close(&reader);
+                path_walk_item_release(p_item);
+
+                // Error
+                return;
+        }
+    }
+}
+
+int path_walk ( const path *const p_path, size_t thread_count, fn_path_walk pfn_walk, void *p_context )
+{
+
+    // Argument check
+    if ( p_path   == (void *) 0 ) goto no_path;
+    if ( pfn_walk == (void *) 0 ) goto no_walk;
+
+    // Initialized data
+    path_walk_context  walk   = { .pfn_walk = pfn_walk, .p_context = p_context };
+    path_walk_item    *p_root = 0;
+
+    // Error checking
+    if ( p_path->type != PATH_TYPE_DIRECTORY ) goto path_is_not_a_directory;
+
+    // Make the root
+    p_root = path_walk_item_create(0, p_path->full_path.text);
+
+    // Error check
+    if ( p_root == (void *) 0 ) goto no_mem;
+
+    // Walk the tree
+    if ( path_pool_run(thread_count, path_walk_task, p_root, &walk) == 0 ) goto failed_to_walk;
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+        
+        // Argument errors
+        {
+            no_path:
+                #ifndef NDEBUG
+                    printf("[path] Null pointer provided for parameter \"p_path\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+                    
+            no_walk:
+                #ifndef NDEBUG
+                    printf("[path] Null pointer provided for parameter \"pfn_walk\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // path errors
+        {
+            path_is_not_a_directory:
+                #ifndef NDEBUG
+                    printf("[path] Parameter \"p_path\" is not of type directory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            failed_to_walk:
+                #ifndef NDEBUG
+                    printf("[path] Failed to walk directory tree in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // Standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    printf("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int path_glob_text_push ( path_glob_context *p_glob, const char *name )
+{
+
+    // Initialized data
+    size_t name_len = strlen(name),
+           required = p_glob->text_len + 1 + name_len + 1;
+
+    // Grow the text
+    if ( required > p_glob->text_max )
+    {
+
+        // Initialized data
+        size_t  text_max = p_glob->text_max ? p_glob->text_max : 256;
+        char   *p_text   = 0;
+
+        // Grow geometrically
+        while ( text_max < required ) text_max *= 2;
+
+        // Reallocate
+        p_text = path_realloc(&p_glob->allocator, p_glob->p_text, text_max);
+
+        // Error check
+        if ( p_text == (void *) 0 ) return 0;
+
+        // Store the text
+        p_glob->p_text   = p_text;
+        p_glob->text_max = text_max;
+    }
+
+    // Append a separator, and the name
+    if ( p_glob->text_len && p_glob->p_text[p_glob->text_len - 1] != '/' ) p_glob->p_text[p_glob->text_len++] = '/';
+    memcpy(&p_glob->p_text[p_glob->text_len], name, name_len + 1);
+    p_glob->text_len += name_len;
+
+    // Success
+    return 1;
+}
+
+int path_glob_directory ( path_glob_context *p_glob, int directory_fd, unsigned long long states, size_t depth )
+{
+
+    // Initialized data
+    path_directory_reader  reader     = { 0 };
+    size_t                 text_len   = p_glob->text_len;
+    const char            *name       = 0;
+    unsigned char          d_type     = 0;
+    unsigned long long     closure    = 0;
+    size_t                 last       = p_glob->component_count - 1;
+
+    // A globstar also matches no directories, so the component after it is active here too
+    for (size_t k = 0; k < p_glob->component_count; k++)
+    {
+        if ( ( states & ( 1ULL << k ) ) == 0 ) continue;
+        closure |= 1ULL << k;
+        if ( p_glob->components[k].kind == PATH_GLOB_GLOBSTAR && k < last ) states |= 1ULL << ( k + 1 );
+    }
+
+    // A single literal component is opened directly, without reading the directory
+    if ( ( closure & ( closure - 1 ) ) == 0 && p_glob->components[__builtin_ctzll(closure)].kind == PATH_GLOB_LITERAL )
+    {
+
+        // Initialized data
+        size_t       k       = (size_t) __builtin_ctzll(closure);
+        const char  *literal = p_glob->components[k].literal;
+        struct stat  st      = { 0 };
+
+        // The last component names the result
+        if ( k == last )
+        {
+
+            // The entry must exist
+            if ( fstatat(directory_fd, literal, &st, AT_SYMLINK_NOFOLLOW) == -1 ) return 1;
+
+            // Make the full path
+            if ( path_glob_text_push(p_glob, literal) == 0 ) goto no_mem;
+
+            // Call the function
+            if ( p_glob->pfn_glob(p_glob->p_text, path_directory_entry_type(directory_fd, literal, DT_UNKNOWN), depth + 1, p_glob->p_context) == PATH_WALK_STOP ) p_glob->stop = true;
+        }
+
+        // Descend into the named directory
+        else
+        {
+
+            // Initialized data
+            int fd = openat(directory_fd, literal, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+
+            // The directory must exist
+            if ( fd == -1 ) return 1;
+
+            // Make the full path
+            if ( path_glob_text_push(p_glob, literal) == 0 ) { (void) close(fd); goto no_mem; }
+
+            // Descend
+            (void) path_glob_directory(p_glob, fd, 1ULL << ( k + 1 ), depth + 1);
+
+            // Clean up
+            (void) close(fd);
+        }
+
+        // Restore the full path
+        p_glob->text_len         = text_len;
+        p_glob->p_text[text_len] = '\0';
+
+        // Done
+        return !p_glob->failed;
+    }
+
+    // Add buffers up to this depth. Literal components skip levels
+    while ( depth >= p_glob->level_count )
+    {
+
+        // Initialized data
+        size_t  level    = p_glob->level_count;
+        void   *p_levels = path_realloc(&p_glob->allocator, p_glob->p_levels, ( level + 1 ) * sizeof(*p_glob->p_levels));
+
+        // Error check
+        if ( p_levels == (void *) 0 ) goto no_mem;
+
+        // Store the levels
+        p_glob->p_levels = p_levels;
+        p_glob->p_levels[level].p_buffer    = path_realloc(&p_glob->allocator, 0, PATH_CURSOR_BUFFER_SIZE);
+        p_glob->p_levels[level].buffer_size = PATH_CURSOR_BUFFER_SIZE;
+
+        // Error check
+        if ( p_glob->p_levels[level].p_buffer == (void *) 0 ) goto no_mem;
+
+        // Store the quantity of levels
+        p_glob->level_count++;
+    }
+
+    // Read the directory. Unreadable directories are skipped
+    if ( path_directory_reader_open(&reader, directory_fd, &p_glob->p_levels[depth].p_buffer, &p_glob->p_levels[depth].buffer_size, &p_glob->allocator) == 0 ) return 1;
+
+    // Iterate over each entry
+    while ( p_glob->stop == false && path_directory_reader_next(&reader, &name, &d_type) )
+    {
+
+        // Initialized data
+        unsigned long long child   = 0,
+                           links   = 0;
+        bool               report  = false,
+                           is_link = ( d_type == DT_LNK );
+        path_type          type    = PATH_TYPE_FILE;
+        path_walk_result   result  = PATH_WALK_CONTINUE;
+
+        // Match the entry against each active component
+        for (size_t k = 0; k < p_glob->component_count; k++)
+        {
+
+            // Initialized data
+            const path_glob_component *p_component = &p_glob->components[k];
+
+            // Inactive
+            if ( ( closure & ( 1ULL << k ) ) == 0 ) continue;
+
+            // A globstar stays active beneath every visible directory, but never through links
+            if ( p_component->kind == PATH_GLOB_GLOBSTAR )
+            {
+                if ( name[0] == '.' ) continue;
+                child |= 1ULL << k;
+                if ( k == last ) report = true;
+                continue;
+            }
+
+            // Match the name
+            if ( p_component->kind == PATH_GLOB_LITERAL && strcmp(name, p_component->literal) != 0 ) continue;
+            if ( p_component->kind == PATH_GLOB_PATTERN && path_pattern_match(p_component->p_pattern, name) == false ) continue;
+
+            // The whole glob matched, or the next component is matched beneath the entry
+            if ( k == last ) report = true;
+            else 
+            {
+                child |= 1ULL << ( k + 1 );
+                links |= 1ULL << ( k + 1 );
+            }
+        }
+
+        // Nothing to do with the entry, so it is never stat'd
+        if ( report == false && child == 0 ) continue;
+
+        // The file system didn't report the type, so find out if it is a link
+        if ( d_type == DT_UNKNOWN )
+        {
+
+            // Initialized data
+            struct stat st = { 0 };
+
+            // Skip entries that disappear
+            if ( fstatat(directory_fd, name, &st, AT_SYMLINK_NOFOLLOW) == -1 ) continue;
+
+            // Store the type
+            if ( S_ISLNK(st.st_mode) ) is_link = true;
+            else                        type    = path_type_from_mode(st.st_mode);
+        }
+        else
+            type = path_directory_entry_type(directory_fd, name, d_type);
+
+        // Report the type of the link target
+        if ( is_link ) 
+        {
+            type   = path_directory_entry_type(directory_fd, name, DT_LNK);
+            child &= links;
+        }
+
+        // Make the full path of the entry
+        if ( path_glob_text_push(p_glob, name) == 0 ) 
+        {
+
+            // Clean up
+            (void) path_directory_reader_close(&reader);
+
+            // Error
+            goto no_mem;
+        }
+
+        // Call the function
+        if ( report ) result = p_glob->pfn_glob(p_glob->p_text, type, depth + 1, p_glob->p_context);
+
+        // Stop the glob
+        if ( result == PATH_WALK_STOP ) p_glob->stop = true;
+
+        // Descend into the directory, unless the callback skipped it
+        else if ( child && type == PATH_TYPE_DIRECTORY && result != PATH_WALK_SKIP )
+        {
+
+            // Initialized data
+            int fd = openat(directory_fd, name, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+
+            // Unreadable directories are skipped
+            if ( fd != -1 )
+            {
+
+                // Descend
+                (void) path_glob_directory(p_glob, fd, child, depth + 1);
+
+                // Clean up
+                (void) close(fd);
+            }
+        }
+
+        // Restore the full path
+        p_glob->text_len         = text_len;
+        p_glob->p_text[text_len] = '\0';
+    }
+
+    // A directory that stopped short may have hidden matches
+    if ( reader.failed ) p_glob->failed = true;
+
+    // Clean up
+    (void) path_directory_reader_close(&reader);
+
+    // Done
+    return !p_glob->failed;
+
+    // Error handling
+    {
+
+        // Standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    printf("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Stop the glob
+                p_glob->stop   = true;
+                p_glob->failed = true;
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int path_glob ( const path *const p_path, const char *pattern_text, fn_path_walk pfn_glob, void *p_context )
+{
+
+    // Argument check
+    if ( p_path       == (void *) 0 ) goto no_path;
+    if ( pattern_text == (void *) 0 ) goto no_pattern_text;
+    if ( pfn_glob     == (void *) 0 ) goto no_glob;
+
+    // Initialized data
+    path_glob_context  glob         = { .pfn_glob = pfn_glob, .p_context = p_context, .allocator = p_path->allocator };
+    int                directory_fd = -1;
+    bool               result       = false;
+
+    // Error checking
+    if ( p_path->type != PATH_TYPE_DIRECTORY ) goto path_is_not_a_directory;
+
+    // Split the pattern into components
+    for (const char *p_start = pattern_text; *p_start; )
+    {
+
+        // Initialized data
+        size_t               length      = strcspn(p_start, "/");
+        path_glob_component *p_component = &glob.components[glob.component_count];
+        char                *text        = 0;
+
+        // Skip empty components, and "."
+        if ( length == 0 || ( length == 1 && p_start[0] == '.' ) ) goto next;
+
+        // Runs of globstars are one globstar
+        if ( length == 2 && p_start[0] == '*' && p_start[1] == '*' )
+        {
+            if ( glob.component_count && glob.components[glob.component_count - 1].kind == PATH_GLOB_GLOBSTAR ) goto next;
+            if ( glob.component_count == PATH_GLOB_MAX_COMPONENTS ) goto too_many_components;
+            p_component->kind = PATH_GLOB_GLOBSTAR;
+            glob.component_count++;
+            goto next;
+        }
+
+        // Error check
+        if ( glob.component_count == PATH_GLOB_MAX_COMPONENTS ) goto too_many_components;
+
+        // Copy the component
+        text = path_realloc(&glob.allocator, 0, length + 1);
+        if ( text == (void *) 0 ) goto no_mem;
+        memcpy(text, p_start, length);
+        text[length] = '\0';
+
+        // A literal name
+        if ( strpbrk(text, "*?[{\\") == (void *) 0 )
+        {
+            p_component->kind    = PATH_GLOB_LITERAL;
+            p_component->literal = text;
+        }
+
+        // A pattern
+        else
+        {
+
+            // Compile the pattern
+            p_component->kind = PATH_GLOB_PATTERN;
+            result = path_pattern_compile(&p_component->p_pattern, text);
+            (void) path_realloc(&glob.allocator, text, 0);
+
+            // Error check
+            if ( result == false ) goto failed_to_compile;
+        }
+
+        // Store the component
+        glob.component_count++;
+
+        next:
+
+        // Next component
+        p_start += length;
+        if ( *p_start == '/' ) p_start++;
+    }
+
+    // An empty glob matches nothing
+    if ( glob.component_count == 0 ) goto done;
+
+    // Open the root. The glob has its own descriptor, so the offset of the path is untouched
+    directory_fd = openat(p_path->directory.fd, ".", O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+
+    // Error check
+    if ( directory_fd == -1 ) goto failed_to_open_directory;
+
+    // Start from the full path of the root
+    if ( path_glob_text_push(&glob, p_path->full_path.text) == 0 ) goto no_mem;
+
+    // Match the first component against the root
+    (void) path_glob_directory(&glob, directory_fd, 1, 0);
+
+    done:
+
+    // Clean up
+    if ( directory_fd != -1 ) (void) close(directory_fd);
+    for (size_t i = 0; i < glob.component_count; i++)
+    {
+        if ( glob.components[i].literal   ) (void) path_realloc(&glob.allocator, glob.components[i].literal, 0);
+        if ( glob.components[i].p_pattern ) (void) path_pattern_destroy(&glob.components[i].p_pattern);
+    }
+    for (size_t i = 0; i < glob.level_count; i++) (void) path_realloc(&glob.allocator, glob.p_levels[i].p_buffer, 0);
+    if ( glob.p_levels ) (void) path_realloc(&glob.allocator, glob.p_levels, 0);
+    if ( glob.p_text   ) (void) path_realloc(&glob.allocator, glob.p_text, 0);
+
+    // Done
+    return !glob.failed;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_path:
+                #ifndef NDEBUG
+                    printf("[path] Null pointer provided for parameter \"p_path\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_pattern_text:
+                #ifndef NDEBUG
+                    printf("[path] Null pointer provided for parameter \"pattern_text\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_glob:
+                #ifndef NDEBUG
+                    printf("[path] Null pointer provided for parameter \"pfn_glob\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // path errors
+        {
+            path_is_not_a_directory:
+                #ifndef NDEBUG
+                    printf("[path] Parameter \"p_path\" is not of type directory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            too_many_components:
+                #ifndef NDEBUG
+                    printf("[path] Pattern \"%s\" has more than %d components in call to function \"%s\"\n", pattern_text, PATH_GLOB_MAX_COMPONENTS, __FUNCTION__);
+                #endif
+
+                // Clean up
+                glob.failed = true;
+                goto done;
+
+            failed_to_compile:
+                #ifndef NDEBUG
+                    printf("[path] Failed to compile pattern \"%s\" in call to function \"%s\"\n", pattern_text, __FUNCTION__);
+                #endif
+
+                // Clean up
+                glob.failed = true;
+                goto done;
+
+            failed_to_open_directory:
+                #ifndef NDEBUG
+                    printf("[path] Failed to open directory \"%s\" in call to function \"%s\"\n", p_path->full_path.text, __FUNCTION__);
+                #endif
+
+                // Clean up
+                glob.failed = true;
+                goto done;
+        }
+
+        // Standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    printf("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Clean up
+                glob.failed = true;
+                goto done;
+        }
+    }
+}
+
+unsigned long long path_inode_hash ( unsigned long long device, unsigned long long inode )
+{
+
+    // Initialized data
+    unsigned long long hash = ( device * 0x9E3779B97F4A7C15ULL ) ^ inode;
+
+    // Mix the bits
+    hash ^= hash >> 31;
+    hash *= 0xBF58476D1CE4E5B9ULL;
+    hash ^= hash >> 27;
+
+    // Done
+    return hash;
+}
+
+int path_inode_set_create ( path_inode_set *p_set )
+{
+
+    // Zero set
+    memset(p_set, 0, sizeof(path_inode_set));
+
+    // Construct a lock for each shard
+    for (size_t i = 0; i < PATH_INODE_SET_SHARDS; i++)
+        if ( mutex_create(&p_set->shards[i]._lock) == 0 )
+        {
+
+            // Clean up
+            while ( i-- ) mutex_destroy(&p_set->shards[i]._lock);
+
+            // Error
+            goto failed_to_create_mutex;
+        }
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // sync errors
+        {
+            failed_to_create_mutex:
+                #ifndef NDEBUG
+                    printf("[sync] Failed to create mutex in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+bool path_inode_set_insert ( path_inode_set *p_set, unsigned long long device, unsigned long long inode )
+{
+
+    // Initialized data
+    unsigned long long  hash     = path_inode_hash(device, inode);
+    path_inode_shard   *p_shard  = &p_set->shards[hash & ( PATH_INODE_SET_SHARDS - 1 )];
+    bool                inserted = true;
+
+    // Lock
+    mutex_lock(&p_shard->_lock);
+
+    // Grow the shard when it is half full
+    if ( 2 * ( p_shard->count + 1 ) > p_shard->capacity )
+    {
+
+        // Initialized data
+        size_t              capacity = p_shard->capacity ? p_shard->capacity * 2 : 64;
+        unsigned long long *p_keys   = PATH_REALLOC(0, 2 * capacity * sizeof(unsigned long long));
+
+        // Error check. An inode that can't be remembered is counted
+        if ( p_keys == (void *) 0 ) goto no_mem;
+
+        // Zero set
+        memset(p_keys, 0, 2 * capacity * sizeof(unsigned long long));
+
+        // Move each key
+        for (size_t i = 0; i < p_shard->capacity; i++)
+        {
+
+            // Initialized data
+            unsigned long long i_device = p_shard->p_keys[2 * i],
+                               i_inode  = p_shard->p_keys[2 * i + 1];
+            size_t             j        = 0;
+
+            // Empty slot
+            if ( i_inode == 0 ) continue;
+
+            // Probe for a free slot
+            for (j = ( path_inode_hash(i_device, i_inode) >> 6 ) & ( capacity - 1 ); p_keys[2 * j + 1]; j = ( j + 1 ) & ( capacity - 1 ));
+
+            // Store the key
+            p_keys[2 * j]     = i_device;
+            p_keys[2 * j + 1] = i_inode;
+        }
+
+        // Replace the keys
+        if ( p_shard->p_keys ) (void) PATH_REALLOC(p_shard->p_keys, 0);
+        p_shard->p_keys   = p_keys;
+        p_shard->capacity = capacity;
+    }
+
+    // Probe for the key
+    for (size_t i = ( hash >> 6 ) & ( p_shard->capacity - 1 ); ; i = ( i + 1 ) & ( p_shard->capacity - 1 ))
+    {
+
+        // Seen before
+        if ( p_shard->p_keys[2 * i] == device && p_shard->p_keys[2 * i + 1] == inode )
+        {
+            inserted = false;
+            break;
+        }
+
+        // Store the key in a free slot
+        if ( p_shard->p_keys[2 * i + 1] == 0 )
+        {
+            p_shard->p_keys[2 * i]     = device;
+            p_shard->p_keys[2 * i + 1] = inode;
+            p_shard->count++;
+            break;
+        }
+    }
+
+    // Unlock
+    mutex_unlock(&p_shard->_lock);
+
+    // Done
+    return inserted;
+
+    // Error handling
+    {
+
+        // Standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    printf("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Unlock
+                mutex_unlock(&p_shard->_lock);
+
+                // Count the inode
+                return true;
+        }
+    }
+}
+
+int path_inode_set_destroy ( path_inode_set *p_set )
+{
+
+    // Free each shard
+    for (size_t i = 0; i < PATH_INODE_SET_SHARDS; i++)
+    {
+        if ( p_set->shards[i].p_keys ) (void) PATH_REALLOC(p_set->shards[i].p_keys, 0);
+        mutex_destroy(&p_set->shards[i]._lock);
+    }
+
+    // Success
+    return 1;
+}
+
+void path_usage_finish ( path_usage_context *p_du, path_usage_item *p_item )
+{
+
+    // Walk up the tree while each directory is done
+    while ( p_item && __atomic_sub_fetch(&p_item->pending, 1, __ATOMIC_ACQ_REL) == 0 )
+    {
+
+        // Initialized data
+        path_usage_item *p_parent = p_item->p_parent;
+
+        // Report the subtree
+        if ( p_du->pfn_usage ) p_du->pfn_usage(p_item->full_path, &p_item->usage, p_item->depth, p_du->p_context);
+
+        // Add the subtree to its parent
+        if ( p_parent )
+        {
+            __atomic_add_fetch(&p_parent->usage.size,        p_item->usage.size,        __ATOMIC_RELAXED);
+            __atomic_add_fetch(&p_parent->usage.blocks,      p_item->usage.blocks,      __ATOMIC_RELAXED);
+            __atomic_add_fetch(&p_parent->usage.files,       p_item->usage.files,       __ATOMIC_RELAXED);
+            __atomic_add_fetch(&p_parent->usage.directories, p_item->usage.directories, __ATOMIC_RELAXED);
+        }
+
+        // The root holds the total
+        else
+            p_du->total = p_item->usage;
+
+        // Free the directory
+        (void) PATH_REALLOC(p_item, 0);
+
+        // Next
+        p_item = p_parent;
+    }
+}
+
+void path_usage_item_close ( path_usage_item *p_item )
+{
+
+    // Close the directory once nothing needs it
+    if ( __atomic_sub_fetch(&p_item->open_pending, 1, __ATOMIC_ACQ_REL) == 0 && p_item->fd != -1 ) (void) close(p_item->fd);
+}
+
+int path_usage_item_open ( path_usage_item *p_item )
+{
+
+    // Open the directory, relative to its parent, so the full path isn't resolved again
+    if ( p_item->p_parent ) p_item->fd = openat(p_item->p_parent->fd, &p_item->full_path[p_item->name_offset], O_RDONLY | O_DIRECTORY | O_NOFOLLOW | O_CLOEXEC);
+    else                    p_item->fd = open(p_item->full_path, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+
+    // The parent may close, once each of its children is open
+    if ( p_item->p_parent ) path_usage_item_close(p_item->p_parent);
+
+    // Done
+    return ( p_item->fd != -1 );
+}
+
+void path_usage_task ( path_worker *p_worker, void *p_argument )
+{
+
+    // Initialized data
+    path_pool             *p_pool       = p_worker->p_pool;
+    path_usage_context    *p_du         = p_pool->p_context;
+    path_usage_item       *p_item       = p_argument;
+    path_usage             usage        = { 0 };
+    path_directory_reader  reader       = { 0 };
+    struct stat            st           = { 0 };
+    int                    directory_fd = -1;
+    const char            *name         = 0;
+    unsigned char          d_type       = 0;
+
+    // Don't start new work after the scan is stopped. The parent no longer waits for this directory
+    if ( __atomic_load_n(&p_pool->abort, __ATOMIC_ACQUIRE) )
+    {
+        if ( p_item->p_parent ) path_usage_item_close(p_item->p_parent);
+        goto done;
+    }
+
+    // Open the directory. A directory that can't be opened would be undercounted
+    if ( path_usage_item_open(p_item) == 0 ) goto failed_to_open;
+
+    // Store the directory
+    directory_fd = p_item->fd;
+
+    // The directory counts itself
+    if ( fstat(directory_fd, &st) == 0 )
+    {
+        usage.directories++;
+        usage.size   += (unsigned long long) st.st_size;
+        usage.blocks += (unsigned long long) st.st_blocks;
+    }
+
+    // Read the directory into this worker's buffer
+    if ( path_directory_reader_open(&reader, directory_fd, &p_worker->p_buffer, &p_worker->buffer_size, 0) == 0 ) goto failed_to_open;
+
+    // Iterate over each entry
+    while ( path_directory_reader_next(&reader, &name, &d_type) )
+    {
+
+        // Stop early
+        if ( __atomic_load_n(&p_pool->abort, __ATOMIC_RELAXED) ) break;
+
+        // Stat the entry. Symbolic links are measured, but not followed
+        if ( fstatat(directory_fd, name, &st, AT_SYMLINK_NOFOLLOW) == -1 ) continue;
+
+        // Measure the directory in its own task
+        if ( S_ISDIR(st.st_mode) )
+        {
+
+            // Initialized data
+            size_t           full_path_len = 0;
+            path_usage_item *p_child       = 0;
+
+            // Make the full path of the entry
+            if ( path_worker_text(p_worker, p_item->full_path, name) == 0 ) goto no_mem;
+
+            // Allocate memory for the child
+            full_path_len = strlen(p_worker->p_text);
+            p_child       = PATH_REALLOC(0, sizeof(path_usage_item) + full_path_len + 1);
+
+            // Error check
+            if ( p_child == (void *) 0 ) goto no_mem;
+
+            // Populate the child
+            *p_child = (path_usage_item)
+            {
+                .p_parent     = p_item,
+                .pending      = 1,
+                .open_pending = 1,
+                .depth        = p_item->depth + 1,
+                .name_offset  = strlen(p_item->full_path) + 1,
+                .fd           = -1
+            };
+            memcpy(p_child->full_path, p_worker->p_text, full_path_len + 1);
+
+            // The directory isn't done until the child is, and stays open until the child is
+            __atomic_add_fetch(&p_item->pending, 1, __ATOMIC_RELAXED);
+            __atomic_add_fetch(&p_item->open_pending, 1, __ATOMIC_RELAXED);
+
+            // Queue the child
+            if ( path_pool_push(p_worker, path_usage_task, p_child) == 0 )
+            {
+
+                // Clean up
+                __atomic_sub_fetch(&p_item->pending, 1, __ATOMIC_RELAXED);
+                __atomic_sub_fetch(&p_item->open_pending, 1, __ATOMIC_RELAXED);
+                (void) PATH_REALLOC(p_child, 0);
+
+                // Error
+                goto no_mem;
+            }
+
+            // Next entry
+            continue;
+        }
+
+        // Hard links are counted once
+        if ( st.st_nlink > 1 && path_inode_set_insert(&p_du->inodes, (unsigned long long) st.st_dev, (unsigned long long) st.st_ino) == false ) continue;
+
+        // Measure the file
+        usage.files++;
+        usage.size   += (unsigned long long) st.st_size;
+        usage.blocks += (unsigned long long) st.st_blocks;
+    }
+
+    // A directory that stopped short would be undercounted
+    if ( reader.failed ) p_du->failed = true;
+
+    // Clean up
+    (void) path_directory_reader_close(&reader);
+
+    done:
+
+    // Release the directory. It is closed once each child has opened itself
+    path_usage_item_close(p_item);
+
+    // Add this directory to its subtree
+    __atomic_add_fetch(&p_item->usage.size,        usage.size,        __ATOMIC_RELAXED);
+    __atomic_add_fetch(&p_item->usage.blocks,      usage.blocks,      __ATOMIC_RELAXED);
+    __atomic_add_fetch(&p_item->usage.files,       usage.files,       __ATOMIC_RELAXED);
+    __atomic_add_fetch(&p_item->usage.directories, usage.directories, __ATOMIC_RELAXED);
+
+    // This directory is read
+    path_usage_finish(p_du, p_item);
+
+    // Done
+    return;
+
+    // Error handling
+    {
+
+        // Standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    printf("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Stop the scan
+                p_du->failed = true;
+                path_pool_fail(p_pool);
+
+                // Clean up
+                (void) path_directory_reader_close(&reader);
+
+                // Finish the directory
+                goto done;
+        }
+
+        // Standard library errors
+        {
+            failed_to_open:
+                #ifndef NDEBUG
+                    printf("[Standard Library] Failed to open \"%s\". %s in call to function \"%s\"\n", p_item->full_path, strerror(errno), __FUNCTION__);
+                #endif
+
+                // The usage would be undercounted
+                p_du->failed = true;
+
+                // Finish the directory
+                goto done;
+        }
+    }
+}
+
+int path_disk_usage ( const path *const p_path, size_t thread_count, path_usage *p_usage, fn_path_usage pfn_usage, void *p_context )
+{
+
+    // Argument check
+    if ( p_path  == (void *) 0 ) goto no_path;
+    if ( p_usage == (void *) 0 ) goto no_usage;
+
+    // Initialized data
+    path_usage_context  du            = { .pfn_usage = pfn_usage, .p_context = p_context };
+    path_usage_item    *p_root        = 0;
+    size_t              full_path_len = 0;
+    struct stat         st            = { 0 };
+
+    // A file is its own usage
+    if ( p_path->type != PATH_TYPE_DIRECTORY )
+    {
+
+        // Stat the file
+        if ( lstat(p_path->full_path.text, &st) == -1 ) goto failed_to_stat;
+
+        // Return the usage to the caller
+        *p_usage = (path_usage)
+        {
+            .size   = (unsigned long long) st.st_size,
+            .blocks = (unsigned long long) st.st_blocks,
+            .files  = 1
+        };
+
+        // Success
+        return 1;
+    }
+
+    // Construct the set of hard linked inodes
+    if ( path_inode_set_create(&du.inodes) == 0 ) goto failed_to_create_inode_set;
+
+    // Compute the length of the root
+    full_path_len = strlen(p_path->full_path.text);
+
+    // Allocate memory for the root
+    p_root = PATH_REALLOC(0, sizeof(path_usage_item) + full_path_len + 1);
+
+    // Error check
+    if ( p_root == (void *) 0 ) goto no_mem;
+
+    // Populate the root
+    *p_root = (path_usage_item) { .p_parent = 0, .pending = 1, .open_pending = 1, .depth = 0, .fd = -1 };
+    memcpy(p_root->full_path, p_path->full_path.text, full_path_len + 1);
+
+    // Measure the tree
+    if ( path_pool_run(thread_count, path_usage_task, p_root, &du) == 0 ) goto failed_to_scan;
+
+    // Clean up
+    (void) path_inode_set_destroy(&du.inodes);
+
+    // Error check
+    if ( du.failed ) return 0;
+
+    // Return the usage to the caller
+    *p_usage = du.total;
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+        
+        // Argument errors
+        {
+            no_path:
+                #ifndef NDEBUG
+                    printf("[path] Null pointer provided for parameter \"p_path\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+                    
+            no_usage:
+                #ifndef NDEBUG
+                    printf("[path] Null pointer provided for parameter \"p_usage\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // path errors
+        {
+            failed_to_create_inode_set:
+                #ifndef NDEBUG
+                    printf("[path] Failed to create inode set in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            failed_to_scan:
+                #ifndef NDEBUG
+                    printf("[path] Failed to measure directory tree in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Clean up
+                (void) path_inode_set_destroy(&du.inodes);
+
+                // Error
+                return 0;
+        }
+
+        // Standard library errors
+        {
+            failed_to_stat:
+                #ifndef NDEBUG
+                    printf("[path] Failed to stat \"%s\" in call to function \"%s\"\n", p_path->full_path.text, __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_mem:
+                #ifndef NDEBUG
+                    printf("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Clean up
+                (void) path_inode_set_destroy(&du.inodes);
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int path_snapshot_builder_reserve ( path_snapshot_builder *p_builder, size_t max )
+{
+
+    // Initialized data
+    struct
+    {
+        void   **pp_column;
+        size_t   size;
+    } columns[] =
+    {
+        { (void **) &p_builder->p_name_offsets,   sizeof(unsigned long long) },
+        { (void **) &p_builder->p_sizes,          sizeof(unsigned long long) },
+        { (void **) &p_builder->p_inodes,         sizeof(unsigned long long) },
+        { (void **) &p_builder->p_modified,       sizeof(long long)          },
+        { (void **) &p_builder->p_parents,        sizeof(unsigned int)       },
+        { (void **) &p_builder->p_first_children, sizeof(unsigned int)       },
+        { (void **) &p_builder->p_child_counts,   sizeof(unsigned int)       },
+        { (void **) &p_builder->p_modes,          sizeof(unsigned int)       },
+        { (void **) &p_builder->p_types,          sizeof(unsigned char)      },
+        { (void **) &p_builder->p_fds,            sizeof(int)                }
+    };
+
+    // Grow each column
+    for (size_t i = 0; i < sizeof(columns) / sizeof(*columns); i++)
+    {
+
+        // Initialized data
+        void *p_column = path_realloc(&p_builder->allocator, *columns[i].pp_column, max * columns[i].size);
+
+        // Error check
+        if ( p_column == (void *) 0 ) goto no_mem;
+
+        // Store the column
+        *columns[i].pp_column = p_column;
+    }
+
+    // Store the capacity
+    p_builder->max = max;
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    printf("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int path_snapshot_builder_append ( path_snapshot_builder *p_builder, const char *name, size_t parent, const path_metadata *const p_metadata )
+{
+
+    // Initialized data
+    size_t name_len = strlen(name),
+           i        = p_builder->count;
+
+    // Indices are 32 bits wide
+    if ( i == 0xFFFFFFFF ) goto too_many_entries;
+
+    // Grow the columns
+    if ( i == p_builder->max )
+        if ( path_snapshot_builder_reserve(p_builder, p_builder->max ? p_builder->max * 2 : 1024) == 0 ) goto no_mem;
+
+    // Grow the names
+    if ( p_builder->names_size + name_len + 1 > p_builder->names_max )
+    {
+
+        // Initialized data
+        size_t  names_max = p_builder->names_max ? p_builder->names_max : 16384;
+        char   *p_names   = 0;
+
+        // Grow geometrically
+        while ( names_max < p_builder->names_size + name_len + 1 ) names_max *= 2;
+
+        // Reallocate
+        p_names = path_realloc(&p_builder->allocator, p_builder->p_names, names_max);
+
+        // Error check
+        if ( p_names == (void *) 0 ) goto no_mem;
+
+        // Store the names
+        p_builder->p_names   = p_names;
+        p_builder->names_max = names_max;
+    }
+
+    // Store the name
+    memcpy(&p_builder->p_names[p_builder->names_size], name, name_len + 1);
+    p_builder->p_name_offsets[i] = p_builder->names_size;
+    p_builder->names_size       += name_len + 1;
+
+    // Store the entry. Children are filled in when the directory is read
+    p_builder->p_sizes[i]          = (unsigned long long) p_metadata->size;
+    p_builder->p_inodes[i]         = p_metadata->inode;
+    p_builder->p_modified[i]       = p_metadata->modified_seconds * 1000000000LL + p_metadata->modified_nanoseconds;
+    p_builder->p_parents[i]        = (unsigned int) parent;
+    p_builder->p_first_children[i] = 0;
+    p_builder->p_child_counts[i]   = 0;
+    p_builder->p_modes[i]          = p_metadata->mode;
+    p_builder->p_types[i]          = (unsigned char) p_metadata->type;
+    p_builder->p_fds[i]            = -1;
+    p_builder->count++;
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // path errors
+        {
+            too_many_entries:
+                #ifndef NDEBUG
+                    printf("[path] Too many entries for a snapshot in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // Standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    printf("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int path_snapshot_builder_open ( path_snapshot_builder *p_builder, size_t index )
+{
+
+    // Initialized data
+    size_t  depth       = 0,
+            ancestor    = index;
+    size_t *p_chain     = 0;
+    int     fd          = p_builder->p_fds[index],
+            error       = 0;
+    bool    root_opened = false;
+
+    // A queued directory is already open. The caller takes it
+    if ( fd != -1 )
+    {
+        p_builder->p_fds[index] = -1;
+        p_builder->fd_count--;
+        return fd;
+    }
+
+    // Find the nearest ancestor that is still open
+    while ( ancestor != 0 && p_builder->p_fds[ancestor] == -1 ) ancestor = p_builder->p_parents[ancestor], depth++;
+
+    // Past it, the root is opened by its full path
+    if ( p_builder->p_fds[ancestor] == -1 )
+    {
+        fd          = open(&p_builder->p_names[p_builder->p_name_offsets[0]], O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+        root_opened = true;
+    }
+    else
+        fd = p_builder->p_fds[ancestor];
+
+    // Done
+    if ( fd == -1 || depth == 0 ) return fd;
+
+    // Find the directories between the ancestor and the directory
+    p_chain = path_realloc(&p_builder->allocator, 0, depth * sizeof(size_t));
+    if ( p_chain == (void *) 0 ) 
+    {
+        if ( root_opened ) (void) close(fd);
+        errno = ENOMEM;
+        return -1;
+    }
+    for (size_t i = depth, j = index; i > 0; i--, j = p_builder->p_parents[j]) p_chain[i - 1] = j;
+
+    // Open each directory, relative to the one above it
+    for (size_t i = 0; i < depth && fd != -1; i++)
+    {
+
+        // Initialized data
+        int child_fd = openat(fd, &p_builder->p_names[p_builder->p_name_offsets[p_chain[i]]], O_RDONLY | O_DIRECTORY | O_NOFOLLOW | O_CLOEXEC);
+
+        // Release the directory above it, unless it is queued
+        error = errno;
+        if ( i || root_opened ) (void) close(fd);
+        errno = error;
+
+        // Next
+        fd = child_fd;
+    }
+
+    // Clean up
+    error = errno;
+    (void) path_realloc(&p_builder->allocator, p_chain, 0);
+    errno = error;
+
+    // Done
+    return fd;
+}
+
+size_t path_snapshot_text ( const unsigned int *p_parents, const unsigned long long *p_name_offsets, const char *p_names, size_t index, char *p_buffer, size_t buffer_size )
+{
+
+    // Initialized data
+    const char *root       = &p_names[p_name_offsets[0]];
+    size_t      root_len   = strlen(root),
+                length     = 0,
+                position   = 0;
+    bool        root_slash = root_len && root[root_len - 1] == '/';
+
+    // Measure the full path. Parents always come before their children
+    for (size_t i = index; ; i = p_parents[i])
+    {
+
+        // Add the name
+        length += strlen(&p_names[p_name_offsets[i]]);
+
+        // Stop at the root
+        if ( i == 0 ) break;
+
+        // Error check
+        if ( p_parents[i] >= i ) return 0;
+
+        // Add a separator
+        if ( !( p_parents[i] == 0 && root_slash ) ) length++;
+    }
+
+    // The buffer is too small
+    if ( length >= buffer_size ) return length;
+
+    // Write the full path, from the end
+    p_buffer[length] = '\0';
+    position         = length;
+    for (size_t i = index; ; i = p_parents[i])
+    {
+
+        // Initialized data
+        const char *name     = &p_names[p_name_offsets[i]];
+        size_t      name_len = strlen(name);
+
+        // Write the name
+        position -= name_len;
+        memcpy(&p_buffer[position], name, name_len);
+
+        // Stop at the root
+        if ( i == 0 ) break;
+
+        // Write a separator
+        if ( !( p_parents[i] == 0 && root_slash ) ) p_buffer[--position] = '/';
+    }
+
+    // Done
+    return length;
+}
+
+int path_snapshot_write ( int fd, const void *p_data, size_t size, unsigned long long offset )
+{
+
+    // Write until done
+    while ( size )
+    {
+
+        // Initialized data
+        ssize_t written = pwrite(fd, p_data, size, (off_t) offset);
+
+        // Error check
+        if ( written == -1 && errno == EINTR ) continue;
+        if ( written <= 0 ) return 0;
+
+        // Advance
+        p_data  = (const char *) p_data + written;
+        size   -= (size_t) written;
+        offset += (unsigned long long) written;
+    }
+
+    // Success
+    return 1;
+}
+
+int path_snapshot_save ( const path *const p_path, const char *snapshot_path )
+{
+
+    // Argument check
+    if ( p_path        == (void *) 0 ) goto no_path;
+    if ( snapshot_path == (void *) 0 ) goto no_snapshot_path;
+
+    // Initialized data
+    path_snapshot_builder  builder     = { .allocator = p_path->allocator };
+    path_listing           listing     = { .allocator = p_path->allocator };
+    path_snapshot_header   header      = { .magic = PATH_SNAPSHOT_MAGIC, .version = PATH_SNAPSHOT_VERSION };
+    path_metadata          metadata     = { 0 };
+    path_write_file        file         = { .fd = -1 };
+    struct stat            st           = { 0 };
+    char                  *p_buffer     = 0,
+                          *p_text       = 0;
+    const char            *name         = strrchr(snapshot_path, '/');
+    size_t                 buffer_size  = 0,
+                           text_max     = 0;
+    unsigned long long     offset       = 0;
+    int                    fd           = -1,
+                           directory_fd = AT_FDCWD;
+
+    // Stat the root. The root is named by its full path
+    if ( lstat(p_path->full_path.text, &st) == -1 ) goto failed_to_stat;
+    path_metadata_from_stat(&st, &metadata);
+    if ( path_snapshot_builder_append(&builder, p_path->full_path.text, 0, &metadata) == 0 ) goto failed_to_build;
+
+    // Store the device of the root
+    header.device = (unsigned long long) st.st_dev;
+
+    // Read each directory, breadth first, so the contents of each directory are contiguous
+    for (size_t i = 0; i < builder.count; i++)
+    {
+
+        // Initialized data
+        path_directory_reader  reader       = { 0 };
+        const char            *name         = 0;
+        unsigned char          d_type       = 0;
+        int                    directory_fd = -1;
+
+        // Only directories have contents. Symbolic links aren't followed
+        if ( ( builder.p_modes[i] & S_IFMT ) != S_IFDIR ) continue;
+
+        // Open the directory, relative to its parent
+        directory_fd = path_snapshot_builder_open(&builder, i);
+
+        // Error check. Directories the caller may not read are empty
+        if ( directory_fd == -1 && errno == EACCES ) continue;
+        if ( directory_fd == -1 ) goto failed_to_open;
+
+        // Read the directory into a listing, with metadata
+        (void) path_listing_reset(&listing);
+        if ( path_listing_reserve(&listing, 1, true) == 0 || path_directory_reader_open(&reader, directory_fd, &p_buffer, &buffer_size, &builder.allocator) == 0 )
+        {
+            (void) close(directory_fd);
+            goto no_mem;
+        }
+
+        // Stat each entry
+        while ( path_directory_reader_next(&reader, &name, &d_type) )
+        {
+
+            // Initialized data
+            size_t j = listing.count;
+
+            // Store the name
+            if ( path_listing_append(&listing, name, strlen(name), PATH_TYPE_FILE) == 0 )
+            {
+                (void) path_directory_reader_close(&reader);
+                (void) close(directory_fd);
+                goto no_mem;
+            }
+
+            // Store the metadata. Entries that disappear have none
+            if ( fstatat(directory_fd, name, &st, AT_SYMLINK_NOFOLLOW) == 0 ) path_metadata_from_stat(&st, &listing.p_metadata[j]);
+        }
+
+        // Clean up
+        (void) path_directory_reader_close(&reader);
+
+        // A directory that stopped short would be missing entries in the snapshot
+        if ( reader.failed )
+        {
+            (void) close(directory_fd);
+            goto failed_to_build;
+        }
+
+        // Sort the contents by name
+        if ( path_listing_sort(&listing) == 0 ) 
+        {
+            (void) close(directory_fd);
+            goto no_mem;
+        }
+
+        // Store the contents
+        builder.p_first_children[i] = (unsigned int) builder.count;
+        for (size_t j = 0; j < listing.count; j++)
+        {
+
+            // Initialized data
+            size_t k = builder.count;
+
+            // Skip entries that disappeared
+            if ( listing.p_metadata[j].type == 0 ) continue;
+
+            // Store the entry
+            if ( path_snapshot_builder_append(&builder, &listing.p_names[listing.p_offsets[j]], i, &listing.p_metadata[j]) == 0 ) 
+            {
+                (void) close(directory_fd);
+                goto failed_to_build;
+            }
+
+            // Keep a queued directory open, so it is read without resolving its path again. Past 
+            // the budget, it is opened from its nearest open ancestor when its turn comes
+            if ( ( builder.p_modes[k] & S_IFMT ) == S_IFDIR && builder.fd_count < PATH_SNAPSHOT_FD_BUDGET )
+            {
+                builder.p_fds[k] = openat(directory_fd, &listing.p_names[listing.p_offsets[j]], O_RDONLY | O_DIRECTORY | O_NOFOLLOW | O_CLOEXEC);
+                if ( builder.p_fds[k] != -1 ) builder.fd_count++;
+            }
+        }
+        builder.p_child_counts[i] = (unsigned int) ( builder.count - builder.p_first_children[i] );
+
+        // Done with the directory
+        (void) close(directory_fd);
+    }
+
+    // Lay out the columns
+    #define PATH_SNAPSHOT_COLUMN(column, size) header.column = offset = PATH_ARENA_ALIGN(offset); offset += (unsigned long long) (size);
+    offset = sizeof(path_snapshot_header);
+    header.count      = builder.count;
+    header.names_size = builder.names_size;
+    PATH_SNAPSHOT_COLUMN(name_offsets,   builder.count * sizeof(unsigned long long))
+    PATH_SNAPSHOT_COLUMN(sizes,          builder.count * sizeof(unsigned long long))
+    PATH_SNAPSHOT_COLUMN(modified,       builder.count * sizeof(long long))
+    PATH_SNAPSHOT_COLUMN(inodes,         builder.count * sizeof(unsigned long long))
+    PATH_SNAPSHOT_COLUMN(parents,        builder.count * sizeof(unsigned int))
+    PATH_SNAPSHOT_COLUMN(first_children, builder.count * sizeof(unsigned int))
+    PATH_SNAPSHOT_COLUMN(child_counts,   builder.count * sizeof(unsigned int))
+    PATH_SNAPSHOT_COLUMN(modes,          builder.count * sizeof(unsigned int))
+    PATH_SNAPSHOT_COLUMN(types,          builder.count * sizeof(unsigned char))
+    PATH_SNAPSHOT_COLUMN(names,          builder.names_size)
+    #undef PATH_SNAPSHOT_COLUMN
+
+    // Open the directory that will contain the snapshot
+    if ( name )
+    {
+
+        // Initialized data
+        size_t directory_len = (size_t) ( name - snapshot_path );
+
+        // Make the text of the directory. The root is "/"
+        if ( directory_len + 2 > text_max )
+        {
+
+            // Grow the text
+            char *p_grown = path_realloc(&builder.allocator, p_text, directory_len + 2);
+
+            // Error check
+            if ( p_grown == (void *) 0 ) goto no_mem;
+
+            // Store the text
+            p_text   = p_grown;
+            text_max = directory_len + 2;
+        }
+        memcpy(p_text, snapshot_path, directory_len ? directory_len : 1);
+        p_text[directory_len ? directory_len : 1] = '\0';
+
+        // Open the directory
+        directory_fd = open(p_text, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+
+        // Error check
+        if ( directory_fd == -1 ) goto failed_to_write;
+
+        // The name follows the last '/'
+        name++;
+    }
+    else
+        name = snapshot_path;
+
+    // Write the snapshot to a new file beside the old one, so readers never map a partial snapshot
+    if ( path_write_open(directory_fd, 0, 0, &file) == 0 ) goto failed_to_write;
+    fd = file.fd;
+
+    // Write the header, and each column
+    if ( path_snapshot_write(fd, &header,                  sizeof(header),                                0                        ) == 0 ) goto failed_to_write;
+    if ( path_snapshot_write(fd, builder.p_name_offsets,   builder.count * sizeof(unsigned long long),    header.name_offsets       ) == 0 ) goto failed_to_write;
+    if ( path_snapshot_write(fd, builder.p_sizes,          builder.count * sizeof(unsigned long long),    header.sizes              ) == 0 ) goto failed_to_write;
+    if ( path_snapshot_write(fd, builder.p_modified,       builder.count * sizeof(long long),             header.modified           ) == 0 ) goto failed_to_write;
+    if ( path_snapshot_write(fd, builder.p_inodes,         builder.count * sizeof(unsigned long long),    header.inodes             ) == 0 ) goto failed_to_write;
+    if ( path_snapshot_write(fd, builder.p_parents,        builder.count * sizeof(unsigned int),          header.parents            ) == 0 ) goto failed_to_write;
+    if ( path_snapshot_write(fd, builder.p_first_children, builder.count * sizeof(unsigned int),          header.first_children     ) == 0 ) goto failed_to_write;
+    if ( path_snapshot_write(fd, builder.p_child_counts,   builder.count * sizeof(unsigned int),          header.child_counts       ) == 0 ) goto failed_to_write;
+    if ( path_snapshot_write(fd, builder.p_modes,          builder.count * sizeof(unsigned int),          header.modes              ) == 0 ) goto failed_to_write;
+    if ( path_snapshot_write(fd, builder.p_types,          builder.count * sizeof(unsigned char),         header.types              ) == 0 ) goto failed_to_write;
+    if ( path_snapshot_write(fd, builder.p_names,          builder.names_size,                            header.names              ) == 0 ) goto failed_to_write;
+
+    // Make the snapshot durable, and replace the old one
+    if ( fdatasync(fd) == -1 || path_write_publish(directory_fd, name, &file) == 0 ) goto failed_to_write;
+
+    done:
+
+    // Clean up
+    if ( file.fd != -1 )
+    {
+        if ( file.temp_name[0] ) (void) unlinkat(directory_fd, file.temp_name, 0);
+        (void) close(file.fd);
+    }
+    if ( directory_fd != AT_FDCWD && directory_fd != -1 ) (void) close(directory_fd);
+    (void) path_listing_destroy(&listing);
+    if ( p_buffer ) (void) path_realloc(&builder.allocator, p_buffer, 0);
+    if ( p_text   ) (void) path_realloc(&builder.allocator, p_text, 0);
+    for (size_t i = 0; i < builder.count; i++) if ( builder.p_fds[i] != -1 ) (void) close(builder.p_fds[i]);
+    {
+        void *columns[] = { builder.p_name_offsets, builder.p_sizes, builder.p_inodes, builder.p_modified, builder.p_parents, builder.p_first_children, builder.p_child_counts, builder.p_modes, builder.p_types, builder.p_names, builder.p_fds };
+        for (size_t i = 0; i < sizeof(columns) / sizeof(*columns); i++) if ( columns[i] ) (void) path_realloc(&builder.allocator, columns[i], 0);
+    }
+
+    // Done
+    return ( header.version == PATH_SNAPSHOT_VERSION );
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_path:
+                #ifndef NDEBUG
+                    printf("[path] Null pointer provided for parameter \"p_path\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_snapshot_path:
+                #ifndef NDEBUG
+                    printf("[path] Null pointer provided for parameter \"snapshot_path\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // path errors
+        {
+            failed_to_build:
+                #ifndef NDEBUG
+                    printf("[path] Failed to build snapshot of \"%s\" in call to function \"%s\"\n", p_path->full_path.text, __FUNCTION__);
+                #endif
+
+                // Clean up
+                header.version = 0;
+                goto done;
+        }
+
+        // Standard library errors
+        {
+            failed_to_stat:
+                #ifndef NDEBUG
+                    printf("[path] Failed to stat \"%s\" in call to function \"%s\"\n", p_path->full_path.text, __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            failed_to_open:
+                #ifndef NDEBUG
+                    printf("[path] Failed to open a directory beneath \"%s\". %s in call to function \"%s\"\n", p_path->full_path.text, strerror(errno), __FUNCTION__);
+                #endif
+
+                // Clean up
+                header.version = 0;
+                goto done;
+
+            failed_to_write:
+                #ifndef NDEBUG
+                    printf("[path] Failed to write snapshot \"%s\". %s in call to function \"%s\"\n", snapshot_path, strerror(errno), __FUNCTION__);
+                #endif
+
+                // Clean up
+                header.version = 0;
+                goto done;
+
+            no_mem:
+                #ifndef NDEBUG
+                    printf("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Clean up
+                header.version = 0;
+                goto done;
+        }
+    }
+}
+
+int path_snapshot_open ( path_snapshot **pp_snapshot, const char *snapshot_path )
+{
+
+    // Argument check
+    if ( pp_snapshot   == (void *) 0 ) goto no_snapshot;
+    if ( snapshot_path == (void *) 0 ) goto no_snapshot_path;
+
+    // Initialized data
+    path_snapshot              *p_snapshot = 0;
+    const path_snapshot_header *p_header   = 0;
+    struct stat                 st         = { 0 };
+    void                       *p_map      = MAP_FAILED;
+    int                         fd         = open(snapshot_path, O_RDONLY | O_CLOEXEC);
+
+    // Error check
+    if ( fd == -1 ) goto failed_to_open;
+
+    // Get the size of the file
+    if ( fstat(fd, &st) == -1 || (size_t) st.st_size < sizeof(path_snapshot_header) ) goto invalid_snapshot;
+
+    // Map the file. Processes that map the same snapshot share its pages
+    p_map = mmap(0, (size_t) st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+
+    // The mapping keeps the file open
+    (void) close(fd);
+    fd = -1;
+
+    // Error check
+    if ( p_map == MAP_FAILED ) goto invalid_snapshot;
+
+    // Initialized data
+    p_header = p_map;
+
+    // Check the header, and that each column is inside the file
+    if ( memcmp(p_header->magic, PATH_SNAPSHOT_MAGIC, sizeof(p_header->magic)) != 0 ) goto invalid_snapshot;
+    if ( p_header->version != PATH_SNAPSHOT_VERSION ) goto invalid_snapshot;
+    if ( p_header->count == 0 || p_header->count > 0xFFFFFFFF ) goto invalid_snapshot;
+    {
+
+        // Initialized data
+        unsigned long long size      = (unsigned long long) st.st_size;
+        struct { unsigned long long offset, size; } columns[] =
+        {
+            { p_header->name_offsets,   p_header->count * sizeof(unsigned long long) },
+            { p_header->sizes,          p_header->count * sizeof(unsigned long long) },
+            { p_header->modified,       p_header->count * sizeof(long long)          },
+            { p_header->inodes,         p_header->count * sizeof(unsigned long long) },
+            { p_header->parents,        p_header->count * sizeof(unsigned int)       },
+            { p_header->first_children, p_header->count * sizeof(unsigned int)       },
+            { p_header->child_counts,   p_header->count * sizeof(unsigned int)       },
+            { p_header->modes,          p_header->count * sizeof(unsigned int)       },
+            { p_header->types,          p_header->count * sizeof(unsigned char)      },
+            { p_header->names,          p_header->names_size                         }
+        };
+
+        // Check each column
+        for (size_t i = 0; i < sizeof(columns) / sizeof(*columns); i++)
+            if ( columns[i].offset % 8 || columns[i].offset > size || columns[i].size > size - columns[i].offset ) goto invalid_snapshot;
+
+        // The names end with a null terminator
+        if ( p_header->names_size == 0 || ((const char *) p_map)[p_header->names + p_header->names_size - 1] != '\0' ) goto invalid_snapshot;
+    }
+
+    // Check the tree, so walking it never leaves the columns, or loops
+    {
+
+        // Initialized data
+        const unsigned long long *p_name_offsets   = (const unsigned long long *) ( (const char *) p_map + p_header->name_offsets );
+        const unsigned int       *p_parents        = (const unsigned int *)       ( (const char *) p_map + p_header->parents );
+        const unsigned int       *p_first_children = (const unsigned int *)       ( (const char *) p_map + p_header->first_children );
+        const unsigned int       *p_child_counts   = (const unsigned int *)       ( (const char *) p_map + p_header->child_counts );
+
+        // Check each entry. Parents come before their children, and children come after their parent
+        for (unsigned long long i = 0; i < p_header->count; i++)
+        {
+            if ( p_name_offsets[i] >= p_header->names_size                                      ) goto invalid_snapshot;
+            if ( i && p_parents[i] >= i                                                          ) goto invalid_snapshot;
+            if ( (unsigned long long) p_first_children[i] + p_child_counts[i] > p_header->count ) goto invalid_snapshot;
+            if ( p_child_counts[i] && p_first_children[i] <= i                                   ) goto invalid_snapshot;
+        }
+    }
+
+    // Allocate memory for the snapshot
+    p_snapshot = PATH_REALLOC(0, sizeof(path_snapshot));
+
+    // Error check
+    if ( p_snapshot == (void *) 0 ) goto no_mem;
+
+    // Point each column into the mapping
+    *p_snapshot = (path_snapshot)
+    {
+        .p_map            = p_map,
+        .map_size         = (size_t) st.st_size,
+        .p_header         = p_header,
+        .p_name_offsets   = (const unsigned long long *) ( (const char *) p_map + p_header->name_offsets ),
+        .p_sizes          = (const unsigned long long *) ( (const char *) p_map + p_header->sizes ),
+        .p_inodes         = (const unsigned long long *) ( (const char *) p_map + p_header->inodes ),
+        .p_modified       = (const long long *)          ( (const char *) p_map + p_header->modified ),
+        .p_parents        = (const unsigned int *)       ( (const char *) p_map + p_header->parents ),
+        .p_first_children = (const unsigned int *)       ( (const char *) p_map + p_header->first_children ),
+        .p_child_counts   = (const unsigned int *)       ( (const char *) p_map + p_header->child_counts ),
+        .p_modes          = (const unsigned int *)       ( (const char *) p_map + p_header->modes ),
+        .p_types          = (const unsigned char *)      ( (const char *) p_map + p_header->types ),
+        .p_names          = (const char *)               ( (const char *) p_map + p_header->names )
+    };
+
+    // Return a pointer to the caller
+    *pp_snapshot = p_snapshot;
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_snapshot:
+                #ifndef NDEBUG
+                    printf("[path] Null pointer provided for parameter \"pp_snapshot\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_snapshot_path:
+                #ifndef NDEBUG
+                    printf("[path] Null pointer provided for parameter \"snapshot_path\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // path errors
+        {
+            invalid_snapshot:
+                #ifndef NDEBUG
+                    printf("[path] \"%s\" is not a valid snapshot in call to function \"%s\"\n", snapshot_path, __FUNCTION__);
+                #endif
+
+                // Clean up
+                if ( fd != -1 ) (void) close(fd);
+                if ( p_map != MAP_FAILED ) (void) munmap(p_map, (size_t) st.st_size);
+
+                // Error
+                return 0;
+        }
+
+        // Standard library errors
+        {
+            failed_to_open:
+                #ifndef NDEBUG
+                    printf("[path] Failed to open snapshot \"%s\". %s in call to function \"%s\"\n", snapshot_path, strerror(errno), __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_mem:
+                #ifndef NDEBUG
+                    printf("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Clean up
+                (void) munmap(p_map, (size_t) st.st_size);
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+size_t path_snapshot_count ( const path_snapshot *const p_snapshot )
+{
+
+    // Argument check
+    if ( p_snapshot == (void *) 0 ) return 0;
+
+    // Return
+    return (size_t) p_snapshot->p_header->count;
+}
+
+void path_snapshot_metadata ( const path_snapshot *const p_snapshot, size_t index, path_metadata *p_metadata )
+{
+
+    // Initialized data
+    long long modified = p_snapshot->p_modified[index];
+
+    // Store the metadata
+    *p_metadata = (path_metadata)
+    {
+        .type                 = (path_type) p_snapshot->p_types[index],
+        .mode                 = p_snapshot->p_modes[index],
+        .size                 = (size_t) p_snapshot->p_sizes[index],
+        .inode                = p_snapshot->p_inodes[index],
+        .device               = p_snapshot->p_header->device,
+        .modified_seconds     = modified / 1000000000LL,
+        .modified_nanoseconds = (long) ( modified % 1000000000LL )
+    };
+
+    // Nanoseconds are never negative
+    if ( p_metadata->modified_nanoseconds < 0 )
+    {
+        p_metadata->modified_seconds--;
+        p_metadata->modified_nanoseconds += 1000000000L;
+    }
+}
+
+const char *path_snapshot_name ( const path_snapshot *const p_snapshot, size_t index )
+{
+
+    // Error check
+    if ( p_snapshot->p_name_offsets[index] >= p_snapshot->p_header->names_size ) return 0;
+
+    // Done
+    return &p_snapshot->p_names[p_snapshot->p_name_offsets[index]];
+}
+
+int path_snapshot_get ( const path_snapshot *const p_snapshot, size_t index, path_snapshot_entry *p_entry )
+{
+
+    // Argument check
+    if ( p_snapshot == (void *) 0 ) goto no_snapshot;
+    if ( p_entry    == (void *) 0 ) goto no_entry;
+
+    // Error checking
+    if ( index >= p_snapshot->p_header->count ) goto out_of_range;
+    if ( p_snapshot->p_name_offsets[index] >= p_snapshot->p_header->names_size ) goto invalid_snapshot;
+
+    // Return the entry to the caller
+    *p_entry = (path_snapshot_entry)
+    {
+        .name        = &p_snapshot->p_names[p_snapshot->p_name_offsets[index]],
+        .parent      = p_snapshot->p_parents[index],
+        .first_child = p_snapshot->p_first_children[index],
+        .child_count = p_snapshot->p_child_counts[index]
+    };
+
+    // Return the metadata to the caller
+    path_snapshot_metadata(p_snapshot, index, &p_entry->metadata);
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_snapshot:
+                #ifndef NDEBUG
+                    printf("[path] Null pointer provided for parameter \"p_snapshot\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_entry:
+                #ifndef NDEBUG
+                    printf("[path] Null pointer provided for parameter \"p_entry\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // path errors
+        {
+            out_of_range:
+                #ifndef NDEBUG
+                    printf("[path] Index %zu is out of range in call to function \"%s\"\n", index, __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            invalid_snapshot:
+                #ifndef NDEBUG
+                    printf("[path] Entry %zu of the snapshot is corrupt in call to function \"%s\"\n", index, __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+size_t path_snapshot_full_path ( const path_snapshot *const p_snapshot, size_t index, char *p_buffer, size_t buffer_size )
+{
+
+    // Argument check
+    if ( p_snapshot == (void *) 0 ) return 0;
+
+    // Error checking
+    if ( index >= p_snapshot->p_header->count ) return 0;
+
+    // Return
+    return path_snapshot_text(p_snapshot->p_parents, p_snapshot->p_name_offsets, p_snapshot->p_names, index, p_buffer, buffer_size);
+}
+
+int path_snapshot_close ( path_snapshot **pp_snapshot )
+{
+
+    // Argument check
+    if ( pp_snapshot == (void *) 0 ) goto no_snapshot;
+
+    // Initialized data
+    path_snapshot *p_snapshot = *pp_snapshot;
+
+    // Error check
+    if ( p_snapshot == (void *) 0 ) goto pointer_to_null_pointer;
+
+    // No more pointer for caller
+    *pp_snapshot = 0;
+
+    // Unmap the file
+    (void) munmap(p_snapshot->p_map, p_snapshot->map_size);
+
+    // Free the snapshot
+    (void) PATH_REALLOC(p_snapshot, 0);
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_snapshot:
+                #ifndef NDEBUG
+                    printf("[path] Null pointer provided for parameter \"pp_snapshot\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            pointer_to_null_pointer:
+                #ifndef NDEBUG
+                    printf("[path] Parameter \"pp_snapshot\" points to null pointer in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+bool path_diff_changed ( const path_metadata *const p_old, const path_metadata *const p_new )
+{
+
+    // The mode and the inode of any entry
+    if ( p_old->mode != p_new->mode || p_old->inode != p_new->inode ) return true;
+
+    // The modification time of a directory changes with its contents, which are compared separately
+    if ( ( p_old->mode & S_IFMT ) == S_IFDIR ) return false;
+
+    // The size and the modification time of anything else
+    return p_old->size                 != p_new->size             ||
+           p_old->modified_seconds     != p_new->modified_seconds ||
+           p_old->modified_nanoseconds != p_new->modified_nanoseconds;
+}
+
+int path_diff_record_add ( path_diff_context *p_diff, path_diff_kind kind, const char *path_text, const path_metadata *const p_metadata )
+{
+
+    // Initialized data
+    size_t  path_len = strlen(path_text);
+    char   *p_path   = PATH_REALLOC(0, path_len + 1);
+
+    // Error check
+    if ( p_path == (void *) 0 ) goto no_mem;
+
+    // Copy the path
+    memcpy(p_path, path_text, path_len + 1);
+
+    // Lock
+    mutex_lock(&p_diff->_lock);
+
+    // Grow the records
+    if ( p_diff->record_count == p_diff->record_max )
+    {
+
+        // Initialized data
+        size_t            record_max = p_diff->record_max ? p_diff->record_max * 2 : 256;
+        path_diff_record *p_records  = PATH_REALLOC(p_diff->p_records, record_max * sizeof(path_diff_record));
+
+        // Error check
+        if ( p_records == (void *) 0 )
+        {
+            mutex_unlock(&p_diff->_lock);
+            (void) PATH_REALLOC(p_path, 0);
+            goto no_mem;
+        }
+
+        // Store the records
+        p_diff->p_records  = p_records;
+        p_diff->record_max = record_max;
+    }
+
+    // Store the record
+    p_diff->p_records[p_diff->record_count++] = (path_diff_record) { .kind = kind, .metadata = *p_metadata, .path = p_path };
+
+    // Unlock
+    mutex_unlock(&p_diff->_lock);
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    printf("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
     }
+}
 
-    #else
+int path_diff_record_compare_path ( const void *p_a, const void *p_b )
+{
 
-    /////////////////////////
-    // UNIX implementation //
-    /////////////////////////
+    // Order by path
+    return strcmp(((const path_diff_record *) p_a)->path, ((const path_diff_record *) p_b)->path);
+}
+
+int path_diff_record_compare_inode ( const void *p_a, const void *p_b )
+{
 
     // Initialized data
-    char *full_path = 0;
+    const path_diff_record *p_record_a = *(const path_diff_record *const *) p_a,
+                           *p_record_b = *(const path_diff_record *const *) p_b;
 
-    // Allocate a path
-    if ( path_create(&p_path) == (void *) 0 ) goto no_mem;
-    
-    // Copy the path parameter into an internal buffer
-    sprintf(_path, "%s", path_string);
+    // Order by inode, then by path
+    if ( p_record_a->metadata.inode != p_record_b->metadata.inode ) return ( p_record_a->metadata.inode < p_record_b->metadata.inode ) ? -1 : 1;
+    return strcmp(p_record_a->path, p_record_b->path);
+}
 
-    // Get the path properties
-    if ( stat(path_string, &st) != 0 ) goto failed_to_get_file_properties;
+void path_diff_task ( path_worker *p_worker, void *p_argument )
+{
 
-    // Copy the full path
+    // Initialized data
+    path_pool           *p_pool       = p_worker->p_pool;
+    path_diff_context   *p_diff       = p_pool->p_context;
+    path_diff_item      *p_item       = p_argument;
+    const path_snapshot *p_old        = p_diff->p_old,
+                        *p_new        = p_diff->p_new;
+    path_listing         listing      = { 0 };
+    path_metadata        old_metadata = { 0 },
+                         new_metadata = { 0 };
+    size_t               old_first    = p_old->p_first_children[p_item->old_index],
+                         old_count    = p_old->p_child_counts[p_item->old_index],
+                         new_first    = 0,
+                         new_count    = 0,
+                         i            = 0,
+                         j            = 0;
+    bool                 trust        = p_diff->flags & PATH_DIFF_TRUST_DIRECTORIES;
+    int                  directory_fd = -1;
+
+    // Don't start new work after the diff is stopped
+    if ( __atomic_load_n(&p_pool->abort, __ATOMIC_ACQUIRE) ) goto done;
+
+    // Error check
+    if ( old_first + old_count > p_old->p_header->count ) goto invalid_snapshot;
+
+    // Read the contents of the directory in the new snapshot
+    if ( p_new )
     {
 
-        // Initialized data
-        size_t len = strlen(_path);
-        
-        // Allocate memory for the full path string
-        full_path = PATH_REALLOC(0, sizeof(char) * ( len + 1024 ));
+        // The contents are contiguous
+        new_first = p_new->p_first_children[p_item->new_index];
+        new_count = p_new->p_child_counts[p_item->new_index];
 
         // Error check
-        if ( full_path == (void *) 0 ) goto no_mem;
-        
-        // Copy the full path
-        strncpy(full_path, _path, len);
+        if ( new_first + new_count > p_new->p_header->count ) goto invalid_snapshot;
 
-        // Write a null terminator
-        full_path[len] = '\0';
+        // Skip the subtree if the directory is unchanged
+        if ( trust && new_count == old_count && p_new->p_modified[p_item->new_index] == p_old->p_modified[p_item->old_index] ) goto done;
+    }
 
-        // Write a null terminator
-        strncat(full_path, "\\*.*", 4);
-    }  
+    // Read the contents of the directory in the live tree
+    else
+    {
 
-    // Parse the path as a directory
-    if ( (st.st_mode & S_IFMT) == S_IFDIR )
+        // Initialized data
+        path_directory_reader  reader = { 0 };
+        struct stat            st     = { 0 };
+        const char            *name   = 0;
+        unsigned char          d_type = 0;
+
+        // Open the directory. Unreadable directories are empty, as they are in snapshots
+        directory_fd = openat(p_diff->root_fd, p_item->path[0] ? p_item->path : ".", O_RDONLY | O_DIRECTORY | O_NOFOLLOW | O_CLOEXEC);
+
+        // Read the names of the entries
+        if ( directory_fd != -1 )
+        {
+
+            // Set up the listing
+            if ( path_listing_reserve(&listing, 1, true) == 0 ) goto no_mem;
+
+            // Read the directory into this worker's buffer
+            if ( path_directory_reader_open(&reader, directory_fd, &p_worker->p_buffer, &p_worker->buffer_size, 0) == 0 ) goto no_mem;
+
+            // Store each name
+            while ( path_directory_reader_next(&reader, &name, &d_type) )
+                if ( path_listing_append(&listing, name, strlen(name), PATH_TYPE_FILE) == 0 )
+                {
+                    (void) path_directory_reader_close(&reader);
+                    goto no_mem;
+                }
+
+            // Clean up
+            (void) path_directory_reader_close(&reader);
+
+            // A directory that stopped short would report its missing entries as removed
+            if ( reader.failed ) goto failed_to_read_directory;
+
+            // Skip the rest of the subtree if the directory is unchanged. The entries aren't stated
+            if ( 
+                trust                                                                                                 &&
+                listing.count == old_count                                                                            &&
+                fstat(directory_fd, &st) == 0                                                                         &&
+                st.st_mtim.tv_sec * 1000000000LL + st.st_mtim.tv_nsec == p_old->p_modified[p_item->old_index]
+            ) goto done;
+
+            // Stat each entry. Entries that disappear have no metadata
+            for (size_t k = 0; k < listing.count; k++)
+                if ( fstatat(directory_fd, &listing.p_names[listing.p_offsets[k]], &st, AT_SYMLINK_NOFOLLOW) == 0 )
+                    path_metadata_from_stat(&st, &listing.p_metadata[k]);
+
+            // Sort the contents by name
+            if ( path_listing_sort(&listing) == 0 ) goto no_mem;
+        }
+
+        // Store the quantity of entries
+        new_count = listing.count;
+    }
+
+    // Merge the contents of both directories, in order of name
+    while ( i < old_count || j < new_count )
     {
 
         // Initialized data
-        size_t  directory_item_count = 0,
-                _path_len = strlen(_path);
-        char   *directory_name       = 0;
-        dict   *directory_dict       = 0;
+        const char *old_name   = 0,
+                   *new_name   = 0,
+                   *path_text  = 0;
+        int         comparison = 0;
 
-        // Copy the name
+        // Stop early
+        if ( __atomic_load_n(&p_pool->abort, __ATOMIC_RELAXED) ) break;
+
+        // Get the next old entry
+        if ( i < old_count )
         {
+            old_name = path_snapshot_name(p_old, old_first + i);
+            if ( old_name == (void *) 0 ) goto invalid_snapshot;
+            path_snapshot_metadata(p_old, old_first + i, &old_metadata);
+        }
 
-            // Initialized data
-            // TODO: This could be better optimized
-            char   *after_backsl = strrchr(_path, '\\'),
-                   *after_fwdsl  = strrchr(_path, '/'),
-                   *after_sl     = 1 + ( after_backsl > after_fwdsl ) ? after_fwdsl : after_backsl;
-            size_t  len          = strlen(after_sl)-1;
-            
-            trim:
-            if ( len == 0 )
+        // Get the next new entry
+        if ( j < new_count )
+        {
+
+            // From the new snapshot
+            if ( p_new )
             {
-                *after_sl = '\0';
-                after_backsl = strrchr(_path, '\\'),
-                after_fwdsl  = strrchr(_path, '/'),
-                after_sl     = ( after_backsl < after_fwdsl ) ? after_fwdsl : after_backsl;
-                len          = strlen(after_sl) - 1; 
-                goto trim;
+                new_name = path_snapshot_name(p_new, new_first + j);
+                if ( new_name == (void *) 0 ) goto invalid_snapshot;
+                path_snapshot_metadata(p_new, new_first + j, &new_metadata);
             }
 
-            // Allocate memory for name
-            directory_name = PATH_REALLOC(0, sizeof(char) * ( len + 1 )); // Don't need to allocate a null terminator
+            // From the live tree
+            else
+            {
 
-            // Error check
-            if ( directory_name == (void *) 0 ) goto no_mem;
-            
-            // Copy the name
-            strncpy(directory_name, after_sl+1, len);
+                // Skip entries that disappeared
+                if ( listing.p_metadata[j].type == 0 ) { j++; continue; }
 
-            // Write a null terminator
-            directory_name[len] = '\0';
+                // Store the entry
+                new_name     = &listing.p_names[listing.p_offsets[j]];
+                new_metadata = listing.p_metadata[j];
+            }
         }
 
-        // Copy the full path
-        {
-            
-            // Allocate memory for the full path string
-            full_path = PATH_REALLOC(0, sizeof(char) * ( _path_len + 1024 ));
-
-            // Error check
-            if ( full_path == (void *) 0 ) goto no_mem;
-            
-            // Copy the full path
-            strncpy(full_path, _path, _path_len);
+        // Compare the names. A missing entry sorts last
+        comparison = ( old_name == (void *) 0 ) ?  1 :
+                     ( new_name == (void *) 0 ) ? -1 : strcmp(old_name, new_name);
 
-            // Write a null terminator
-            full_path[_path_len] = '\0';
-        }   
+        // Make the path of the entry, relative to the roots
+        if ( path_worker_text(p_worker, p_item->path, ( comparison > 0 ) ? new_name : old_name) == 0 ) goto no_mem;
+        path_text = p_item->path[0] ? p_worker->p_text : p_worker->p_text + 1;
 
-        // Construct paths from the directory contents
+        // Removed
+        if ( comparison < 0 )
         {
+            if ( path_diff_record_add(p_diff, PATH_DIFF_REMOVED, path_text, &old_metadata) == 0 ) goto no_mem;
+            i++;
+        }
 
-            // Open the directory
-            p_directory = opendir(full_path);
+        // Added
+        else if ( comparison > 0 )
+        {
+            if ( path_diff_record_add(p_diff, PATH_DIFF_ADDED, path_text, &new_metadata) == 0 ) goto no_mem;
+            j++;
+        }
 
-            // Error check
-            if ( p_directory == NULL ) goto path_not_found;
-            
-            // Skip "."
-            p_file_directory_entry = readdir(p_directory);
+        // The entry is in both trees, but its type changed
+        else if ( ( old_metadata.mode & S_IFMT ) != ( new_metadata.mode & S_IFMT ) )
+        {
+            if ( path_diff_record_add(p_diff, PATH_DIFF_REMOVED, path_text, &old_metadata) == 0 ) goto no_mem;
+            if ( path_diff_record_add(p_diff, PATH_DIFF_ADDED,   path_text, &new_metadata) == 0 ) goto no_mem;
+            i++, j++;
+        }
 
-            // Skip ".."
-            p_file_directory_entry = readdir(p_directory);
+        // The entry is in both trees
+        else
+        {
 
-            dict_construct(&directory_dict, 32);
+            // Report modifications
+            if ( path_diff_changed(&old_metadata, &new_metadata) ) p_diff->pfn_diff(PATH_DIFF_MODIFIED, path_text, path_text, &old_metadata, &new_metadata, p_diff->p_context);
 
-            // Iterate over each path
-            while ( ( p_file_directory_entry = readdir(p_directory) ) )
+            // Compare the contents of directories in their own task
+            if ( ( old_metadata.mode & S_IFMT ) == S_IFDIR )
             {
 
                 // Initialized data
-                path *i_path = PATH_REALLOC(0, sizeof(path));
+                size_t          path_len = strlen(path_text);
+                path_diff_item *p_child  = PATH_REALLOC(0, sizeof(path_diff_item) + path_len + 1);
 
                 // Error check
-                if ( i_path == (void *) 0 ) goto no_mem;
+                if ( p_child == (void *) 0 ) goto no_mem;
 
-                // Zero set
-                memset(i_path, 0, sizeof(path));
+                // Populate the child
+                *p_child = (path_diff_item) { .old_index = old_first + i, .new_index = new_first + j };
+                memcpy(p_child->path, path_text, path_len + 1);
 
-                // Build the path 
-                sprintf(full_path, "%s/%s", path_string, p_file_directory_entry->d_name);
+                // Queue the child
+                if ( path_pool_push(p_worker, path_diff_task, p_child) == 0 )
+                {
+                    (void) PATH_REALLOC(p_child, 0);
+                    goto no_mem;
+                }
+            }
 
-                // Parse the path as a directory
-                if ( (st.st_mode & S_IFMT) == S_IFDIR ) dict_add(directory_dict, full_path, (void *)PATH_TYPE_DIRECTORY);
+            // Next entries
+            i++, j++;
+        }
+    }
 
-                // Parse the path as a file
-                else dict_add(directory_dict, full_path, (void *)PATH_TYPE_FILE);
-                
-            }
+    done:
 
-            // Write a null terminator
-            full_path[_path_len] = '\0';
+    // Clean up
+    if ( directory_fd != -1 ) (void) close(directory_fd);
+    (void) path_listing_destroy(&listing);
+    (void) PATH_REALLOC(p_item, 0);
+
+    // Done
+    return;
+
+    // Error handling
+    {
+
+        // path errors
+        {
+            invalid_snapshot:
+                #ifndef NDEBUG
+                    printf("[path] Corrupt snapshot in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Stop the diff
+                p_diff->failed = true;
+                path_pool_fail(p_pool);
+
+                // Clean up
+                goto done;
         }
 
-        // Populate the path struct
-        *p_path = (path)
+        // Standard library errors
         {
-            .full_path = full_path,
-            .name      = directory_name,
-            .type      = PATH_TYPE_DIRECTORY,
-            .directory = directory_dict
-        };
+            failed_to_read_directory:
+                #ifndef NDEBUG
+                    printf("[path] Failed to read directory \"%s\" in call to function \"%s\"\n", p_item->path, __FUNCTION__);
+                #endif
+
+                // Stop the diff
+                p_diff->failed = true;
+                path_pool_fail(p_pool);
+
+                // Clean up
+                goto done;
+
+            no_mem:
+                #ifndef NDEBUG
+                    printf("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Stop the diff
+                p_diff->failed = true;
+                path_pool_fail(p_pool);
+
+                // Clean up
+                goto done;
+        }
     }
+}
 
-    // Parse the path as a file
-    else if ( (st.st_mode & S_IFMT) == S_IFREG )
+int path_diff_run ( path_diff_context *p_diff, size_t thread_count )
+{
+
+    // Initialized data
+    path_diff_item    *p_root     = PATH_REALLOC(0, sizeof(path_diff_item) + 1);
+    path_diff_record **pp_removed = 0;
+    size_t             removed    = 0;
+
+    // Error check
+    if ( p_root == (void *) 0 ) goto no_mem;
+
+    // Construct a lock for the records
+    if ( mutex_create(&p_diff->_lock) == 0 )
     {
+        (void) PATH_REALLOC(p_root, 0);
+        goto failed_to_create_mutex;
+    }
 
-        // Initialized data
-        char *full_path = 0;
-        char *file_name = 0;
+    // Populate the root
+    *p_root = (path_diff_item) { .old_index = 0, .new_index = 0 };
+    p_root->path[0] = '\0';
 
-        // Copy the name
-        {
+    // Compare the trees
+    if ( path_pool_run(thread_count, path_diff_task, p_root, p_diff) == 0 ) p_diff->failed = true;
 
-            // Initialized data
-            // TODO: This could be better optimized
-            char   *after_backsl = strrchr(_path, '\\'),
-                   *after_fwdsl  = strrchr(_path, '/'),
-                   *after_sl     = 1 + ( after_backsl > after_fwdsl ) ? after_fwdsl : after_backsl;
-            size_t  len          = strlen(after_sl)-1;
-            
-            // Allocate memory for the file name
-            file_name = PATH_REALLOC(0, ( len + 1 ) * sizeof(char));
+    // Error check
+    if ( p_diff->failed ) goto done;
 
-            // Error check
-            if ( file_name == (void *) 0 ) goto no_mem;
-            
-            // Copy the name
-            strncpy(file_name, after_sl+1, len);
+    // Order the records by path
+    if ( p_diff->record_count ) qsort(p_diff->p_records, p_diff->record_count, sizeof(path_diff_record), path_diff_record_compare_path);
 
-            // Write a null terminator
-            file_name[len] = '\0';
-        }
+    // Gather the removed entries, ordered by inode
+    pp_removed = PATH_REALLOC(0, ( p_diff->record_count + 1 ) * sizeof(path_diff_record *));
 
-        // Copy the full path
-        {
+    // Error check
+    if ( pp_removed == (void *) 0 ) goto no_mem;
 
-            // Initialized data
-            size_t len = strlen(_path);
+    for (size_t i = 0; i < p_diff->record_count; i++)
+        if ( p_diff->p_records[i].kind == PATH_DIFF_REMOVED && p_diff->p_records[i].metadata.inode ) pp_removed[removed++] = &p_diff->p_records[i];
 
-            // Allocate memory for the full path string
-            full_path = PATH_REALLOC(0, sizeof(char) * ( len + 1 ));
+    if ( removed ) qsort(pp_removed, removed, sizeof(path_diff_record *), path_diff_record_compare_inode);
 
-            // Error check
-            if ( full_path == (void *) 0 ) goto no_mem;
-            
-            // Copy the full path
-            strncpy(full_path, _path, len);
+    // Report each entry that was added, or renamed
+    for (size_t i = 0; i < p_diff->record_count; i++)
+    {
 
-            // Write a null terminator
-            full_path[len] = '\0';
-        }   
+        // Initialized data
+        path_diff_record *p_added = &p_diff->p_records[i],
+                         *p_match = 0;
+        size_t            lo      = 0,
+                          hi      = removed;
 
-        // Populate the path struct
-        *p_path = (path)
+        // Only added entries
+        if ( p_added->kind != PATH_DIFF_ADDED ) continue;
+
+        // Binary search for the first removed entry with the same inode
+        while ( lo < hi )
         {
-            .full_path = full_path,
-            .name      = file_name,
-            .type      = PATH_TYPE_FILE,
-            .file      = st.st_size
-        };
-    }
-    #endif
 
-*/
+            // Initialized data
+            size_t mid = lo + ( hi - lo ) / 2;
 
-const char *path_name_text ( const path *const p_path )
-{
+            // Halve the range
+            if ( pp_removed[mid]->metadata.inode < p_added->metadata.inode ) lo = mid + 1;
+            else hi = mid;
+        }
 
-    // Argument check
-    if ( p_path == (void *) 0 ) goto no_path;
+        // Find a removed entry of the same type, that isn't already part of a rename
+        for (; lo < removed && pp_removed[lo]->metadata.inode == p_added->metadata.inode; lo++)
+            if ( pp_removed[lo]->paired == false && ( pp_removed[lo]->metadata.mode & S_IFMT ) == ( p_added->metadata.mode & S_IFMT ) )
+            {
+                p_match = pp_removed[lo];
+                break;
+            }
+
+        // Renamed
+        if ( p_match )
+        {
+            p_match->paired = p_added->paired = true;
+            p_diff->pfn_diff(PATH_DIFF_RENAMED, p_match->path, p_added->path, &p_match->metadata, &p_added->metadata, p_diff->p_context);
+        }
+
+        // Added
+        else
+            p_diff->pfn_diff(PATH_DIFF_ADDED, 0, p_added->path, 0, &p_added->metadata, p_diff->p_context);
+    }
+
+    // Report each entry that was removed, and not renamed
+    for (size_t i = 0; i < p_diff->record_count; i++)
+        if ( p_diff->p_records[i].kind == PATH_DIFF_REMOVED && p_diff->p_records[i].paired == false )
+            p_diff->pfn_diff(PATH_DIFF_REMOVED, p_diff->p_records[i].path, 0, &p_diff->p_records[i].metadata, 0, p_diff->p_context);
 
-    // 
-    if ( p_path->full_path.dirty ) path_update_full_path( p_path );
+    done:
 
-    // Success
-    return p_path->full_path.text_name;
+    // Clean up
+    for (size_t i = 0; i < p_diff->record_count; i++) (void) PATH_REALLOC(p_diff->p_records[i].path, 0);
+    if ( p_diff->p_records ) (void) PATH_REALLOC(p_diff->p_records, 0);
+    if ( pp_removed ) (void) PATH_REALLOC(pp_removed, 0);
+    mutex_destroy(&p_diff->_lock);
+
+    // Done
+    return ( p_diff->failed == false );
 
     // Error handling
     {
 
-        // Argument errors
+        // sync errors
         {
-            no_path:
+            failed_to_create_mutex:
                 #ifndef NDEBUG
-                    printf("[path] Null pointer provided for parameter \"p_path\" in call to function \"%s\"\n", __FUNCTION__);
+                    printf("[sync] Failed to create mutex in call to function \"%s\"\n", __FUNCTION__);
                 #endif
 
                 // Error
                 return 0;
         }
-    }
-}
-
-path_type path_type_path ( const path *const p_path )
-{
-
-    // Argument check
-    if ( p_path == (void *) 0 ) goto no_path;
-
-    // Success
-    return p_path->type;
 
-    // Error handling
-    {
-
-        // Argument errors
+        // Standard library errors
         {
-            no_path:
+            no_mem:
                 #ifndef NDEBUG
-                    printf("[path] Null pointer provided for parameter \"p_path\" in call to function \"%s\"\n", __FUNCTION__);
+                    printf("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
                 #endif
 
-                // Error
-                return 0;
+                // The root wasn't allocated
+                if ( p_root == (void *) 0 ) return 0;
+
+                // Clean up
+                p_diff->failed = true;
+                goto done;
         }
     }
 }
 
-const char *path_full_path_text ( const path *const p_path )
+int path_diff ( const path_snapshot *const p_old, const path_snapshot *const p_new, size_t thread_count, int flags, fn_path_diff pfn_diff, void *p_context )
 {
 
     // Argument check
-    if ( p_path == (void *) 0 ) goto no_path;
-
-    // State check
-    if ( p_path->full_path.dirty == false ) 
-        if ( path_update_full_path(p_path) == 0 )
-            goto failed_to_update_full_path; 
+    if ( p_old    == (void *) 0 ) goto no_old;
+    if ( p_new    == (void *) 0 ) goto no_new;
+    if ( pfn_diff == (void *) 0 ) goto no_diff;
 
-    // Success
-    return p_path->full_path.text;
+    // Initialized data
+    path_diff_context diff = { .p_old = p_old, .p_new = p_new, .root_fd = -1, .flags = flags, .pfn_diff = pfn_diff, .p_context = p_context };
 
-    failed_to_update_full_path:
+    // Compare the snapshots
+    if ( path_diff_run(&diff, thread_count) == 0 ) goto failed_to_diff;
 
-    // Error
-    return 0;
+    // Success
+    return 1;
 
     // Error handling
     {
 
         // Argument errors
         {
-            no_path:
+            no_old:
                 #ifndef NDEBUG
-                    printf("[path] Null pointer provided for parameter \"p_path\" in call to function \"%s\"\n", __FUNCTION__);
+                    printf("[path] Null pointer provided for parameter \"p_old\" in call to function \"%s\"\n", __FUNCTION__);
                 #endif
 
                 // Error
                 return 0;
-        }
-    }
-}
 
-bool path_is_file ( const path * const p_path )
-{
+            no_new:
+                #ifndef NDEBUG
+                    printf("[path] Null pointer provided for parameter \"p_new\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
 
-    // Argument check
-    if ( p_path == (void *) 0 ) goto no_path;
+                // Error
+                return 0;
 
-    // Success
-    return ( p_path->type == PATH_TYPE_FILE) ? true : false;
+            no_diff:
+                #ifndef NDEBUG
+                    printf("[path] Null pointer provided for parameter \"pfn_diff\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
 
-    // Error handling
-    {
+                // Error
+                return 0;
+        }
 
-        // Argument errors
+        // path errors
         {
-            no_path:
+            failed_to_diff:
                 #ifndef NDEBUG
-                    printf("[path] Null pointer provided for parameter \"p_path\" in call to function \"%s\"\n", __FUNCTION__);
+                    printf("[path] Failed to compare snapshots in call to function \"%s\"\n", __FUNCTION__);
                 #endif
 
                 // Error
@@ -947,21 +10463,32 @@ bool path_is_file ( const path * const p_path )
     }
 }
 
-int path_file_size ( const path *const p_path, size_t *p_size_in_bytes )
+int path_diff_live ( const path_snapshot *const p_old, const path *const p_path, size_t thread_count, int flags, fn_path_diff pfn_diff, void *p_context )
 {
-    
+
     // Argument check
-    if ( p_path          == (void *) 0 ) goto no_path;
-    if ( p_size_in_bytes == (void *) 0 ) goto no_size_in_bytes;
+    if ( p_old    == (void *) 0 ) goto no_old;
+    if ( p_path   == (void *) 0 ) goto no_path;
+    if ( pfn_diff == (void *) 0 ) goto no_diff;
 
-    // Error checking
-    if ( p_path->type != PATH_TYPE_FILE ) goto wrong_path_type;
+    // Initialized data
+    path_diff_context diff = { .p_old = p_old, .p_new = 0, .root_fd = -1, .flags = flags, .pfn_diff = pfn_diff, .p_context = p_context };
+    int               result = 0;
 
-    // State checking
-    if ( p_path->data.dirty == true ) path_update_data(p_path);
+    // Open the root of the live tree
+    diff.root_fd = open(p_path->full_path.text, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
 
-    // Return
-    *p_size_in_bytes = p_path->data.file;
+    // Error check
+    if ( diff.root_fd == -1 ) goto failed_to_open;
+
+    // Compare the snapshot to the live tree
+    result = path_diff_run(&diff, thread_count);
+
+    // Clean up
+    (void) close(diff.root_fd);
+
+    // Error check
+    if ( result == 0 ) goto failed_to_diff;
 
     // Success
     return 1;
@@ -971,6 +10498,14 @@ int path_file_size ( const path *const p_path, size_t *p_size_in_bytes )
 
         // Argument errors
         {
+            no_old:
+                #ifndef NDEBUG
+                    printf("[path] Null pointer provided for parameter \"p_old\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
             no_path:
                 #ifndef NDEBUG
                     printf("[path] Null pointer provided for parameter \"p_path\" in call to function \"%s\"\n", __FUNCTION__);
@@ -979,20 +10514,31 @@ int path_file_size ( const path *const p_path, size_t *p_size_in_bytes )
                 // Error
                 return 0;
 
-            no_size_in_bytes:
+            no_diff:
                 #ifndef NDEBUG
-                    printf("[path] Null pointer provided for parameter \"p_size_in_bytes\" in call to function \"%s\"\n", __FUNCTION__);
+                    printf("[path] Null pointer provided for parameter \"pfn_diff\" in call to function \"%s\"\n", __FUNCTION__);
                 #endif
 
                 // Error
                 return 0;
         }
-    
-        // Path errors
+
+        // path errors
         {
-            wrong_path_type:
+            failed_to_diff:
                 #ifndef NDEBUG
-                    printf("[path] Parameter \"p_path\" was of wrong type in call to function \"%s\"\n", __FUNCTION__);
+                    printf("[path] Failed to compare snapshot to \"%s\" in call to function \"%s\"\n", p_path->full_path.text, __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // Standard library errors
+        {
+            failed_to_open:
+                #ifndef NDEBUG
+                    printf("[path] Failed to open \"%s\". %s in call to function \"%s\"\n", p_path->full_path.text, strerror(errno), __FUNCTION__);
                 #endif
 
                 // Error
@@ -1001,224 +10547,257 @@ int path_file_size ( const path *const p_path, size_t *p_size_in_bytes )
     }
 }
 
-dict *path_directory_contens ( const path *const p_path, const char **names )
+int path_hash_file ( const char *full_path, unsigned char *p_buffer, unsigned char *p_hash, unsigned long long *p_size )
 {
 
-    // Return
-    return p_path->data.directory;
-}
+    // Initialized data
+    sha256_state sha256 = { 0 };
+    struct stat  st     = { 0 };
+    off_t        offset = 0;
+    int          fd     = open(full_path, O_RDONLY | O_NOFOLLOW | O_NONBLOCK | O_CLOEXEC);
 
-size_t path_directory_content_types ( const path *const p_path, const path_type *const types )
-{
+    // Error check. Links aren't followed
+    if ( fd == -1 ) return 0;
 
-    // Return
-    return dict_values(p_path->data.directory, types );
-}
+    // Only regular files are hashed
+    if ( fstat(fd, &st) == -1 || S_ISREG(st.st_mode) == 0 ) goto failed;
 
-int path_navigate ( path **pp_path, const char *path_text )
-{
+    // The file is read once, front to back
+    (void) posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
 
-    // Argument check
-    if ( pp_path   == (void *) 0 ) goto no_path;
-    if ( path_text == (void *) 0 ) goto no_path_text;
-    if ( *pp_path  == (void *) 0 ) goto construct_path;
+    // Start the hash
+    sha256_init(&sha256);
 
-    // Navigate branch
+    // Read until the end of the file. Files aren't mapped, since a file truncated 
+    // while it is hashed would raise SIGBUS, where a read just ends early
+    for (;;)
     {
 
         // Initialized data
-        path *p_path = (void *) *pp_path;
-        
-        // Special cases
+        ssize_t n = pread(fd, p_buffer, PATH_HASH_BUFFER_SIZE, offset);
 
-        path_update_full_path(p_path);
-        if ( path_update_data(p_path) == 0 )
-            goto failed_to_navigate;
+        // Error check
+        if ( n == -1 && errno == EINTR ) continue;
+        if ( n == -1 ) goto failed;
 
+        // End of file
+        if ( n == 0 ) break;
 
-        // Maybe "." or ".." or invalid
-        if ( path_text[0] == '.' ) 
-        {
+        // Hash the data
+        sha256_update(&sha256, p_buffer, (size_t) n);
+        offset += n;
+    }
 
-            // ".."
-            if ( path_text[1] == '.' ) 
-            {
+    // Finish the hash
+    sha256_final(&sha256, p_hash);
+    *p_size = (unsigned long long) offset;
 
-                if ( path_text[2] == '/')
-                {
+    // Clean up
+    (void) close(fd);
 
-                }
-                else if ( path_text[2] == '\0')
-                {
-                    *(strrchr(p_path->full_path.text, '/')) = '\0';
+    // Success
+    return 1;
 
-                    {
-                        p_path->full_path.dirty = true;
-                        p_path->data.dirty = true;
+    failed:
 
-                        path_update_full_path(p_path);
-                        if ( path_update_data(p_path) == 0 )
-                            goto failed_to_navigate;
-                    }
+    // Clean up
+    (void) close(fd);
 
-                    // Success
-                    return 1;
-                }
-                else
-                    return 0;
-            }
-            else if ( path_text[1] == '\0' )
-            {
+    // Error
+    return 0;
+}
 
-            }
-        }
+void path_hash_queue_push ( path_hash_queue *p_queue, char *p_full_path )
+{
 
-        // Error check
-        if ( p_path->type != PATH_TYPE_DIRECTORY ) goto wrong_path_type;
+    // Wait for a free slot
+    semaphore_wait(&p_queue->free);
 
-        // Build the path
-        {
-            char *next_fwslash = strchr(path_text, '/');
+    // Store the path
+    mutex_lock(&p_queue->_lock);
+    p_queue->p_paths[p_queue->tail++ % PATH_HASH_QUEUE_SIZE] = p_full_path;
+    mutex_unlock(&p_queue->_lock);
+
+    // Wake a hashing thread
+    semaphore_signal(&p_queue->used);
+}
 
-            // Write a '/' and a null terminator
-            p_path->full_path.text[p_path->full_path.text_len + 0] = '/';
-            p_path->full_path.text[p_path->full_path.text_len + 1] = '\0';
+char *path_hash_queue_pop ( path_hash_queue *p_queue )
+{
 
-            strncpy(&p_path->full_path.text[p_path->full_path.text_len + 1], path_text, strlen(path_text));
-            
-            if ( next_fwslash == 0 )
-            {
-                p_path->full_path.dirty = true;
-                p_path->data.dirty = true;
+    // Initialized data
+    char *p_full_path = 0;
 
-                path_update_full_path(p_path);
-                if ( path_update_data(p_path) == 0 )
-                    goto failed_to_navigate;
+    // Wait for a path
+    semaphore_wait(&p_queue->used);
 
-                // Success
-                return 1;
-            }
-        }
+    // Take the path
+    mutex_lock(&p_queue->_lock);
+    p_full_path = p_queue->p_paths[p_queue->head++ % PATH_HASH_QUEUE_SIZE];
+    mutex_unlock(&p_queue->_lock);
 
-        path_built:;
-        
-        // Return
-        return path_navigate( pp_path, 0 );
-    }
+    // Wake a walker
+    semaphore_signal(&p_queue->free);
 
-    // Constructor branch
-    construct_path:
-    {
+    // Done
+    return p_full_path;
+}
 
-        // Initialized data
-        path   *p_path = 0;
-        size_t  path_text_len = strlen(path_text);
+path_walk_result path_hash_walk ( const char *full_path, path_type type, size_t depth, void *p_context )
+{
 
-        // Allocate a path
-        if ( path_create(&p_path) == 0 ) goto failed_to_allocate_path;
+    // Initialized data
+    path_hash_context *p_hash        = p_context;
+    size_t             full_path_len = 0;
+    char              *p_full_path   = 0;
 
-        // Allocate memory for path
-        p_path->full_path.text_max_len = 1024+1+path_text_len;
-        p_path->full_path.text = PATH_REALLOC(0, sizeof(char)*(p_path->full_path.text_max_len));
+    // Unused
+    (void) depth;
 
-        // Copy the string
-        strncpy(p_path->full_path.text, path_text, p_path->full_path.text_max_len);
+    // Only files are hashed. Links to directories are filtered by the hashing threads
+    if ( type != PATH_TYPE_FILE ) return PATH_WALK_CONTINUE;
 
-        p_path->full_path.dirty = true;
-        p_path->data.dirty = true;
+    // Copy the path
+    full_path_len = strlen(full_path);
+    p_full_path   = PATH_REALLOC(0, full_path_len + 1);
 
-        path_update_full_path(p_path);
-        if ( path_update_data(p_path) == 0 )
-            goto failed_to_navigate;
+    // Error check
+    if ( p_full_path == (void *) 0 ) goto no_mem;
 
-        // Return a pointer to the path
-        *pp_path = p_path;
+    // Queue the path
+    memcpy(p_full_path, full_path, full_path_len + 1);
+    path_hash_queue_push(&p_hash->queue, p_full_path);
 
-        // Success
-        return 1;
-    }
-    
-    failed_to_clear_dict:
-    path_not_found:
-    no_mem:
-    failed_to_allocate_path:
-    wrong_path_type:
+    // Done
+    return PATH_WALK_CONTINUE;
 
-    // Error
-    return 0;
-    
     // Error handling
     {
 
-        // Argument errors
+        // Standard library errors
         {
-            no_path:
+            no_mem:
                 #ifndef NDEBUG
-                    printf("[path] Null pointer provided for parameter \"pp_path\" in call to function \"%s\"\n", __FUNCTION__);
+                    printf("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
                 #endif
 
-                // Error
-                return 0;
-
-            no_path_text:
-                #ifndef NDEBUG
-                    printf("[path] Null pointer provided for parameter \"path_text\" in call to function \"%s\"\n", __FUNCTION__);
-                #endif
+                // Stop the walk
+                p_hash->failed = true;
 
                 // Error
-                return 0;
+                return PATH_WALK_STOP;
         }
-        
-        // path errors
-        {
-            failed_to_store_path:
-                #ifndef NDEBUG
-                    printf("[path] Failed to store path in call to function \"%s\"\n", __FUNCTION__);
-                #endif
+    }
+}
 
-                // Error
-                return 0;
+void *path_hash_worker ( void *p_argument )
+{
 
-            failed_to_navigate:
-                #ifndef NDEBUG
-                    printf("[path] Failed to navigate in call to function \"%s\"\n", __FUNCTION__);
-                #endif
+    // Initialized data
+    path_hash_context *p_hash   = p_argument;
+    unsigned char     *p_buffer = PATH_REALLOC(0, PATH_HASH_BUFFER_SIZE);
 
-                // Error
-                return 0;
+    // Hash each path, until a null pointer
+    for (char *p_full_path = 0; ( p_full_path = path_hash_queue_pop(&p_hash->queue) ); (void) PATH_REALLOC(p_full_path, 0))
+    {
+
+        // Initialized data
+        unsigned char      hash[PATH_HASH_SIZE] = { 0 };
+        unsigned long long size                 = 0;
+
+        // Without a buffer, drain the queue
+        if ( p_buffer == (void *) 0 ) 
+        {
+            p_hash->failed = true;
+            continue;
         }
+
+        // Hash the file, and report it. Files that can't be read are skipped
+        if ( path_hash_file(p_full_path, p_buffer, hash, &size) ) p_hash->pfn_hash(p_full_path, hash, size, p_hash->p_context);
     }
+
+    // Clean up
+    if ( p_buffer ) (void) PATH_REALLOC(p_buffer, 0);
+
+    // Done
+    return 0;
 }
 
-int path_create_file ( path *p_path, const char *file_name )
+int path_hash_tree ( const path *const p_path, size_t walker_count, size_t hasher_count, fn_path_hash pfn_hash, void *p_context )
 {
 
     // Argument check
-    if ( p_path    == (void *) 0 ) goto no_path;
-    if ( file_name == (void *) 0 ) goto no_file_name;
+    if ( p_path   == (void *) 0 ) goto no_path;
+    if ( pfn_hash == (void *) 0 ) goto no_hash;
 
     // Initialized data
-    int   snprintf_r                         = 0;
-    FILE *f                                  = 0;
-    char  _full_file_path[MAX_FILE_PATH_LEN] = { 0 };
+    path_hash_context  hash      = { .pfn_hash = pfn_hash, .p_context = p_context };
+    pthread_t         *p_threads = 0;
+    size_t             started   = 0;
+    int                result    = 1;
 
-    // Construct the file path
-    snprintf_r = snprintf( &_full_file_path, MAX_FILE_PATH_LEN, "%s/%s", p_path->full_path, file_name );
-                        
-    // Error checking
-    if ( snprintf_r > MAX_FILE_PATH_LEN ) goto buffer_not_big_enough;
-    
-    // Open the file
-    f = fopen(_full_file_path, "w+");
+    // Default to one hashing thread per processor
+    if ( hasher_count == 0 )
+    {
+
+        // Initialized data
+        long processors = sysconf(_SC_NPROCESSORS_ONLN);
+
+        // Store the thread count
+        hasher_count = ( processors > 0 ) ? (size_t) processors : 1;
+    }
+
+    // Construct the queue
+    if ( semaphore_create(&hash.queue.free, PATH_HASH_QUEUE_SIZE) == 0 ) goto failed_to_create_queue;
+    if ( semaphore_create(&hash.queue.used, 0) == 0 )
+    {
+        semaphore_destroy(&hash.queue.free);
+        goto failed_to_create_queue;
+    }
+    if ( mutex_create(&hash.queue._lock) == 0 )
+    {
+        semaphore_destroy(&hash.queue.free);
+        semaphore_destroy(&hash.queue.used);
+        goto failed_to_create_queue;
+    }
+
+    // Allocate memory for the hashing threads
+    p_threads = PATH_REALLOC(0, hasher_count * sizeof(pthread_t));
+
+    // Error check
+    if ( p_threads == (void *) 0 ) goto no_mem;
+
+    // Start the hashing threads
+    for (started = 0; started < hasher_count; started++)
+        if ( pthread_create(&p_threads[started], 0, path_hash_worker, &hash) != 0 ) break;
 
     // Error check
-    if ( f == 0 ) goto failed_to_open_file;
+    if ( started == 0 ) goto failed_to_start;
+
+    // Walk the tree, and queue each file
+    if ( p_path->type == PATH_TYPE_DIRECTORY )
+        result = path_walk(p_path, walker_count, path_hash_walk, &hash);
+
+    // A file is its own tree
+    else
+        (void) path_hash_walk(p_path->full_path.text, PATH_TYPE_FILE, 0, &hash);
+
+    // Stop each hashing thread
+    for (size_t i = 0; i < started; i++) path_hash_queue_push(&hash.queue, 0);
+
+    // Wait for the hashing threads
+    for (size_t i = 0; i < started; i++) (void) pthread_join(p_threads[i], 0);
+
+    done:
 
-    // Close the file
-    (void) fclose(f);
+    // Clean up
+    if ( p_threads ) (void) PATH_REALLOC(p_threads, 0);
+    semaphore_destroy(&hash.queue.free);
+    semaphore_destroy(&hash.queue.used);
+    mutex_destroy(&hash.queue._lock);
 
-    // Success
-    return 1;
+    // Done
+    return ( result && hash.failed == false );
 
     // Error handling
     {
@@ -1227,202 +10806,497 @@ int path_create_file ( path *p_path, const char *file_name )
         {
             no_path:
                 #ifndef NDEBUG
-                    printf("[path] Null pointer provided for parameter \"pp_path\" in call to function \"%s\"\n", __FUNCTION__);
+                    printf("[path] Null pointer provided for parameter \"p_path\" in call to function \"%s\"\n", __FUNCTION__);
                 #endif
 
                 // Error
                 return 0;
 
-            no_file_name:
+            no_hash:
                 #ifndef NDEBUG
-                    printf("[path] Null pointer provided for parameter \"file_name\" in call to function \"%s\"\n", __FUNCTION__);
+                    printf("[path] Null pointer provided for parameter \"pfn_hash\" in call to function \"%s\"\n", __FUNCTION__);
                 #endif
 
                 // Error
                 return 0;
         }
 
-        // Path errors
+        // sync errors
         {
-            buffer_not_big_enough:
+            failed_to_create_queue:
                 #ifndef NDEBUG
-                    printf("[path] Program has exceeded specified buffer size of \"%d\" in call to function \"%s\"\n       Considier increasing MAX_FILE_PATH_LEN, or refactoring", MAX_FILE_PATH_LEN, __FUNCTION__);
+                    printf("[sync] Failed to create queue in call to function \"%s\"\n", __FUNCTION__);
                 #endif
 
                 // Error
                 return 0;
         }
-    
+
         // Standard library errors
         {
-            failed_to_open_file:
+            failed_to_start:
                 #ifndef NDEBUG
-                    printf("[path] Failed to create file \"%s\" in call to function \"%s\"\n", _full_file_path, __FUNCTION__);
+                    printf("[Standard Library] Failed to start hashing threads in call to function \"%s\"\n", __FUNCTION__);
                 #endif
 
-                // Error
-                return 0;          
+                // Clean up
+                result = 0;
+                goto done;
+
+            no_mem:
+                #ifndef NDEBUG
+                    printf("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Clean up
+                result = 0;
+                goto done;
         }
     }
 }
 
-int path_create_directory( path *p_path, const char *directory_name )
+int path_hash_file_ends ( const char *full_path, unsigned long long size, unsigned char *p_buffer, unsigned char *p_hash )
 {
-    
-    // Argument check
-    if ( p_path         == (void *) 0 ) goto no_path;
-    if ( directory_name == (void *) 0 ) goto no_directory_name;
 
     // Initialized data
-    char  _full_file_path[MAX_FILE_PATH_LEN] = { 0 };
-    int   snprintf_r = 0;
-    FILE *f          = 0;
+    sha256_state sha256 = { 0 };
+    size_t       head   = ( size < PATH_DUPLICATE_PARTIAL_SIZE ) ? (size_t) size : PATH_DUPLICATE_PARTIAL_SIZE;
+    off_t        tail   = ( size > 2 * PATH_DUPLICATE_PARTIAL_SIZE ) ? (off_t) ( size - PATH_DUPLICATE_PARTIAL_SIZE ) : (off_t) head;
+    ssize_t      n      = 0;
+    int          fd     = open(full_path, O_RDONLY | O_NOFOLLOW | O_NONBLOCK | O_CLOEXEC);
 
-    // Construct the file path
-    snprintf_r = snprintf( &_full_file_path, MAX_FILE_PATH_LEN, "%s/%s", p_path->full_path, directory_name );
-                        
-    // Debug mode error checking
-    if ( snprintf_r > MAX_FILE_PATH_LEN ) goto buffer_not_big_enough;
-    
-    // Platform specific implementation
-    #ifdef _WIN64
-        ////////////////////////////
-        // Windows implementation //
-        ////////////////////////////
-    #else
+    // Error check
+    if ( fd == -1 ) return 0;
 
-        /////////////////////////
-        // UNIX implementation //
-        /////////////////////////
+    // Start the hash
+    sha256_init(&sha256);
 
-        // Make a directory
-        if ( mkdir(&_full_file_path, 777) != 0 ) goto failed_to_create_directory;
+    // Hash the start of the file
+    n = pread(fd, p_buffer, head, 0);
+    if ( n != (ssize_t) head ) goto failed;
+    sha256_update(&sha256, p_buffer, head);
 
-    #endif
+    // Hash the end of the file. Files no larger than both ends are hashed in full
+    n = pread(fd, p_buffer, (size_t) ( size - (unsigned long long) tail ), tail);
+    if ( n != (ssize_t) ( size - (unsigned long long) tail ) ) goto failed;
+    sha256_update(&sha256, p_buffer, (size_t) n);
+
+    // Finish the hash
+    sha256_final(&sha256, p_hash);
+
+    // Clean up
+    (void) close(fd);
 
     // Success
     return 1;
 
-    // Error handling
+    failed:
+
+    // Clean up
+    (void) close(fd);
+
+    // Error
+    return 0;
+}
+
+void path_duplicates_task ( path_worker *p_worker, void *p_argument )
+{
+
+    // Initialized data
+    path_pool              *p_pool       = p_worker->p_pool;
+    path_duplicate_context *p_dup        = p_pool->p_context;
+    path_walk_item         *p_item       = p_argument;
+    path_directory_reader   reader       = { 0 };
+    struct stat             st           = { 0 };
+    int                     directory_fd = -1;
+    const char             *name         = 0;
+    unsigned char           d_type       = 0;
+
+    // Don't start new work after the search is stopped
+    if ( __atomic_load_n(&p_pool->abort, __ATOMIC_ACQUIRE) ) goto done;
+
+    // Open the directory. Unreadable directories are skipped
+    if ( path_walk_item_open(p_item) == 0 ) goto done;
+
+    // Store the directory
+    directory_fd = p_item->fd;
+
+    // Read the directory into this worker's buffer
+    if ( path_directory_reader_open(&reader, directory_fd, &p_worker->p_buffer, &p_worker->buffer_size, 0) == 0 ) goto done;
+
+    // Iterate over each entry
+    while ( path_directory_reader_next(&reader, &name, &d_type) )
     {
 
-        // Argument errors
+        // Stop early
+        if ( __atomic_load_n(&p_pool->abort, __ATOMIC_RELAXED) ) break;
+
+        // Only directories and regular files matter
+        if ( d_type != DT_DIR && d_type != DT_REG && d_type != DT_UNKNOWN ) continue;
+
+        // Stat the entry. Symbolic links aren't followed
+        if ( fstatat(directory_fd, name, &st, AT_SYMLINK_NOFOLLOW) == -1 ) continue;
+
+        // Make the full path of the entry
+        if ( path_worker_text(p_worker, p_item->full_path, name) == 0 ) goto no_mem;
+
+        // Search the directory in its own task
+        if ( S_ISDIR(st.st_mode) )
         {
-            no_path:
-                #ifndef NDEBUG
-                    printf("[path] Null pointer provided for parameter \"pp_path\" in call to function \"%s\"\n", __FUNCTION__);
-                #endif
 
-                // Error
-                return 0;
+            // Initialized data
+            path_walk_item *p_child = path_walk_item_create(p_item, p_worker->p_text);
 
-            no_directory_name:
-                #ifndef NDEBUG
-                    printf("[path] Null pointer provided for parameter \"directory_name\" in call to function \"%s\"\n", __FUNCTION__);
-                #endif
+            // Error check
+            if ( p_child == (void *) 0 ) goto no_mem;
 
-                // Error
-                return 0;
+            // Queue the child
+            if ( path_pool_push(p_worker, path_duplicates_task, p_child) == 0 )
+            {
+                (void) __atomic_sub_fetch(&p_item->pending, 1, __ATOMIC_RELAXED);
+                (void) PATH_REALLOC(p_child, 0);
+                goto no_mem;
+            }
+
+            // Next entry
+            continue;
         }
 
-        // Path errors
+        // Remember regular files that are large enough. Empty files are never duplicates
+        if ( S_ISREG(st.st_mode) && st.st_size > 0 && (unsigned long long) st.st_size >= p_dup->minimum_size )
         {
-            buffer_not_big_enough:
-                #ifndef NDEBUG
-                    printf("[path] Program has exceeded specified buffer size of \"%d\" in call to function \"%s\"\n       Considier increasing MAX_FILE_PATH_LEN, or refactoring", MAX_FILE_PATH_LEN, __FUNCTION__);
-                #endif
 
-                // Error
-                return 0;
+            // Initialized data
+            size_t  full_path_len = strlen(p_worker->p_text);
+            char   *p_full_path   = PATH_REALLOC(0, full_path_len + 1);
+
+            // Error check
+            if ( p_full_path == (void *) 0 ) goto no_mem;
+
+            // Copy the path
+            memcpy(p_full_path, p_worker->p_text, full_path_len + 1);
+
+            // Lock
+            mutex_lock(&p_dup->_lock);
+
+            // Grow the files
+            if ( p_dup->file_count == p_dup->file_max )
+            {
+
+                // Initialized data
+                size_t               file_max = p_dup->file_max ? p_dup->file_max * 2 : 1024;
+                path_duplicate_file *p_files  = PATH_REALLOC(p_dup->p_files, file_max * sizeof(path_duplicate_file));
+
+                // Error check
+                if ( p_files == (void *) 0 )
+                {
+                    mutex_unlock(&p_dup->_lock);
+                    (void) PATH_REALLOC(p_full_path, 0);
+                    goto no_mem;
+                }
+
+                // Store the files
+                p_dup->p_files  = p_files;
+                p_dup->file_max = file_max;
+            }
+
+            // Store the file
+            p_dup->p_files[p_dup->file_count++] = (path_duplicate_file)
+            {
+                .size      = (unsigned long long) st.st_size,
+                .device    = (unsigned long long) st.st_dev,
+                .inode     = (unsigned long long) st.st_ino,
+                .full_path = p_full_path
+            };
+
+            // Unlock
+            mutex_unlock(&p_dup->_lock);
         }
-    
+    }
+
+    // A directory that stopped short could hide a duplicate
+    if ( reader.failed ) p_dup->failed = true;
+
+    // Clean up
+    (void) path_directory_reader_close(&reader);
+
+    done:
+
+    // Release the directory. It is closed once each child has opened itself
+    path_walk_item_release(p_item);
+
+    // Done
+    return;
+
+    // Error handling
+    {
+
         // Standard library errors
         {
-            failed_to_open_file:
+            no_mem:
                 #ifndef NDEBUG
-                    printf("[path] Failed to create file \"%s\" in call to function \"%s\"\n", _full_file_path, __FUNCTION__);
+                    printf("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
                 #endif
 
-                // Error
-                return 0;
+                // Stop the search
+                p_dup->failed = true;
+                path_pool_fail(p_pool);
 
-            failed_to_create_directory:
-                #ifndef NDEBUG
-                    printf("[path] Failed to create directory \"%s\" in call to function \"%s\"\n", directory_name, __FUNCTION__);
-                #endif
+                // Clean up
+                (void) path_directory_reader_close(&reader);
+                goto done;
+        }
+    }
+}
 
-                // Error
-                return 0;          
+int path_duplicate_compare_inode ( const void *p_a, const void *p_b )
+{
+
+    // Initialized data
+    const path_duplicate_file *p_file_a = p_a,
+                              *p_file_b = p_b;
+
+    // Order by size, then by device and inode
+    if ( p_file_a->size   != p_file_b->size   ) return ( p_file_a->size   < p_file_b->size   ) ? -1 : 1;
+    if ( p_file_a->device != p_file_b->device ) return ( p_file_a->device < p_file_b->device ) ? -1 : 1;
+    if ( p_file_a->inode  != p_file_b->inode  ) return ( p_file_a->inode  < p_file_b->inode  ) ? -1 : 1;
+
+    // Then by path, so the same name of a hard linked file is always kept
+    return strcmp(p_file_a->full_path, p_file_b->full_path);
+}
+
+int path_duplicate_compare_hash ( const void *p_a, const void *p_b )
+{
+
+    // Initialized data
+    const path_duplicate_file *p_file_a   = p_a,
+                              *p_file_b   = p_b;
+    int                        comparison = 0;
+
+    // Candidates first
+    if ( p_file_a->candidate != p_file_b->candidate ) return p_file_a->candidate ? -1 : 1;
+
+    // Order by size, then by hash, then by path
+    if ( p_file_a->size != p_file_b->size ) return ( p_file_a->size < p_file_b->size ) ? -1 : 1;
+    comparison = memcmp(p_file_a->hash, p_file_b->hash, PATH_HASH_SIZE);
+    return comparison ? comparison : strcmp(p_file_a->full_path, p_file_b->full_path);
+}
+
+size_t path_duplicate_mark ( path_duplicate_context *p_dup, bool by_hash )
+{
+
+    // Initialized data
+    size_t candidates = 0;
+
+    // Mark each file that shares its size, and hash, with a neighbour. Files are sorted
+    for (size_t i = 0, j = 0; i < p_dup->file_count; i = j)
+    {
+
+        // Initialized data
+        bool candidate = p_dup->p_files[i].candidate;
+
+        // Find the end of the group
+        for (j = i + 1; j < p_dup->file_count; j++)
+        {
+
+            // Initialized data
+            const path_duplicate_file *p_first = &p_dup->p_files[i],
+                                      *p_file  = &p_dup->p_files[j];
+
+            // Different group
+            if ( p_file->candidate != p_first->candidate || p_file->size != p_first->size ) break;
+            if ( by_hash && memcmp(p_file->hash, p_first->hash, PATH_HASH_SIZE) ) break;
         }
+
+        // Mark the group
+        for (size_t k = i; k < j; k++) p_dup->p_files[k].candidate = candidate && ( j - i > 1 );
+
+        // Count the candidates
+        if ( candidate && j - i > 1 ) candidates += j - i;
     }
+
+    // Done
+    return candidates;
 }
 
-int path_remove ( path *p_path, const char *path_name )
+void *path_duplicate_hash_worker ( void *p_argument )
 {
 
+    // Initialized data
+    path_duplicate_context *p_dup    = p_argument;
+    unsigned char          *p_buffer = PATH_REALLOC(0, PATH_HASH_BUFFER_SIZE);
+
+    // Error check
+    if ( p_buffer == (void *) 0 )
+    {
+        p_dup->failed = true;
+        return 0;
+    }
 
+    // Take files until there are none left
+    for (size_t i = 0; ( i = __atomic_fetch_add(&p_dup->next, 1, __ATOMIC_RELAXED) ) < p_dup->file_count; )
+    {
 
-    // Success
-    return 1;
+        // Initialized data
+        path_duplicate_file *p_file = &p_dup->p_files[i];
+        unsigned long long   size   = 0;
+
+        // Only candidates are hashed
+        if ( p_file->candidate == false ) continue;
+
+        // Files no larger than both ends were hashed in full already
+        if ( p_dup->full && p_file->size <= 2 * PATH_DUPLICATE_PARTIAL_SIZE ) continue;
+
+        // Hash the file. Files that can't be read, or changed size, have no duplicates
+        if ( p_dup->full )
+            p_file->candidate = path_hash_file(p_file->full_path, p_buffer, p_file->hash, &size) && size == p_file->size;
+        else
+            p_file->candidate = path_hash_file_ends(p_file->full_path, p_file->size, p_buffer, p_file->hash);
+    }
+
+    // Clean up
+    (void) PATH_REALLOC(p_buffer, 0);
+
+    // Done
+    return 0;
 }
 
-size_t path_directory_content_names ( const path *const p_path, const char **const names )
+void path_duplicate_hash ( path_duplicate_context *p_dup, bool full, size_t thread_count )
 {
-    return dict_keys(p_path->data.directory, names);
+
+    // Initialized data
+    pthread_t *p_threads = PATH_REALLOC(0, thread_count * sizeof(pthread_t));
+    size_t     started   = 0;
+
+    // Set up the stage
+    p_dup->full = full;
+    p_dup->next = 0;
+
+    // Start a thread for each worker, except the first. The caller's thread is the first worker
+    if ( p_threads )
+        for (started = 1; started < thread_count; started++)
+            if ( pthread_create(&p_threads[started], 0, path_duplicate_hash_worker, p_dup) != 0 ) break;
+
+    // Work
+    (void) path_duplicate_hash_worker(p_dup);
+
+    // Wait for the other workers
+    for (size_t i = 1; i < started; i++) (void) pthread_join(p_threads[i], 0);
+
+    // Clean up
+    if ( p_threads ) (void) PATH_REALLOC(p_threads, 0);
 }
 
-int path_directory_foreach_i ( const path *const p_path, void (*pfn_path_iter)(const char *full_path, path_type type, size_t i))
+int path_find_duplicates ( const path *const p_path, size_t thread_count, unsigned long long minimum_size, fn_path_duplicates pfn_duplicates, void *p_context )
 {
 
     // Argument check
-    if ( p_path        == (void *) 0 ) goto no_path;
-    if ( pfn_path_iter == (void *) 0 ) goto no_path_iter;
+    if ( p_path         == (void *) 0 ) goto no_path;
+    if ( pfn_duplicates == (void *) 0 ) goto no_duplicates;
 
     // Initialized data
-    size_t directory_content_count = 0;
-    const char ** pp_path_names = 0;
-    const path_type *pp_path_types = 0;
+    path_duplicate_context   dup      = { .minimum_size = minimum_size };
+    path_walk_item          *p_root   = 0;
+    const char             **pp_paths = 0;
+    size_t                   kept     = 0;
 
     // Error checking
     if ( p_path->type != PATH_TYPE_DIRECTORY ) goto path_is_not_a_directory;
 
-    // Get the quantity of contents in the directory
-    directory_content_count = path_directory_content_names(p_path, 0);
+    // Default to one thread per processor
+    if ( thread_count == 0 )
+    {
+
+        // Initialized data
+        long processors = sysconf(_SC_NPROCESSORS_ONLN);
+
+        // Store the thread count
+        thread_count = ( processors > 0 ) ? (size_t) processors : 1;
+    }
 
-    // State check
-    if ( directory_content_count == 0 ) return 1;
+    // Construct a lock for the files
+    if ( mutex_create(&dup._lock) == 0 ) goto failed_to_create_mutex;
 
-    // Allocate memory for path names 
-    pp_path_names = PATH_REALLOC(0, directory_content_count * sizeof(const char *));
+    // Make the root
+    p_root = path_walk_item_create(0, p_path->full_path.text);
 
-    // Allocate memory for path types
-    pp_path_types =  PATH_REALLOC(0, directory_content_count * sizeof(path_type));
+    // Error check
+    if ( p_root == (void *) 0 ) goto no_mem;
 
-    // Get the name of each path
-    if ( path_directory_content_names(p_path, pp_path_names) == 0 ) goto failed_to_get_directory_content_names;
+    // Find each regular file, and its size
+    if ( path_pool_run(thread_count, path_duplicates_task, p_root, &dup) == 0 ) goto failed_to_scan;
 
-    // Get the types of each path
-    if ( path_directory_content_types(p_path, pp_path_types) == 0 ) goto failed_to_get_directory_content_types;
+    // Error check
+    if ( dup.failed ) goto failed_to_scan;
 
-    // Iterate over each path in the directory
-    for (size_t i = 0; i < directory_content_count; i++)
+    // Order the files by size, and by inode
+    if ( dup.file_count ) qsort(dup.p_files, dup.file_count, sizeof(path_duplicate_file), path_duplicate_compare_inode);
 
-        // Call the function
-        pfn_path_iter(pp_path_names[i], pp_path_types[i], i);
-    
-    // Clean up
-    (void) PATH_REALLOC(pp_path_names, 0);
-    (void) PATH_REALLOC(pp_path_types, 0);
+    // Keep one name for each inode. Hard links aren't duplicates
+    for (size_t i = 0; i < dup.file_count; i++)
+    {
 
-    // Success
-    return 1;
+        // Another name of the same inode
+        if ( kept && dup.p_files[kept - 1].device == dup.p_files[i].device && dup.p_files[kept - 1].inode == dup.p_files[i].inode )
+        {
+            (void) PATH_REALLOC(dup.p_files[i].full_path, 0);
+            continue;
+        }
 
-    no_mem:
-        return 0;
+        // Keep the file
+        dup.p_files[kept] = dup.p_files[i];
+        dup.p_files[kept++].candidate = true;
+    }
+    dup.file_count = kept;
+
+    // Stage 1. Only files that share their size may be duplicates
+    if ( path_duplicate_mark(&dup, false) == 0 ) goto done;
+
+    // Stage 2. Hash both ends of each candidate, and keep files that share a size and a partial hash
+    path_duplicate_hash(&dup, false, thread_count);
+    qsort(dup.p_files, dup.file_count, sizeof(path_duplicate_file), path_duplicate_compare_hash);
+    if ( path_duplicate_mark(&dup, true) == 0 ) goto done;
+
+    // Stage 3. Hash each remaining candidate in full, and keep files that share a size and a hash
+    path_duplicate_hash(&dup, true, thread_count);
+    qsort(dup.p_files, dup.file_count, sizeof(path_duplicate_file), path_duplicate_compare_hash);
+    if ( path_duplicate_mark(&dup, true) == 0 ) goto done;
+
+    // Allocate memory for the paths of a set
+    pp_paths = PATH_REALLOC(0, dup.file_count * sizeof(const char *));
+
+    // Error check
+    if ( pp_paths == (void *) 0 ) goto no_mem;
+
+    // Report each set of duplicates. Candidates are grouped by size and hash
+    for (size_t i = 0, j = 0; i < dup.file_count; i = j)
+    {
+
+        // Skip files without duplicates
+        if ( dup.p_files[i].candidate == false ) { j = i + 1; continue; }
+
+        // Gather the set
+        for (j = i; j < dup.file_count && dup.p_files[j].candidate && dup.p_files[j].size == dup.p_files[i].size && memcmp(dup.p_files[j].hash, dup.p_files[i].hash, PATH_HASH_SIZE) == 0; j++)
+            pp_paths[j - i] = dup.p_files[j].full_path;
+
+        // Report the set
+        pfn_duplicates(pp_paths, j - i, dup.p_files[i].size, p_context);
+    }
+
+    done:
+
+    // Clean up
+    for (size_t i = 0; i < dup.file_count; i++) (void) PATH_REALLOC(dup.p_files[i].full_path, 0);
+    if ( dup.p_files ) (void) PATH_REALLOC(dup.p_files, 0);
+    if ( pp_paths ) (void) PATH_REALLOC(pp_paths, 0);
+    mutex_destroy(&dup._lock);
+
+    // Done
+    return ( dup.failed == false );
 
     // Error handling
     {
-        
+
         // Argument errors
         {
             no_path:
@@ -1432,15 +11306,14 @@ int path_directory_foreach_i ( const path *const p_path, void (*pfn_path_iter)(c
 
                 // Error
                 return 0;
-                    
-            no_path_iter:
+
+            no_duplicates:
                 #ifndef NDEBUG
-                    printf("[path] Null pointer provided for parameter \"pfn_path_iter\" in call to function \"%s\"\n", __FUNCTION__);
+                    printf("[path] Null pointer provided for parameter \"pfn_duplicates\" in call to function \"%s\"\n", __FUNCTION__);
                 #endif
 
                 // Error
                 return 0;
-                
         }
 
         // path errors
@@ -1452,23 +11325,38 @@ int path_directory_foreach_i ( const path *const p_path, void (*pfn_path_iter)(c
 
                 // Error
                 return 0;
-            
-            failed_to_get_directory_content_names:
+
+            failed_to_scan:
                 #ifndef NDEBUG
-                    printf("[path] Failed to get names of directory contents in call to function \"%s\"\n", __FUNCTION__);
+                    printf("[path] Failed to scan \"%s\" in call to function \"%s\"\n", p_path->full_path.text, __FUNCTION__);
                 #endif
 
-                // Error
-                return 0;
+                // Clean up
+                dup.failed = true;
+                goto done;
+        }
 
-            failed_to_get_directory_content_types:
+        // sync errors
+        {
+            failed_to_create_mutex:
                 #ifndef NDEBUG
-                    printf("[path] Failed to get types of directory contents in call to function \"%s\"\n", __FUNCTION__);
+                    printf("[sync] Failed to create mutex in call to function \"%s\"\n", __FUNCTION__);
                 #endif
 
                 // Error
                 return 0;
+        }
+
+        // Standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    printf("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
 
+                // Clean up
+                dup.failed = true;
+                goto done;
         }
     }
 }
@@ -1481,7 +11369,8 @@ int path_close ( path **pp_path )
     if ( pp_path == (void *) 0 ) goto no_path;
     
     // Initialized data
-    path *p_path = *pp_path;
+    path           *p_path    = *pp_path;
+    path_allocator  allocator = { 0 };
 
     // Error check
     if ( p_path == (void *) 0 ) goto pointer_to_null_pointer;
@@ -1489,7 +11378,39 @@ int path_close ( path **pp_path )
     // No more pointer for caller
     *pp_path = 0;
 
-    // TODO
+    // Free the enumeration buffer
+    if ( p_path->enumeration.p_buffer ) p_path->enumeration.p_buffer = path_realloc(&p_path->allocator, p_path->enumeration.p_buffer, 0);
+
+    // Stop watching the directory
+    (void) path_watch_remove(p_path);
+
+    // Free the listing
+    (void) path_directory_listing_clear(p_path);
+
+    // Free the listings of directories that were visited before
+    (void) path_listing_cache_clear(p_path);
+
+    // Close the directory
+    if ( p_path->directory.fd != -1 ) (void) close(p_path->directory.fd);
+
+    // Close the directories above it
+    path_ancestor_clear(p_path);
+
+    #ifdef PATH_HAS_IO_URING
+
+        // Destroy the batch
+        if ( p_path->p_statx_batch ) (void) path_statx_batch_destroy(&p_path->p_statx_batch);
+    #endif
+
+    // Free the memory of the listing
+    (void) path_listing_destroy(&p_path->data.listing);
+
+    // Free the text
+    if ( p_path->full_path.text ) p_path->full_path.text = path_realloc(&p_path->allocator, p_path->full_path.text, 0);
+
+    // Free the path, with a copy of its own allocator
+    allocator = p_path->allocator;
+    p_path    = path_realloc(&allocator, p_path, 0);
 
     // Success
     return 1;
@@ -0,0 +1,221 @@
+/** !
+ * Benchmarks path module
+ *
+ * @file path_bench.c
+ *
+ * @author Jacob C Smith
+ */
+
+/** !
+ * Commentary
+ *
+ *   Listing a directory is the hot path of the path library. This program
+ *   fills a scratch directory with a large number of empty files, then opens
+ *   and lists it repeatedly with each directory enumeration backend, and
+ *   reports the time each backend spends per directory entry. Then, it opens
+ *   the directory with PATH_OPEN_METADATA, and reports the time each metadata
+ *   backend spends per directory entry.
+ *
+ *   Usage: path_bench [ /path/to/scratch/directory [ entry count [ runs ] ] ]
+ *
+ *   The scratch directory is created if it does not exist, and populated up
+ *   to the requested entry count. It is not removed, so repeated runs skip
+ *   the ( slow ) setup phase.
+ */
+
+// Include
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <errno.h>
+
+// Platform dependent includes
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+// sync submodule
+#include <sync/sync.h>
+
+// path submodule
+#include <path/path.h>
+
+//////////////////////////
+// Forward declarations //
+//////////////////////////
+
+// Utility functions
+int    bench_populate ( const char *directory_path, size_t entry_count );
+double bench_open     ( const char *directory_path, path_enumeration_backend backend, path_metadata_backend metadata_backend, int flags, size_t runs, size_t *p_entry_count );
+
+// Entry point
+int main ( int argc, const char *argv[] )
+{
+
+    // Initialized data
+    const char *directory_path = ( argc > 1 ) ? argv[1] : "bench directory";
+    size_t      entry_count    = ( argc > 2 ) ? strtoull(argv[2], 0, 10) : 1000000,
+                runs           = ( argc > 3 ) ? strtoull(argv[3], 0, 10) : 3,
+                listed         = 0;
+    double      readdir_s      = 0,
+                getdents_s     = 0,
+                fstatat_s      = 0,
+                io_uring_s     = 0;
+
+    // Initialize the timer library
+    timer_init();
+
+    // Formatting
+    printf("|=============|\n| PATH BENCH  |\n|=============|\n\n");
+
+    // Populate the scratch directory
+    if ( bench_populate(directory_path, entry_count) == 0 ) goto failed_to_populate;
+
+    // readdir
+    readdir_s = bench_open(directory_path, PATH_ENUMERATION_READDIR, PATH_METADATA_DEFAULT, PATH_OPEN_DEFAULT, runs, &listed);
+
+    // Print the result
+    printf("readdir    : %10.3f ms / open, %8.2f ns / entry ( %zu entries )\n", readdir_s * 1000.0, readdir_s * 1e9 / (double) ( listed ? listed : 1 ), listed);
+
+    // getdents64
+    getdents_s = bench_open(directory_path, PATH_ENUMERATION_GETDENTS, PATH_METADATA_DEFAULT, PATH_OPEN_DEFAULT, runs, &listed);
+
+    // Print the result
+    printf("getdents64 : %10.3f ms / open, %8.2f ns / entry ( %zu entries )\n", getdents_s * 1000.0, getdents_s * 1e9 / (double) ( listed ? listed : 1 ), listed);
+
+    // Formatting
+    printf("\nPATH_OPEN_METADATA\n");
+
+    // fstatat
+    fstatat_s = bench_open(directory_path, PATH_ENUMERATION_DEFAULT, PATH_METADATA_FSTATAT, PATH_OPEN_METADATA, runs, &listed);
+
+    // Print the result
+    printf("fstatat    : %10.3f ms / open, %8.2f ns / entry ( %zu entries )\n", fstatat_s * 1000.0, fstatat_s * 1e9 / (double) ( listed ? listed : 1 ), listed);
+
+    // io_uring
+    io_uring_s = bench_open(directory_path, PATH_ENUMERATION_DEFAULT, PATH_METADATA_IO_URING, PATH_OPEN_METADATA, runs, &listed);
+
+    // Print the result
+    printf("io_uring   : %10.3f ms / open, %8.2f ns / entry ( %zu entries )\n", io_uring_s * 1000.0, io_uring_s * 1e9 / (double) ( listed ? listed : 1 ), listed);
+
+    // Flush stdio
+    fflush(stdout);
+
+    // Success
+    return EXIT_SUCCESS;
+
+    failed_to_populate:
+
+        // Error
+        return EXIT_FAILURE;
+}
+
+int bench_populate ( const char *directory_path, size_t entry_count )
+{
+
+    // Initialized data
+    int  directory_fd = -1;
+    char name[64]     = { 0 };
+
+    // Make the scratch directory
+    if ( mkdir(directory_path, 0777) == -1 && errno != EEXIST ) goto failed_to_create_directory;
+
+    // Open the scratch directory
+    directory_fd = open(directory_path, O_RDONLY | O_DIRECTORY);
+
+    // Error check
+    if ( directory_fd == -1 ) goto failed_to_create_directory;
+
+    // Log
+    printf("Populating \"%s\" with %zu entries\n\n", directory_path, entry_count);
+
+    // Create each file
+    for (size_t i = 0; i < entry_count; i++)
+    {
+
+        // Initialized data
+        int fd = -1;
+
+        // Make the name
+        snprintf(name, sizeof(name), "entry %zu.o", i);
+
+        // Create the file
+        fd = openat(directory_fd, name, O_WRONLY | O_CREAT, 0666);
+
+        // Error check
+        if ( fd == -1 ) goto failed_to_create_file;
+
+        // Close the file
+        (void) close(fd);
+    }
+
+    // Clean up
+    (void) close(directory_fd);
+
+    // Success
+    return 1;
+
+    failed_to_create_file:
+        printf("[path bench] Failed to create file \"%s\". %s\n", name, strerror(errno));
+        (void) close(directory_fd);
+
+        // Error
+        return 0;
+
+    failed_to_create_directory:
+        printf("[path bench] Failed to create directory \"%s\". %s\n", directory_path, strerror(errno));
+
+        // Error
+        return 0;
+}
+
+double bench_open ( const char *directory_path, path_enumeration_backend backend, path_metadata_backend metadata_backend, int flags, size_t runs, size_t *p_entry_count )
+{
+
+    // Initialized data
+    timestamp t0 = 0,
+              t1 = 0;
+    double    best = 0;
+
+    // Set the backends
+    path_enumeration_backend_set(backend);
+    path_metadata_backend_set(metadata_backend);
+
+    // Repeat the measurement, and keep the best result
+    for (size_t i = 0; i < runs; i++)
+    {
+
+        // Initialized data
+        path   *p_path = 0;
+        double  seconds = 0;
+
+        // Start
+        t0 = timer_high_precision();
+
+        // Open the directory
+        path_open_with_flags(&p_path, directory_path, flags);
+
+        // List the directory. Listings are read on first use
+        *p_entry_count = path_directory_content_names(p_path, 0);
+
+        // Stop
+        t1 = timer_high_precision();
+
+        // Compute the elapsed time
+        seconds = (double)(t1 - t0) / (double)timer_seconds_divisor();
+
+        // Keep the best run
+        if ( i == 0 || seconds < best ) best = seconds;
+
+        // Close the path
+        (void) path_close(&p_path);
+    }
+
+    // Restore the default backends
+    path_enumeration_backend_set(PATH_ENUMERATION_DEFAULT);
+    path_metadata_backend_set(PATH_METADATA_DEFAULT);
+
+    // Success
+    return best;
+}
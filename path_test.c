@@ -85,13 +85,26 @@ int total_tests = 0,
 // Forward declarations //
 //////////////////////////
 
+// Paths reported to a callback, in any order
+typedef struct
+{
+    char   paths[64][256];
+    size_t count;
+} test_path_list;
+
 // Utility functions
 int print_time_pretty   ( double seconds );
 int run_tests           ( void );
 int print_final_summary ( void );
 int print_test          ( const char *scenario_name, const char *test_name, bool passed );
 size_t load_file        ( const char *path, void *buffer, bool binary_mode );
+bool save_file          ( const char *path, const char *text );
 int path_to_json_value  ( const path *const p_path, json_value **pp_value);
+path_walk_result test_path_list_add ( const char *full_path, path_type type, size_t depth, void *p_context );
+path_walk_result test_usage_directory_bytes ( const char *full_path, path_type type, size_t depth, void *p_context );
+int test_path_compare ( const void *p_a, const void *p_b );
+bool test_path_list_equals ( test_path_list *p_list, const char *const *expected_paths );
+bool test_make_deep_tree ( const char *path_text, size_t depth );
  
 int test_file_txt      ( char *name );
 int test_file_size_txt ( char *name );
@@ -105,9 +118,55 @@ int test_directory_directories      ( char *name );
 int test_directory_mixed            ( char *name );
 int test_directory_nested           ( char *name );
 
+int test_walk ( char *name );
+int test_foreach ( char *name );
+int test_pattern ( char *name );
+int test_glob ( char *name );
+int test_disk_usage ( char *name );
+int test_snapshot ( char *name );
+int test_diff ( char *name );
+int test_hash ( char *name );
+int test_duplicates ( char *name );
+int test_copy ( char *name );
+int test_remove ( char *name );
+int test_create ( char *name );
+int test_create_directories ( char *name );
+int test_write ( char *name );
+int test_handle ( char *name );
+int test_watch ( char *name );
+int test_listing_cache ( char *name );
+int test_arena ( char *name );
+int test_cursor ( char *name );
+
 bool test_open(const char *expected_path_json, const char *path_text, result_t result);
 bool test_path_type(path_type expected_type, const char *path_text, result_t result);
 bool test_file_size(size_t expected_size, const char *path_text, result_t result);
+bool test_walk_count(size_t expected_count, size_t thread_count, const char *path_text, result_t result);
+bool test_foreach_count(size_t expected_count, size_t limit, const char *path_text, result_t result);
+bool test_pattern_count(size_t expected_count, const char *pattern_text, const char *path_text, result_t result);
+bool test_glob_paths(const char *const *expected_paths, const char *pattern_text, const char *path_text, result_t result);
+bool test_usage_bytes(size_t expected_files, size_t expected_directories, size_t expected_file_bytes, size_t thread_count, const char *path_text, result_t result);
+bool test_usage_deep(size_t depth, size_t thread_count, result_t result);
+bool test_snapshot_entries(const char *const *expected_names, const size_t *expected_parents, const char *path_text, result_t result);
+bool test_snapshot_tree(size_t expected_count, const char *path_text, result_t result);
+bool test_diff_count(size_t expected_count, int flags, const char *path_text, result_t result);
+bool test_diff_changes(int flags, result_t result);
+void test_diff_recorder ( path_diff_kind kind, const char *old_path, const char *new_path, const path_metadata *p_old, const path_metadata *p_new, void *p_context );
+bool test_hash_paths(const char *const *expected_hashes, const char *path_text, result_t result);
+void test_hash_recorder ( const char *full_path, const unsigned char *p_hash, unsigned long long size, void *p_context );
+bool test_duplicates_sets(const char *const *expected_sets, const char *path_text, result_t result);
+void test_duplicates_recorder ( const char *const *full_paths, size_t count, unsigned long long size, void *p_context );
+bool test_copy_file(const char *source_name, const char *destination_name, int flags, result_t result);
+bool test_remove_tree(size_t depth, size_t width, result_t result);
+bool test_remove_dot(const char *path_text, const char *path_name, result_t result);
+bool test_create_files(size_t count, int flags, result_t result);
+bool test_create_directories_text(const char *path_text, const char *expected, result_t result);
+bool test_write_files(size_t count, int flags, result_t result);
+bool test_handle_navigate(int flags, const char *start, const char *path_text, const char *expected, result_t result);
+bool test_watch_changes(size_t cycles, size_t read_every, result_t result);
+bool test_listing_cache_revisit(bool change, result_t result);
+bool test_arena_paths(size_t block_size, size_t rounds, result_t result);
+bool test_cursor_entries(size_t expected_count, const char *pattern_text, const char *path_text, result_t result);
 
 // Entry point
 int main(int argc, const char *argv[])
@@ -290,6 +349,62 @@ int run_tests(void)
     // Test iterator
     {
 
+        // Test the parallel tree walker
+        test_walk("walk");
+
+        // Test the in place directory iterator
+        test_foreach("foreach");
+
+        // Test filtered listings
+        test_pattern("pattern");
+
+        // Test recursive globs
+        test_glob("glob");
+
+        // Test the parallel disk usage scan
+        test_disk_usage("disk usage");
+
+        // Test snapshots
+        test_snapshot("snapshot");
+
+        // Test tree diffs
+        test_diff("diff");
+
+        // Test the hashing pipeline
+        test_hash("hash");
+
+        // Test the duplicate file finder
+        test_duplicates("duplicates");
+
+        // Test file copies
+        test_copy("copy");
+
+        // Test recursive removes
+        test_remove("remove");
+
+        // Test batched file creation
+        test_create("create");
+
+        // Test recursive directory creation
+        test_create_directories("create directories");
+
+        // Test atomic writes
+        test_write("write");
+
+        // Test fd based navigation
+        test_handle("handle");
+
+        // Test watched listings
+        test_watch("watch");
+
+        // Test reuse of listings of revisited directories
+        test_listing_cache("listing cache");
+
+        // Test paths allocated from an arena
+        test_arena("arena");
+
+        // Test directory cursors
+        test_cursor("cursor");
     }
 
     // Success
@@ -418,259 +533,1709 @@ int test_directory_nested ( char *name )
     return 1;
 }
 
-bool test_open(const char *expected_path_json, const char *path_text, result_t result)
+int test_walk ( char *name )
+{
+    printf("Scenario: %s\n", name);
+    print_test(name, "path_walk_directory", test_walk_count(1, 1, "test cases/paths/directory", match));
+    print_test(name, "path_walk_directory files", test_walk_count(3, 1, "test cases/paths/directory files", match));
+    print_test(name, "path_walk_directory files_threads", test_walk_count(3, 4, "test cases/paths/directory files", match));
+    print_test(name, "path_walk_file.txt", test_walk_count(0, 1, "test cases/paths/file.txt", zero));
+
+    // Log
+    print_final_summary();
+
+    // Success
+    return 1;
+}
+
+path_walk_result test_walk_counter ( const char *full_path, path_type type, size_t depth, void *p_context )
+{
+
+    // Count the path
+    __atomic_add_fetch((size_t *)p_context, 1, __ATOMIC_RELAXED);
+
+    // Keep walking
+    return PATH_WALK_CONTINUE;
+}
+
+bool test_walk_count(size_t expected_count, size_t thread_count, const char *path_text, result_t result)
 {
 
     // Initialized data
     result_t actual_result = 0;
-    size_t expected_path_json_len = load_file(expected_path_json, 0, false);
-    char *expected_path_json_text = calloc(expected_path_json_len + 1, sizeof(char));
-    json_value *p_expected_value = 0,
-               *p_result_value = 0;
     path *p_path = 0;
+    size_t count = 0;
 
     // Open the path
     path_open(&p_path, path_text);
 
-    // Convert the path to a json_value
-    path_to_json_value(p_path, &p_result_value);
-
-    // Load the file text
-    load_file(expected_path_json, expected_path_json_text, true);
-
-    // Parse the text into a JSON value
-    parse_json_value(expected_path_json_text, 0, &p_expected_value);
-
-    print_json_value(p_expected_value, stdout);
-    printf("\n\n");
-    print_json_value(p_result_value, stdout);
-    printf("\n\n");
+    // Walk the path
+    if ( path_walk(p_path, thread_count, test_walk_counter, &count) == 0 )
+        actual_result = zero;
 
-    // Compare the json_value representations of the path against the expected json_value
-    if ( value_equals(p_expected_value, p_result_value) == true)
+    // Compare the quantity of paths against the expected quantity
+    else if ( expected_count == count )
         actual_result = match;
 
+    // Clean up
+    path_close(&p_path);
+
     // Return
     return (result == actual_result);
 }
 
-bool test_path_type(path_type expected_type, const char *path_text, result_t result)
+int test_foreach ( char *name )
+{
+    printf("Scenario: %s\n", name);
+    print_test(name, "path_foreach_directory", test_foreach_count(1, 16, "test cases/paths/directory", match));
+    print_test(name, "path_foreach_directory files", test_foreach_count(3, 16, "test cases/paths/directory files", match));
+    print_test(name, "path_foreach_directory files_stop", test_foreach_count(2, 2, "test cases/paths/directory files", match));
+    print_test(name, "path_foreach_file.txt", test_foreach_count(0, 16, "test cases/paths/file.txt", zero));
+
+    // Log
+    print_final_summary();
+
+    // Success
+    return 1;
+}
+
+int test_foreach_counter ( const path_entry *p_entry, void *p_context )
+{
+
+    // Initialized data
+    size_t *p_counter = p_context;
+
+    // Count the entry
+    p_counter[0]++;
+
+    // Stop at the limit
+    return p_counter[0] < p_counter[1];
+}
+
+bool test_foreach_count(size_t expected_count, size_t limit, const char *path_text, result_t result)
 {
 
     // Initialized data
     result_t actual_result = 0;
-    json_value *p_result_value = 0;
     path *p_path = 0;
-    path_type type = 0;
+    size_t counter[2] = { 0, limit };
 
     // Open the path
     path_open(&p_path, path_text);
 
-    // Convert the path to a json_value
-    path_to_json_value(p_path, &p_result_value);
-
-    // Get the path of the type
-    type = path_type_path(p_path);
+    // Iterate over the directory
+    if ( path_directory_foreach(p_path, test_foreach_counter, counter) == 0 )
+        actual_result = zero;
 
-    // Compare the json_value representations of the path against the expected json_value
-    if (expected_type == type)
+    // Compare the quantity of entries against the expected quantity
+    else if ( expected_count == counter[0] )
         actual_result = match;
 
+    // Clean up
+    path_close(&p_path);
+
     // Return
     return (result == actual_result);
 }
 
-bool test_file_size(size_t expected_size, const char *path_text, result_t result)
+int test_pattern ( char *name )
+{
+    printf("Scenario: %s\n", name);
+    print_test(name, "path_pattern_star", test_pattern_count(3, "*", "test cases/paths/directory files", match));
+    print_test(name, "path_pattern_suffix", test_pattern_count(3, "*.txt", "test cases/paths/directory files", match));
+    print_test(name, "path_pattern_class", test_pattern_count(2, "file [13].txt", "test cases/paths/directory files", match));
+    print_test(name, "path_pattern_alternation", test_pattern_count(2, "file {1,2}.txt", "test cases/paths/directory files", match));
+    print_test(name, "path_pattern_any", test_pattern_count(3, "file ?.txt", "test cases/paths/directory files", match));
+    print_test(name, "path_pattern_hidden", test_pattern_count(0, "*", "test cases/paths/directory", match));
+    print_test(name, "path_pattern_no_match", test_pattern_count(0, "*.o", "test cases/paths/directory files", match));
+
+    // Log
+    print_final_summary();
+
+    // Success
+    return 1;
+}
+
+bool test_pattern_count(size_t expected_count, const char *pattern_text, const char *path_text, result_t result)
 {
 
     // Initialized data
     result_t actual_result = 0;
-    json_value *p_result_value = 0;
     path *p_path = 0;
-    size_t size = 0;
+    path_pattern *p_pattern = 0;
+
+    // Compile the pattern
+    if ( path_pattern_compile(&p_pattern, pattern_text) == 0 ) return (result == zero);
 
     // Open the path
     path_open(&p_path, path_text);
 
-    // Convert the path to a json_value
-    path_to_json_value(p_path, &p_result_value);
-
-    // Get the path of the type
-    path_file_size(p_path, &size);
+    // Filter the listing
+    if ( path_directory_filter(p_path, p_pattern) == 0 )
+        actual_result = zero;
 
-    // Compare the json_value representations of the path against the expected json_value
-    if (expected_size == size)
+    // Compare the quantity of names against the expected quantity
+    else if ( expected_count == path_directory_content_names(p_path, 0) )
         actual_result = match;
 
+    // Clean up
+    path_close(&p_path);
+    path_pattern_destroy(&p_pattern);
+
     // Return
     return (result == actual_result);
 }
 
-int path_to_json_value(const path *const p_path, json_value **pp_value)
+int test_glob ( char *name )
 {
 
     // Initialized data
-    json_value *p_value1 = calloc(1, sizeof(json_value));
-    json_value *p_value2 = calloc(1, sizeof(json_value));
-    const char *p_path_name = path_name_text(p_path);
-    size_t len = strlen(p_path_name);
-    char *_path_name = calloc(len + 1, sizeof(char));
+    const char *literal[]   = { "test cases/paths/directory files/file 1.txt", 0 },
+               *component[] = { "test cases/paths/directory files/file 1.txt", "test cases/paths/directory files/file 2.txt", "test cases/paths/directory files/file 3.txt", 0 },
+               *globstar[]  = { "test cases/paths/directory files/file 1.txt", "test cases/paths/directory files/file 2.txt", "test cases/paths/directory files/file 3.txt", "test cases/paths/directory mixed/file 1.txt", "test cases/paths/directory mixed/file 2.txt", 0 },
+               *last[]      = { "test cases/paths/directory nested/a/b/c/d/e/f/g/h/i/j/k/l/m/n/o/p/q/r/s/t/u/v/w/x", "test cases/paths/directory nested/a/b/c/d/e/f/g/h/i/j/k/l/m/n/o/p/q/r/s/t/u/v/w/x/y", "test cases/paths/directory nested/a/b/c/d/e/f/g/h/i/j/k/l/m/n/o/p/q/r/s/t/u/v/w/x/y/z", 0 },
+               *none[]      = { 0 };
 
-    p_value1->type = JSON_VALUE_OBJECT;
+    printf("Scenario: %s\n", name);
+    print_test(name, "path_glob_literal", test_glob_paths(literal, "directory files/file 1.txt", "test cases/paths", match));
+    print_test(name, "path_glob_component", test_glob_paths(component, "directory files/*.txt", "test cases/paths", match));
+    print_test(name, "path_glob_globstar", test_glob_paths(globstar, "**/file ?.txt", "test cases/paths", match));
+    print_test(name, "path_glob_globstar_last", test_glob_paths(last, "directory nested/**/w/**", "test cases/paths", match));
+    print_test(name, "path_glob_no_match", test_glob_paths(none, "nope/**", "test cases/paths", match));
+    print_test(name, "path_glob_file.txt", test_glob_paths(none, "*", "test cases/paths/file.txt", zero));
 
-    strncpy(_path_name, p_path_name, len);
+    // Log
+    print_final_summary();
 
-    // file path -> JSON
-    if ( path_type_path(p_path) == PATH_TYPE_FILE )
-    {
-        p_value2->type = JSON_VALUE_INTEGER;
+    // Success
+    return 1;
+}
 
-        path_file_size(p_path, &p_value2->integer);
+path_walk_result test_path_list_add ( const char *full_path, path_type type, size_t depth, void *p_context )
+{
 
-        dict_construct(&p_value1->object, 1, 0);
-        dict_add(p_value1->object, _path_name, p_value2);
-    }
+    // Initialized data
+    test_path_list *p_list = p_context;
+    size_t          i      = __atomic_fetch_add(&p_list->count, 1, __ATOMIC_RELAXED);
 
-    // directory path -> JSON
-    else if ( path_type_path(p_path) == PATH_TYPE_DIRECTORY )
-    {
+    // Store the path. Overflows fail the comparison
+    if ( i < 64 ) snprintf(p_list->paths[i], sizeof(p_list->paths[i]), "%s", full_path);
 
-        // TODO:
-        // 1. Dump directory names and contents
-        // 2. Iterate over each path in the directory
-        // 2.1 Call path_to_json on each path in the directory
-        // 3 Serialize and return json_value
+    // Keep walking
+    return PATH_WALK_CONTINUE;
+}
 
-        char *names[4096] = {0};
-        void *types[4096] = {0};
+int test_path_compare ( const void *p_a, const void *p_b )
+{
 
-        size_t count = path_directory_content_names(p_path, 0);
+    // Compare two paths
+    return strcmp(p_a, p_b);
+}
 
-        p_value2->type = JSON_VALUE_OBJECT;
-        dict_construct(&p_value1->object, 1, 0);
-        dict_construct(&p_value2->object, count, 0);
+bool test_path_list_equals ( test_path_list *p_list, const char *const *expected_paths )
+{
 
-        path_directory_content_names(p_path, &names);
-        path_directory_content_types(p_path, &types);
+    // Initialized data
+    size_t expected_count = 0;
 
-        // Iterate over each item in the directory
-        for (size_t i = 0; i < count; i++)
-        {
+    // Count the expected paths
+    while ( expected_paths[expected_count] ) expected_count++;
 
-            json_value *p_valueN       = 0;
-            size_t      path_name_len  = strlen(names[i]);
-            char       *path_name_copy = calloc(path_name_len+1, sizeof(char));
+    // Compare the quantity of paths
+    if ( p_list->count != expected_count || p_list->count > 64 ) return false;
 
-            strncpy(path_name_copy, names[i], path_name_len);
+    // Paths are reported in any order
+    qsort(p_list->paths, p_list->count, sizeof(p_list->paths[0]), test_path_compare);
 
-            if ( path_navigate(&p_path, path_name_copy) == 0 )
-            {
-                goto failed_to_nav;
-            }
-            
-            if ( path_type_path(p_path) == PATH_TYPE_FILE )
-            {
-                p_valueN = calloc(1, sizeof(json_value));
-                p_valueN->type = JSON_VALUE_INTEGER;
-                path_file_size(p_path, &p_valueN->integer);
-                dict_add(p_value2->object, path_name_copy, p_valueN);
+    // Compare each path. The expected paths are sorted
+    for (size_t i = 0; i < expected_count; i++)
+        if ( strcmp(p_list->paths[i], expected_paths[i]) ) return false;
 
-            }
-            else if ( path_type_path(p_path) == PATH_TYPE_DIRECTORY )
-            {
-                path_to_json_value(p_path, &p_valueN);
+    // Match
+    return true;
+}
 
-                dict_add(p_value2->object, path_name_copy, dict_get(p_valueN->object, path_name_copy));
+bool test_make_deep_tree ( const char *path_text, size_t depth )
+{
 
-            }
+    // Initialized data
+    char name[101] = { 0 };
+    int fd = -1;
 
-            failed_to_nav:
+    // Each directory has a long name, so the full path of the deepest is longer than PATH_MAX
+    memset(name, 'd', sizeof(name) - 1);
 
-            path_navigate(&p_path, "..");
+    // Make the root
+    if ( mkdir(path_text, 0777) == -1 ) return false;
+    fd = open(path_text, O_RDONLY | O_DIRECTORY);
+
+    // Make a chain of directories, each with one file in it
+    for (size_t i = 0; i < depth && fd != -1; i++)
+    {
+
+        // Initialized data
+        int child_fd = -1;
+
+        // Make the directory, relative to its parent
+        if ( mkdirat(fd, name, 0777) == 0 ) child_fd = openat(fd, name, O_RDONLY | O_DIRECTORY);
+        (void) close(fd);
+        fd = child_fd;
+
+        // Make the file
+        if ( fd != -1 ) 
+        {
+
+            // Initialized data
+            int file_fd = openat(fd, "file", O_WRONLY | O_CREAT | O_TRUNC, 0666);
+
+            // Write one byte
+            if ( file_fd != -1 ) (void) ( write(file_fd, "x", 1) + close(file_fd) );
         }
-    
-        dict_add(p_value1->object, _path_name, p_value2);
     }
 
-    // Return
-    *pp_value = p_value1;
+    // Error check
+    if ( fd == -1 ) return false;
+
+    // Clean up
+    (void) close(fd);
 
     // Success
-    return 1;
+    return true;
 }
 
-int print_test(const char *scenario_name, const char *test_name, bool passed)
+bool test_glob_paths(const char *const *expected_paths, const char *pattern_text, const char *path_text, result_t result)
 {
 
     // Initialized data
-    printf("%s %-20s %s\n", scenario_name, test_name, (passed) ? "PASS" : "FAIL");
+    result_t actual_result = 0;
+    path *p_path = 0;
+    test_path_list list = { 0 };
 
-    // Increment the counters
-    {
-        if (passed)
-        {
-            ephemeral_passes++;
-        }
-        else
-        {
-            ephemeral_fails++;
-        }
+    // Open the path
+    path_open(&p_path, path_text);
 
-        ephemeral_tests++;
-    }
+    // Glob the path
+    if ( path_glob(p_path, pattern_text, test_path_list_add, &list) == 0 )
+        actual_result = zero;
 
-    fflush(stdout);
+    // Compare the matches against the expected paths
+    else if ( test_path_list_equals(&list, expected_paths) )
+        actual_result = match;
 
-    // Success
-    return 1;
+    // Clean up
+    path_close(&p_path);
+
+    // Return
+    return (result == actual_result);
 }
 
-int print_final_summary()
+int test_disk_usage ( char *name )
 {
 
-    // Accumulate
-    total_tests += ephemeral_tests,
-    total_passes += ephemeral_passes,
-    total_fails += ephemeral_fails;
+    // Initialized data
+    FILE *p_f = 0;
 
-    // Print
-    printf("\nTests: %d, Passed: %d, Failed: %d (%%%.3f)\n", ephemeral_tests, ephemeral_passes, ephemeral_fails, ((float)ephemeral_passes / (float)ephemeral_tests * 100.f));
-    printf("Total: %d, Passed: %d, Failed: %d (%%%.3f)\n\n", total_tests, total_passes, total_fails, ((float)total_passes / (float)total_tests * 100.f));
+    // Make a directory with a file, a second name for the file, and another file
+    mkdir("test cases/paths/usage.tmp", 0777);
+    p_f = fopen("test cases/paths/usage.tmp/a", "w");
+    if ( p_f ) { fputs("hard link", p_f); fclose(p_f); }
+    link("test cases/paths/usage.tmp/a", "test cases/paths/usage.tmp/b");
+    p_f = fopen("test cases/paths/usage.tmp/c", "w");
+    if ( p_f ) { fputs("abc", p_f); fclose(p_f); }
 
-    ephemeral_tests = 0;
-    ephemeral_passes = 0;
-    ephemeral_fails = 0;
+    printf("Scenario: %s\n", name);
+    print_test(name, "path_disk_usage_directory", test_usage_bytes(1, 1, 0, 1, "test cases/paths/directory", match));
+    print_test(name, "path_disk_usage_directory files", test_usage_bytes(3, 1, 19, 1, "test cases/paths/directory files", match));
+    print_test(name, "path_disk_usage_directory nested_threads", test_usage_bytes(1, 27, 0, 4, "test cases/paths/directory nested", match));
+    print_test(name, "path_disk_usage_hard link", test_usage_bytes(2, 1, 12, 1, "test cases/paths/usage.tmp", match));
+    print_test(name, "path_disk_usage_hard link_threads", test_usage_bytes(2, 1, 12, 4, "test cases/paths/usage.tmp", match));
+    print_test(name, "path_disk_usage_file size.txt", test_usage_bytes(1, 0, 34, 1, "test cases/paths/file size.txt", match));
+    print_test(name, "path_disk_usage_deep", test_usage_deep(60, 1, match));
+    print_test(name, "path_disk_usage_deep_threads", test_usage_deep(60, 4, match));
+
+    // Clean up
+    remove("test cases/paths/usage.tmp/a");
+    remove("test cases/paths/usage.tmp/b");
+    remove("test cases/paths/usage.tmp/c");
+    remove("test cases/paths/usage.tmp");
+
+    // Log
+    print_final_summary();
 
     // Success
     return 1;
 }
 
-size_t load_file(const char *path, void *buffer, bool binary_mode)
+path_walk_result test_usage_directory_bytes ( const char *full_path, path_type type, size_t depth, void *p_context )
 {
 
-    // Argument checking
-    #ifndef NDEBUG
-        if ( path == 0 ) goto no_path;
-    #endif
-
     // Initialized data
-    size_t ret = 0;
-    FILE *f = fopen(path, (binary_mode) ? "rb" : "r");
+    struct stat st = { 0 };
 
-    // Check if file is valid
-    if ( f == NULL ) goto invalid_file;
+    // Add the size of each directory
+    if ( type == PATH_TYPE_DIRECTORY && lstat(full_path, &st) == 0 ) __atomic_add_fetch((size_t *) p_context, (size_t) st.st_size, __ATOMIC_RELAXED);
 
-    // Find file size and prep for read
-    fseek(f, 0, SEEK_END);
-    ret = ftell(f);
-    fseek(f, 0, SEEK_SET);
+    // Keep walking
+    return PATH_WALK_CONTINUE;
+}
 
-    // Read to data
-    if (buffer)
-        ret = fread(buffer, 1, ret, f);
+bool test_usage_bytes(size_t expected_files, size_t expected_directories, size_t expected_file_bytes, size_t thread_count, const char *path_text, result_t result)
+{
 
-    // The file is no longer needed
-    fclose(f);
+    // Initialized data
+    result_t actual_result = 0;
+    path *p_path = 0;
+    path_usage usage = { 0 };
+    struct stat st = { 0 };
+    size_t expected_bytes = expected_file_bytes;
+
+    // Open the path
+    path_open(&p_path, path_text);
+
+    // The size of a directory depends on the file system, so measure each one
+    if ( expected_directories && lstat(path_text, &st) == 0 )
+    {
+        expected_bytes += (size_t) st.st_size;
+        path_walk(p_path, 1, test_usage_directory_bytes, &expected_bytes);
+    }
+
+    // Measure the path
+    if ( path_disk_usage(p_path, thread_count, &usage, 0, 0) == 0 )
+        actual_result = zero;
+
+    // Compare the quantities of files, directories, and bytes against the expected quantities
+    else if ( expected_files == usage.files && expected_directories == usage.directories && expected_bytes == usage.size )
+        actual_result = match;
+
+    // Clean up
+    path_close(&p_path);
+
+    // Return
+    return (result == actual_result);
+}
+
+bool test_usage_deep(size_t depth, size_t thread_count, result_t result)
+{
+
+    // Initialized data
+    result_t actual_result = 0;
+    path *p_parent = 0,
+         *p_path = 0;
+    path_usage usage = { 0 };
+
+    // Make a tree deeper than the longest path
+    path_open(&p_parent, "test cases/paths");
+    test_make_deep_tree("test cases/paths/deep.tmp", depth);
+    path_open(&p_path, "test cases/paths/deep.tmp");
+
+    // Measure the tree
+    if ( path_disk_usage(p_path, thread_count, &usage, 0, 0) == 0 )
+        actual_result = zero;
+
+    // Every directory, and the file in each, is counted
+    else if ( usage.files == depth && usage.directories == depth + 1 )
+        actual_result = match;
+
+    // Clean up
+    path_close(&p_path);
+    path_remove(p_parent, "deep.tmp");
+    path_close(&p_parent);
+
+    // Return
+    return (result == actual_result);
+}
+
+int test_snapshot ( char *name )
+{
+
+    // Initialized data
+    const char   *directory[]        = { "test cases/paths/directory", ".PLACEHOLDER", 0 },
+                 *directory_files[]  = { "test cases/paths/directory files", "file 1.txt", "file 2.txt", "file 3.txt", 0 },
+                 *file[]             = { "test cases/paths/file.txt", 0 },
+                 *nested[29]         = { "test cases/paths/directory nested" };
+    const size_t  flat_parents[]     = { 0, 0, 0, 0 };
+    size_t        nested_parents[28] = { 0 };
+    char          letters[26][2]     = { 0 };
+    path         *p_parent           = 0;
+
+    // The nested directory is a chain from a to z, with a file at the bottom
+    for (size_t i = 0; i < 26; i++)
+    {
+        letters[i][0]         = (char) ( 'a' + i );
+        nested[i + 1]         = letters[i];
+        nested_parents[i + 1] = i;
+    }
+    nested[27]         = ".PLACEHOLDER";
+    nested_parents[27] = 26;
+
+    // Make a tree deeper than the longest path
+    path_open(&p_parent, "test cases/paths");
+    test_make_deep_tree("test cases/paths/deep.tmp", 60);
+
+    // Make a directory with more directories than the snapshot keeps open, each with a file in it
+    mkdir("test cases/paths/wide.tmp", 0777);
+    for (size_t i = 0; i < 300; i++)
+    {
+
+        // Initialized data
+        char directory_text[64] = { 0 },
+             file_text[80] = { 0 };
+
+        // Make the directory, and its file
+        snprintf(directory_text, sizeof(directory_text), "test cases/paths/wide.tmp/%zu", i);
+        snprintf(file_text, sizeof(file_text), "%s/file", directory_text);
+        mkdir(directory_text, 0777);
+        save_file(file_text, "x");
+    }
+
+    printf("Scenario: %s\n", name);
+    print_test(name, "path_snapshot_directory", test_snapshot_entries(directory, flat_parents, "test cases/paths/directory", match));
+    print_test(name, "path_snapshot_directory files", test_snapshot_entries(directory_files, flat_parents, "test cases/paths/directory files", match));
+    print_test(name, "path_snapshot_directory nested", test_snapshot_entries(nested, nested_parents, "test cases/paths/directory nested", match));
+    print_test(name, "path_snapshot_file.txt", test_snapshot_entries(file, flat_parents, "test cases/paths/file.txt", match));
+    print_test(name, "path_snapshot_deep", test_snapshot_tree(1 + 2 * 60, "test cases/paths/deep.tmp", match));
+    print_test(name, "path_snapshot_wide", test_snapshot_tree(1 + 2 * 300, "test cases/paths/wide.tmp", match));
+
+    // Clean up
+    path_remove(p_parent, "deep.tmp");
+    path_remove(p_parent, "wide.tmp");
+    path_close(&p_parent);
+
+    // Log
+    print_final_summary();
+
+    // Success
+    return 1;
+}
+
+bool test_snapshot_entries(const char *const *expected_names, const size_t *expected_parents, const char *path_text, result_t result)
+{
+
+    // Initialized data
+    result_t actual_result = 0;
+    path *p_path = 0;
+    path_snapshot *p_old = 0,
+                  *p_new = 0;
+    path_snapshot_entry old_entry = { 0 },
+                        new_entry = { 0 };
+    size_t expected_count = 0;
+
+    // Count the expected entries
+    while ( expected_names[expected_count] ) expected_count++;
+
+    // Open the path
+    path_open(&p_path, path_text);
+
+    // Save, and open, the snapshot. Then replace it, while the old one is still open
+    if ( 
+        path_snapshot_save(p_path, "path_test.snapshot")  == 0 || 
+        path_snapshot_open(&p_old, "path_test.snapshot")  == 0 ||
+        path_snapshot_save(p_path, "path_test.snapshot")  == 0 || 
+        path_snapshot_open(&p_new, "path_test.snapshot")  == 0
+    )
+        actual_result = zero;
+
+    // Compare the name, and the parent, of each entry in both snapshots
+    else if ( expected_count == path_snapshot_count(p_old) && expected_count == path_snapshot_count(p_new) )
+    {
+
+        // Assume a match
+        actual_result = match;
+
+        // Check each entry
+        for (size_t i = 0; i < expected_count; i++)
+            if ( 
+                path_snapshot_get(p_old, i, &old_entry)         == 0 ||
+                path_snapshot_get(p_new, i, &new_entry)         == 0 ||
+                strcmp(old_entry.name, expected_names[i])       != 0 ||
+                strcmp(new_entry.name, expected_names[i])       != 0 ||
+                old_entry.parent                                != expected_parents[i] ||
+                new_entry.parent                                != expected_parents[i]
+            )
+                actual_result = zero;
+    }
+
+    // Clean up
+    path_snapshot_close(&p_old);
+    path_snapshot_close(&p_new);
+    path_close(&p_path);
+    remove("path_test.snapshot");
+
+    // Return
+    return (result == actual_result);
+}
+
+bool test_snapshot_tree(size_t expected_count, const char *path_text, result_t result)
+{
+
+    // Initialized data
+    result_t actual_result = 0;
+    path *p_path = 0;
+    path_snapshot *p_snapshot = 0;
+    path_snapshot_entry entry = { 0 };
+
+    // Open the path
+    path_open(&p_path, path_text);
+
+    // Save, and open, the snapshot
+    if ( path_snapshot_save(p_path, "path_test.snapshot") == 0 || path_snapshot_open(&p_snapshot, "path_test.snapshot") == 0 )
+        actual_result = zero;
+
+    // Compare the quantity of entries, and make sure no directory was read as empty
+    else if ( path_snapshot_count(p_snapshot) == expected_count )
+    {
+
+        // Assume a match
+        actual_result = match;
+
+        // Every directory in the tree has something in it
+        for (size_t i = 0; i < expected_count; i++)
+            if ( path_snapshot_get(p_snapshot, i, &entry) == 0 || ( entry.metadata.type == PATH_TYPE_DIRECTORY && entry.child_count == 0 ) )
+                actual_result = zero;
+    }
+
+    // Clean up
+    if ( p_snapshot ) path_snapshot_close(&p_snapshot);
+    path_close(&p_path);
+    remove("path_test.snapshot");
+
+    // Return
+    return (result == actual_result);
+}
+
+int test_diff ( char *name )
+{
+    printf("Scenario: %s\n", name);
+    print_test(name, "path_diff_directory files", test_diff_count(0, PATH_DIFF_DEFAULT, "test cases/paths/directory files", match));
+    print_test(name, "path_diff_directory nested", test_diff_count(0, PATH_DIFF_DEFAULT, "test cases/paths/directory nested", match));
+    print_test(name, "path_diff_directory nested_trusted", test_diff_count(0, PATH_DIFF_TRUST_DIRECTORIES, "test cases/paths/directory nested", match));
+    print_test(name, "path_diff_live_changes", test_diff_changes(PATH_DIFF_DEFAULT, match));
+    print_test(name, "path_diff_live_changes_trusted", test_diff_changes(PATH_DIFF_TRUST_DIRECTORIES, match));
+
+    // Log
+    print_final_summary();
+
+    // Success
+    return 1;
+}
+
+void test_diff_counter ( path_diff_kind kind, const char *old_path, const char *new_path, const path_metadata *p_old, const path_metadata *p_new, void *p_context )
+{
+
+    // Count the difference
+    __atomic_add_fetch((size_t *) p_context, 1, __ATOMIC_RELAXED);
+}
+
+bool test_diff_count(size_t expected_count, int flags, const char *path_text, result_t result)
+{
+
+    // Initialized data
+    result_t actual_result = 0;
+    path *p_path = 0;
+    path_snapshot *p_snapshot = 0;
+    size_t count = 0;
+
+    // Open the path
+    path_open(&p_path, path_text);
+
+    // Snapshot the path, and compare the snapshot to itself, and to the live tree
+    if ( 
+        path_snapshot_save(p_path, "path_test.snapshot")                        == 0 || 
+        path_snapshot_open(&p_snapshot, "path_test.snapshot")                   == 0 ||
+        path_diff(p_snapshot, p_snapshot, 2, flags, test_diff_counter, &count)  == 0 ||
+        path_diff_live(p_snapshot, p_path, 2, flags, test_diff_counter, &count) == 0
+    )
+        actual_result = zero;
+
+    // Compare the quantity of differences against the expected quantity
+    else if ( expected_count == count )
+        actual_result = match;
+
+    // Clean up
+    path_snapshot_close(&p_snapshot);
+    path_close(&p_path);
+    remove("path_test.snapshot");
+
+    // Return
+    return (result == actual_result);
+}
+
+void test_diff_recorder ( path_diff_kind kind, const char *old_path, const char *new_path, const path_metadata *p_old, const path_metadata *p_new, void *p_context )
+{
+
+    // Initialized data
+    test_path_list *p_list = p_context;
+    size_t          i      = __atomic_fetch_add(&p_list->count, 1, __ATOMIC_RELAXED);
+
+    // Record the kind, and both paths, of the difference. Overflows fail the comparison
+    if ( i < 64 ) snprintf(p_list->paths[i], sizeof(p_list->paths[i]), "%d %s %s", (int) kind, old_path ? old_path : "-", new_path ? new_path : "-");
+}
+
+bool test_diff_changes(int flags, result_t result)
+{
+
+    // Initialized data
+    result_t actual_result = 0;
+    path *p_path = 0;
+    path_snapshot *p_snapshot = 0;
+    test_path_list list = { 0 };
+    const char *expected[] = 
+    {
+        "1 - add.txt",
+        "2 remove.txt -",
+        "3 modify.txt modify.txt",
+        "4 rename from.txt rename to.txt",
+        0
+    };
+
+    // Make a tree
+    mkdir("test cases/paths/diff.tmp", 0777);
+    mkdir("test cases/paths/diff.tmp/directory", 0777);
+    save_file("test cases/paths/diff.tmp/keep.txt", "keep");
+    save_file("test cases/paths/diff.tmp/modify.txt", "old");
+    save_file("test cases/paths/diff.tmp/remove.txt", "remove");
+    save_file("test cases/paths/diff.tmp/rename from.txt", "rename");
+    save_file("test cases/paths/diff.tmp/directory/file.txt", "file");
+
+    // Open the path
+    path_open(&p_path, "test cases/paths/diff.tmp");
+
+    // Snapshot the tree
+    if ( path_snapshot_save(p_path, "path_test.snapshot") == 0 || path_snapshot_open(&p_snapshot, "path_test.snapshot") == 0 )
+        actual_result = zero;
+
+    else
+    {
+
+        // Change the tree. The file is added first, so it can't reuse the inode of the removed file
+        save_file("test cases/paths/diff.tmp/add.txt", "add");
+        save_file("test cases/paths/diff.tmp/modify.txt", "modified");
+        remove("test cases/paths/diff.tmp/remove.txt");
+        rename("test cases/paths/diff.tmp/rename from.txt", "test cases/paths/diff.tmp/rename to.txt");
+
+        // Compare the snapshot to the live tree
+        if ( path_diff_live(p_snapshot, p_path, 2, flags, test_diff_recorder, &list) == 0 )
+            actual_result = zero;
+
+        // Compare the differences against the expected differences
+        else if ( test_path_list_equals(&list, expected) )
+            actual_result = match;
+    }
+
+    // Clean up
+    path_snapshot_close(&p_snapshot);
+    path_close(&p_path);
+    remove("path_test.snapshot");
+    remove("test cases/paths/diff.tmp/directory/file.txt");
+    remove("test cases/paths/diff.tmp/directory");
+    remove("test cases/paths/diff.tmp/keep.txt");
+    remove("test cases/paths/diff.tmp/modify.txt");
+    remove("test cases/paths/diff.tmp/remove.txt");
+    remove("test cases/paths/diff.tmp/rename from.txt");
+    remove("test cases/paths/diff.tmp/rename to.txt");
+    remove("test cases/paths/diff.tmp/add.txt");
+    remove("test cases/paths/diff.tmp");
+
+    // Return
+    return (result == actual_result);
+}
+
+int test_hash ( char *name )
+{
+
+    // Initialized data
+    const char *directory[]       = { "test cases/paths/directory/.PLACEHOLDER e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855", 0 },
+               *directory_files[] = 
+               { 
+                   "test cases/paths/directory files/file 1.txt 185f8db32271fe25f561a6fc938b2e264306ec304eda518007d1764826381969",
+                   "test cases/paths/directory files/file 2.txt bda1fa48345336618741fd2c4bc02809eb099c49a9b02fb5056401ab6d4dc3e6",
+                   "test cases/paths/directory files/file 3.txt 670d9743542cae3ea7ebe36af56bd53648b0a1126162e78d81a32934a711302e",
+                   0 
+               },
+               *file[]            = { "test cases/paths/file.txt e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855", 0 };
+
+    printf("Scenario: %s\n", name);
+    print_test(name, "path_hash_directory", test_hash_paths(directory, "test cases/paths/directory", match));
+    print_test(name, "path_hash_directory files", test_hash_paths(directory_files, "test cases/paths/directory files", match));
+    print_test(name, "path_hash_file.txt", test_hash_paths(file, "test cases/paths/file.txt", match));
+
+    // Log
+    print_final_summary();
+
+    // Success
+    return 1;
+}
+
+void test_hash_recorder ( const char *full_path, const unsigned char *p_hash, unsigned long long size, void *p_context )
+{
+
+    // Initialized data
+    test_path_list *p_list = p_context;
+    size_t          i      = __atomic_fetch_add(&p_list->count, 1, __ATOMIC_RELAXED);
+    char            hex[2 * PATH_HASH_SIZE + 1] = { 0 };
+
+    // Overflows fail the comparison
+    if ( i >= 64 ) return;
+
+    // Format the hash
+    for (size_t j = 0; j < PATH_HASH_SIZE; j++) snprintf(&hex[2 * j], 3, "%02x", p_hash[j]);
+
+    // Record the path, and its hash
+    snprintf(p_list->paths[i], sizeof(p_list->paths[i]), "%s %s", full_path, hex);
+}
+
+bool test_hash_paths(const char *const *expected_hashes, const char *path_text, result_t result)
+{
+
+    // Initialized data
+    result_t actual_result = 0;
+    path *p_path = 0;
+    test_path_list list = { 0 };
+
+    // Open the path
+    path_open(&p_path, path_text);
+
+    // Hash each file
+    if ( path_hash_tree(p_path, 2, 2, test_hash_recorder, &list) == 0 )
+        actual_result = zero;
+
+    // Compare the hash of each file against the expected hash
+    else if ( test_path_list_equals(&list, expected_hashes) )
+        actual_result = match;
+
+    // Clean up
+    path_close(&p_path);
+
+    // Return
+    return (result == actual_result);
+}
+
+int test_duplicates ( char *name )
+{
+
+    // Initialized data
+    const char *found[] = { "test cases/paths/duplicates.tmp/found/copy 1, test cases/paths/duplicates.tmp/found/directory/copy 2", 0 },
+               *none[]  = { 0 };
+    char       *p_large = malloc(3 * 4096 + 1);
+
+    // Make a pair of duplicates, in different directories
+    mkdir("test cases/paths/duplicates.tmp", 0777);
+    mkdir("test cases/paths/duplicates.tmp/found", 0777);
+    mkdir("test cases/paths/duplicates.tmp/found/directory", 0777);
+    save_file("test cases/paths/duplicates.tmp/found/copy 1", "duplicate");
+    save_file("test cases/paths/duplicates.tmp/found/directory/copy 2", "duplicate");
+
+    // Make files of the same size, with different contents. The large pair only differs between its first and last 4 KiB
+    mkdir("test cases/paths/duplicates.tmp/different", 0777);
+    save_file("test cases/paths/duplicates.tmp/different/a", "different");
+    save_file("test cases/paths/duplicates.tmp/different/b", "unrelated");
+    if ( p_large )
+    {
+        memset(p_large, 'x', 3 * 4096);
+        p_large[3 * 4096] = '\0';
+        save_file("test cases/paths/duplicates.tmp/different/large a", p_large);
+        p_large[4096 + 2048] = 'y';
+        save_file("test cases/paths/duplicates.tmp/different/large b", p_large);
+        free(p_large);
+    }
+
+    // Make two names for one file
+    mkdir("test cases/paths/duplicates.tmp/hard link", 0777);
+    save_file("test cases/paths/duplicates.tmp/hard link/a", "hard link");
+    link("test cases/paths/duplicates.tmp/hard link/a", "test cases/paths/duplicates.tmp/hard link/b");
+
+    printf("Scenario: %s\n", name);
+    print_test(name, "path_find_duplicates_found", test_duplicates_sets(found, "test cases/paths/duplicates.tmp/found", match));
+    print_test(name, "path_find_duplicates_same size", test_duplicates_sets(none, "test cases/paths/duplicates.tmp/different", match));
+    print_test(name, "path_find_duplicates_hard link", test_duplicates_sets(none, "test cases/paths/duplicates.tmp/hard link", match));
+    print_test(name, "path_find_duplicates_all", test_duplicates_sets(found, "test cases/paths/duplicates.tmp", match));
+    print_test(name, "path_find_duplicates_directory files", test_duplicates_sets(none, "test cases/paths/directory files", match));
+    print_test(name, "path_find_duplicates_file.txt", test_duplicates_sets(none, "test cases/paths/file.txt", zero));
+
+    // Clean up
+    remove("test cases/paths/duplicates.tmp/found/directory/copy 2");
+    remove("test cases/paths/duplicates.tmp/found/directory");
+    remove("test cases/paths/duplicates.tmp/found/copy 1");
+    remove("test cases/paths/duplicates.tmp/found");
+    remove("test cases/paths/duplicates.tmp/different/a");
+    remove("test cases/paths/duplicates.tmp/different/b");
+    remove("test cases/paths/duplicates.tmp/different/large a");
+    remove("test cases/paths/duplicates.tmp/different/large b");
+    remove("test cases/paths/duplicates.tmp/different");
+    remove("test cases/paths/duplicates.tmp/hard link/a");
+    remove("test cases/paths/duplicates.tmp/hard link/b");
+    remove("test cases/paths/duplicates.tmp/hard link");
+    remove("test cases/paths/duplicates.tmp");
+
+    // Log
+    print_final_summary();
+
+    // Success
+    return 1;
+}
+
+void test_duplicates_recorder ( const char *const *full_paths, size_t count, unsigned long long size, void *p_context )
+{
+
+    // Initialized data
+    test_path_list *p_list  = p_context;
+    test_path_list  set     = { 0 };
+    size_t          i       = __atomic_fetch_add(&p_list->count, 1, __ATOMIC_RELAXED),
+                    written = 0;
+
+    // Overflows fail the comparison
+    if ( i >= 64 || count > 64 ) return;
+
+    // Paths in a set are reported in any order
+    for (size_t j = 0; j < count; j++) snprintf(set.paths[j], sizeof(set.paths[j]), "%s", full_paths[j]);
+    qsort(set.paths, count, sizeof(set.paths[0]), test_path_compare);
+
+    // Record the set
+    for (size_t j = 0; j < count && written < sizeof(p_list->paths[i]); j++)
+        written += (size_t) snprintf(&p_list->paths[i][written], sizeof(p_list->paths[i]) - written, j ? ", %s" : "%s", set.paths[j]);
+}
+
+bool test_duplicates_sets(const char *const *expected_sets, const char *path_text, result_t result)
+{
+
+    // Initialized data
+    result_t actual_result = 0;
+    path *p_path = 0;
+    test_path_list list = { 0 };
+
+    // Open the path
+    path_open(&p_path, path_text);
+
+    // Find duplicates
+    if ( path_find_duplicates(p_path, 2, 0, test_duplicates_recorder, &list) == 0 )
+        actual_result = zero;
+
+    // Compare each set of duplicates against the expected sets
+    else if ( test_path_list_equals(&list, expected_sets) )
+        actual_result = match;
+
+    // Clean up
+    path_close(&p_path);
+
+    // Return
+    return (result == actual_result);
+}
+
+int test_copy ( char *name )
+{
+    printf("Scenario: %s\n", name);
+    print_test(name, "path_copy_file_file size.txt", test_copy_file("file size.txt", "copy.tmp", PATH_COPY_DEFAULT, match));
+    print_test(name, "path_copy_file_file size.txt_preserve", test_copy_file("file size.txt", "copy.tmp", PATH_COPY_PRESERVE, match));
+    print_test(name, "path_copy_file_file.txt", test_copy_file("file.txt", "copy.tmp", PATH_COPY_DEFAULT, match));
+
+    // Replace a longer file
+    save_file("test cases/paths/copy.tmp", "This file is longer than the file that replaces it");
+    print_test(name, "path_copy_file_file size.txt_replace", test_copy_file("file size.txt", "copy.tmp", PATH_COPY_DEFAULT, match));
+
+    print_test(name, "path_copy_file_file size.txt_self", test_copy_file("file size.txt", "file size.txt", PATH_COPY_DEFAULT, zero));
+
+    // Preserve an unusual mode, and an old modification time
+    save_file("test cases/paths/copy source.tmp", "source");
+    chmod("test cases/paths/copy source.tmp", 0751);
+    utimensat(AT_FDCWD, "test cases/paths/copy source.tmp", (struct timespec[2]) { { .tv_sec = 1000000000, .tv_nsec = 123456789 }, { .tv_sec = 1000000000, .tv_nsec = 123456789 } }, 0);
+    print_test(name, "path_copy_file_copy source.tmp_preserve", test_copy_file("copy source.tmp", "copy.tmp", PATH_COPY_PRESERVE, match));
+    remove("test cases/paths/copy source.tmp");
+
+    print_test(name, "path_copy_file_directory", test_copy_file("directory", "copy.tmp", PATH_COPY_DEFAULT, zero));
+
+    // Log
+    print_final_summary();
+
+    // Success
+    return 1;
+}
+
+bool test_copy_file(const char *source_name, const char *destination_name, int flags, result_t result)
+{
+
+    // Initialized data
+    result_t actual_result = 0;
+    path *p_directory = 0;
+    char source_text[4096] = { 0 },
+         source[4096] = { 0 },
+         destination_text[4096] = { 0 },
+         copy[4096] = { 0 };
+    size_t source_size = 0;
+
+    // Make the paths of the source, and the destination
+    snprintf(source_text, sizeof(source_text), "test cases/paths/%s", source_name);
+    snprintf(destination_text, sizeof(destination_text), "test cases/paths/%s", destination_name);
+
+    // Read the source
+    source_size = load_file(source_text, 0, true);
+    if ( source_size < sizeof(source) ) load_file(source_text, source, true);
+
+    // Open the directory
+    path_open(&p_directory, "test cases/paths");
+
+    // Copy the file. A failed copy must leave the source as it was
+    if ( path_copy_file(p_directory, source_name, p_directory, destination_name, flags) == 0 )
+        actual_result = ( load_file(source_text, 0, true) == source_size ) ? zero : one;
+
+    // Compare the contents of the copy against the source
+    else if ( load_file(destination_text, 0, true) == source_size && load_file(destination_text, copy, true) == source_size && memcmp(source, copy, source_size) == 0 )
+        actual_result = match;
+
+    // Compare the mode, and the modification time, of the copy against the source
+    if ( actual_result == match && ( flags & PATH_COPY_PRESERVE ) )
+    {
+
+        // Initialized data
+        struct stat source_st = { 0 },
+                    copy_st = { 0 };
+
+        // Check the copy
+        if ( stat(source_text, &source_st) == -1 || stat(destination_text, &copy_st) == -1 ||
+             ( source_st.st_mode & 07777 ) != ( copy_st.st_mode & 07777 ) ||
+             source_st.st_mtim.tv_sec != copy_st.st_mtim.tv_sec || source_st.st_mtim.tv_nsec != copy_st.st_mtim.tv_nsec )
+            actual_result = one;
+    }
+
+    // Clean up
+    path_close(&p_directory);
+    if ( strcmp(source_name, destination_name) ) remove(destination_text);
+
+    // Return
+    return (result == actual_result);
+}
+
+int test_remove ( char *name )
+{
+    printf("Scenario: %s\n", name);
+    print_test(name, "path_remove_file", test_remove_tree(0, 0, match));
+    print_test(name, "path_remove_empty directory", test_remove_tree(1, 0, match));
+    print_test(name, "path_remove_wide", test_remove_tree(1, 64, match));
+    print_test(name, "path_remove_deep", test_remove_tree(32, 2, match));
+    print_test(name, "path_remove_dot", test_remove_dot("test cases/paths/remove.tmp", ".", zero));
+    print_test(name, "path_remove_dot dot", test_remove_dot("test cases/paths/remove.tmp", "..", zero));
+    print_test(name, "path_remove_trailing dot", test_remove_dot("test cases/paths", "remove.tmp/.", zero));
+    print_test(name, "path_remove_trailing dot dot", test_remove_dot("test cases/paths", "remove.tmp/../", zero));
+    print_test(name, "path_remove_empty", test_remove_dot("test cases/paths/remove.tmp", "", zero));
+
+    // Log
+    print_final_summary();
+
+    // Success
+    return 1;
+}
+
+bool test_remove_tree(size_t depth, size_t width, result_t result)
+{
+
+    // Initialized data
+    result_t actual_result = 0;
+    path *p_directory = 0;
+    char text[4096] = "test cases/paths/remove.tmp";
+    size_t text_len = strlen(text);
+    struct stat st = { 0 };
+
+    // Open the directory
+    path_open(&p_directory, "test cases/paths");
+
+    // Make a file
+    if ( depth == 0 ) 
+        path_create_file(p_directory, "remove.tmp");
+
+    // Make a tree of directories, each with files in it
+    else
+        for (size_t i = 0; i < depth; i++)
+        {
+
+            // Make the directory
+            mkdir(text, 0777);
+
+            // Make the files
+            for (size_t j = 0; j < width; j++)
+            {
+
+                // Initialized data
+                char file_text[4200] = { 0 };
+                FILE *p_f = 0;
+
+                // Make the file
+                snprintf(file_text, sizeof(file_text), "%s/file %zu", text, j);
+                p_f = fopen(file_text, "w");
+                if ( p_f ) fclose(p_f);
+            }
+
+            // Next level
+            text_len += (size_t) snprintf(&text[text_len], sizeof(text) - text_len, "/d");
+        }
+
+    // Remove the tree
+    if ( path_remove(p_directory, "remove.tmp") == 0 )
+        actual_result = zero;
+
+    // Make sure it is gone
+    else if ( lstat("test cases/paths/remove.tmp", &st) == -1 )
+        actual_result = match;
+
+    // Clean up
+    path_close(&p_directory);
+
+    // Return
+    return (result == actual_result);
+}
+
+bool test_remove_dot(const char *path_text, const char *path_name, result_t result)
+{
+
+    // Initialized data
+    result_t actual_result = 0;
+    path *p_directory = 0;
+    struct stat st = { 0 };
+
+    // Make a directory with a file in it
+    mkdir("test cases/paths/remove.tmp", 0777);
+    save_file("test cases/paths/remove.tmp/file", "file");
+
+    // Open the directory
+    path_open(&p_directory, path_text);
+
+    // Try to remove the directory, or its parent
+    if ( path_remove(p_directory, path_name) == 0 )
+        actual_result = zero;
+
+    // Make sure nothing was removed
+    if ( lstat("test cases/paths/remove.tmp/file", &st) == -1 || lstat("test cases/paths/file.txt", &st) == -1 )
+        actual_result = one;
+
+    // Clean up
+    path_close(&p_directory);
+    remove("test cases/paths/remove.tmp/file");
+    remove("test cases/paths/remove.tmp");
+
+    // Return
+    return (result == actual_result);
+}
+
+int test_create ( char *name )
+{
+    printf("Scenario: %s\n", name);
+    print_test(name, "path_create_files_none", test_create_files(0, PATH_CREATE_DEFAULT, match));
+    print_test(name, "path_create_files_1000", test_create_files(1000, PATH_CREATE_DEFAULT, match));
+    print_test(name, "path_create_files_1000_io_uring", test_create_files(1000, PATH_CREATE_IO_URING, match));
+
+    // Log
+    print_final_summary();
+
+    // Success
+    return 1;
+}
+
+bool test_create_files(size_t count, int flags, result_t result)
+{
+
+    // Initialized data
+    result_t actual_result = 0;
+    path *p_parent = 0,
+         *p_directory = 0;
+    char (*names)[16] = calloc(count + 1, sizeof(*names));
+    const char **pp_names = calloc(count + 1, sizeof(const char *));
+
+    // Make the names
+    for (size_t i = 0; i < count; i++)
+    {
+        snprintf(names[i], sizeof(*names), "file %zu", i);
+        pp_names[i] = names[i];
+    }
+
+    // Make a scratch directory
+    path_open(&p_parent, "test cases/paths");
+    path_create_directory(p_parent, "create.tmp");
+    path_open(&p_directory, "test cases/paths/create.tmp");
+
+    // A file that already exists is truncated
+    if ( count ) save_file("test cases/paths/create.tmp/file 0", "contents");
+
+    // Create the files
+    if ( path_create_files(p_directory, pp_names, count, flags) == 0 )
+        actual_result = zero;
+
+    // Each file exists, and is empty
+    else
+    {
+
+        // Check each file
+        actual_result = match;
+        for (size_t i = 0; i < count; i++)
+        {
+
+            // Initialized data
+            char file_path[64] = { 0 };
+            struct stat st = { 0 };
+
+            // Find the file
+            snprintf(file_path, sizeof(file_path), "test cases/paths/create.tmp/%s", names[i]);
+
+            // Check it
+            if ( lstat(file_path, &st) == -1 || !S_ISREG(st.st_mode) || st.st_size != 0 )
+                actual_result = zero;
+        }
+
+        // And there are no others
+        if ( path_directory_content_names(p_directory, 0) != count )
+            actual_result = zero;
+    }
+
+    // Clean up
+    path_close(&p_directory);
+    path_remove(p_parent, "create.tmp");
+    path_close(&p_parent);
+    free(pp_names);
+    free(names);
+
+    // Return
+    return (result == actual_result);
+}
+
+int test_create_directories ( char *name )
+{
+
+    // Initialized data
+    char long_text[50 * 101] = { 0 };
+
+    // Fifty names of 100 characters, longer than MAX_FILE_PATH_LEN
+    for (size_t i = 0; i < 50; i++)
+    {
+        memset(&long_text[i * 101], 'd', 100);
+        long_text[i * 101 + 100] = ( i < 49 ) ? '/' : '\0';
+    }
+
+    printf("Scenario: %s\n", name);
+    print_test(name, "path_create_directories_one", test_create_directories_text("a", "a", match));
+    print_test(name, "path_create_directories_deep", test_create_directories_text("a/b/c/d", "a/b/c/d", match));
+    print_test(name, "path_create_directories_separators", test_create_directories_text("a//b/./c/", "a/b/c", match));
+    print_test(name, "path_create_directories_empty", test_create_directories_text("", "", zero));
+    print_test(name, "path_create_directories_long", test_create_directories_text(long_text, long_text, match));
+
+    // Log
+    print_final_summary();
+
+    // Success
+    return 1;
+}
+
+bool test_create_directories_text(const char *path_text, const char *expected, result_t result)
+{
+
+    // Initialized data
+    result_t actual_result = 0;
+    path *p_parent = 0,
+         *p_directory = 0;
+    char *expected_names = strdup(expected);
+    int fd = -1;
+
+    // Make a scratch directory
+    path_open(&p_parent, "test cases/paths");
+    path_create_directory(p_parent, "mkdir.tmp");
+    path_open(&p_directory, "test cases/paths/mkdir.tmp");
+
+    // Make the directories
+    if ( path_create_directories(p_directory, path_text) == 0 )
+        actual_result = zero;
+
+    // Make them again. An existing directory is not an error
+    else if ( path_create_directories(p_directory, path_text) == 0 )
+        actual_result = zero;
+
+    // Check each directory along the expected path. The path may be too long to open 
+    // in one call, so each directory is opened relative to its parent
+    else
+    {
+
+        // Start from the scratch directory
+        fd = open("test cases/paths/mkdir.tmp", O_RDONLY | O_DIRECTORY);
+        actual_result = ( fd == -1 ) ? zero : match;
+
+        // Every component is a directory, holding only the next component
+        for (char *p_name = expected_names, *p_next = 0; fd != -1 && *p_name; p_name = p_next)
+        {
+
+            // Initialized data
+            int child_fd = -1;
+            DIR *p_dir = 0;
+            size_t entries = 0;
+
+            // Split the next name
+            p_next = strchr(p_name, '/');
+            if ( p_next ) *p_next++ = '\0';
+            else          p_next = p_name + strlen(p_name);
+
+            // Open the directory, and a second descriptor to read it with
+            child_fd = openat(fd, p_name, O_RDONLY | O_DIRECTORY | O_NOFOLLOW);
+            if ( child_fd != -1 ) p_dir = fdopendir(openat(fd, p_name, O_RDONLY | O_DIRECTORY | O_NOFOLLOW));
+            (void) close(fd);
+            fd = child_fd;
+
+            // Count the entries
+            if ( p_dir )
+            {
+                for (struct dirent *p_entry = readdir(p_dir); p_entry; p_entry = readdir(p_dir))
+                    if ( strcmp(p_entry->d_name, ".") && strcmp(p_entry->d_name, "..") ) entries++;
+                closedir(p_dir);
+            }
+
+            // Only the last directory is empty
+            if ( fd == -1 || p_dir == 0 || entries != ( *p_next ? 1 : 0 ) )
+                actual_result = zero;
+        }
+    }
+
+    // Clean up
+    if ( fd != -1 ) close(fd);
+    path_close(&p_directory);
+    path_remove(p_parent, "mkdir.tmp");
+    path_close(&p_parent);
+    free(expected_names);
+
+    // Return
+    return (result == actual_result);
+}
+
+int test_write ( char *name )
+{
+    printf("Scenario: %s\n", name);
+    print_test(name, "path_write_atomic_none", test_write_files(0, PATH_WRITE_DEFAULT, match));
+    print_test(name, "path_write_atomic_one", test_write_files(1, PATH_WRITE_DEFAULT, match));
+    print_test(name, "path_write_atomic_1000", test_write_files(1000, PATH_WRITE_DEFAULT, match));
+    print_test(name, "path_write_atomic_1000_syncfs", test_write_files(1000, PATH_WRITE_SYNCFS, match));
+    print_test(name, "path_write_atomic_1000_no_sync", test_write_files(1000, PATH_WRITE_NO_SYNC, match));
+
+    // Log
+    print_final_summary();
+
+    // Success
+    return 1;
+}
+
+bool test_write_files(size_t count, int flags, result_t result)
+{
+
+    // Initialized data
+    result_t actual_result = 0;
+    path *p_parent = 0,
+         *p_directory = 0;
+    char (*names)[16] = calloc(count + 1, sizeof(*names)),
+         (*old_contents)[32] = calloc(count + 1, sizeof(*old_contents)),
+         (*contents)[32] = calloc(count + 1, sizeof(*contents));
+    const char **pp_names = calloc(count + 1, sizeof(const char *));
+    const void **pp_old_buffers = calloc(count + 1, sizeof(const void *)),
+               **pp_buffers = calloc(count + 1, sizeof(const void *));
+    size_t *old_sizes = calloc(count + 1, sizeof(size_t)),
+           *sizes = calloc(count + 1, sizeof(size_t));
+
+    // Make the names, and the contents. The old contents are longer than the new
+    for (size_t i = 0; i < count; i++)
+    {
+        snprintf(names[i], sizeof(*names), "file %zu", i);
+        snprintf(old_contents[i], sizeof(*old_contents), "old, longer contents %zu", i);
+        snprintf(contents[i], sizeof(*contents), "contents %zu", i);
+        pp_names[i] = names[i];
+        pp_old_buffers[i] = old_contents[i];
+        pp_buffers[i] = contents[i];
+        old_sizes[i] = strlen(old_contents[i]);
+        sizes[i] = strlen(contents[i]);
+    }
+
+    // Make a scratch directory
+    path_open(&p_parent, "test cases/paths");
+    path_create_directory(p_parent, "write.tmp");
+    path_open(&p_directory, "test cases/paths/write.tmp");
+
+    // Write the files, then replace them
+    if ( path_write_atomic_files(p_directory, pp_names, pp_old_buffers, old_sizes, count, flags) == 0 )
+        actual_result = zero;
+    else if ( path_write_atomic_files(p_directory, pp_names, pp_buffers, sizes, count, flags) == 0 )
+        actual_result = zero;
+
+    // Check each file
+    else
+    {
+
+        // Each file holds exactly its new contents
+        actual_result = match;
+        for (size_t i = 0; i < count; i++)
+        {
+
+            // Initialized data
+            char file_path[64] = { 0 },
+                 text[32] = { 0 };
+
+            // Find the file
+            snprintf(file_path, sizeof(file_path), "test cases/paths/write.tmp/%s", names[i]);
+
+            // Compare the contents
+            if ( load_file(file_path, 0, true) != sizes[i] )
+                actual_result = zero;
+            else if ( load_file(file_path, text, true), memcmp(text, contents[i], sizes[i]) )
+                actual_result = zero;
+        }
+
+        // Temporary files must be gone
+        if ( path_directory_content_names(p_directory, 0) != count )
+            actual_result = zero;
+    }
+
+    // Clean up
+    path_close(&p_directory);
+    path_remove(p_parent, "write.tmp");
+    path_close(&p_parent);
+    free(sizes);
+    free(old_sizes);
+    free(pp_buffers);
+    free(pp_old_buffers);
+    free(pp_names);
+    free(contents);
+    free(old_contents);
+    free(names);
+
+    // Return
+    return (result == actual_result);
+}
+
+int test_handle ( char *name )
+{
+
+    // Initialized data
+    path *p_parent = 0;
+
+    // Make a directory whose name begins with ".."
+    path_open(&p_parent, "test cases/paths");
+    path_create_directory(p_parent, "..dots.tmp");
+
+    printf("Scenario: %s\n", name);
+    print_test(name, "path_navigate_down", test_handle_navigate(PATH_OPEN_HANDLE, "test cases/paths", "directory directory file/directory", "test cases/paths/directory directory file/directory", match));
+    print_test(name, "path_navigate_down_up", test_handle_navigate(PATH_OPEN_HANDLE, "test cases/paths", "directory directory file/directory/..", "test cases/paths/directory directory file", match));
+    print_test(name, "path_navigate_file_up", test_handle_navigate(PATH_OPEN_HANDLE, "test cases/paths", "directory file/simple file.txt/..", "test cases/paths/directory file", match));
+    print_test(name, "path_navigate_up_past", test_handle_navigate(PATH_OPEN_HANDLE, "test cases/paths", "directory files/../..", "test cases", match));
+    print_test(name, "path_navigate_default", test_handle_navigate(PATH_OPEN_DEFAULT, "test cases/paths", "directory files/..", "test cases/paths", match));
+    print_test(name, "path_navigate_dots_name", test_handle_navigate(PATH_OPEN_HANDLE, "test cases/paths", "..dots.tmp", "test cases/paths/..dots.tmp", match));
+    print_test(name, "path_navigate_dots_name_up", test_handle_navigate(PATH_OPEN_DEFAULT, "test cases/paths", "..dots.tmp/..", "test cases/paths", match));
+    print_test(name, "path_navigate_dot_up", test_handle_navigate(PATH_OPEN_DEFAULT, ".", "..", "..", match));
+    print_test(name, "path_navigate_dot_up_handle", test_handle_navigate(PATH_OPEN_HANDLE, ".", "..", "..", match));
+    print_test(name, "path_navigate_missing", test_handle_navigate(PATH_OPEN_HANDLE, "test cases/paths", "directory files/missing/directory", "test cases/paths", zero));
+    print_test(name, "path_navigate_missing_default", test_handle_navigate(PATH_OPEN_DEFAULT, "test cases/paths", "directory files/../missing", "test cases/paths", zero));
+    print_test(name, "path_navigate_missing_after_up", test_handle_navigate(PATH_OPEN_HANDLE, "test cases/paths/directory files", "../missing", "test cases/paths/directory files", zero));
+    print_test(name, "path_navigate_into_file", test_handle_navigate(PATH_OPEN_HANDLE, "test cases/paths", "directory file/simple file.txt/directory", "test cases/paths", zero));
+
+    // Clean up
+    path_remove(p_parent, "..dots.tmp");
+    path_close(&p_parent);
+
+    // Log
+    print_final_summary();
+
+    // Success
+    return 1;
+}
+
+bool test_handle_navigate(int flags, const char *start, const char *path_text, const char *expected, result_t result)
+{
+
+    // Initialized data
+    result_t actual_result = 0;
+    path *p_path = 0,
+         *p_expected = 0;
+    bool agrees = false;
+
+    // Open the path
+    path_open_with_flags(&p_path, start, flags);
+
+    // Navigate. On error, the path is unchanged
+    actual_result = ( path_navigate(&p_path, path_text) ) ? match : zero;
+
+    // The text, and the directory behind it, are the expected path
+    if ( strcmp(path_full_path_text(p_path), expected) == 0 && path_open(&p_expected, expected) )
+        agrees = path_type_path(p_path) == path_type_path(p_expected) &&
+                 ( path_type_path(p_path) != PATH_TYPE_DIRECTORY || path_directory_content_names(p_path, 0) == path_directory_content_names(p_expected, 0) );
+
+    // Clean up
+    if ( p_expected ) path_close(&p_expected);
+    path_close(&p_path);
+
+    // Return
+    return (result == actual_result) && agrees;
+}
+
+bool test_open(const char *expected_path_json, const char *path_text, result_t result)
+{
+
+    // Initialized data
+    result_t actual_result = 0;
+    size_t expected_path_json_len = load_file(expected_path_json, 0, false);
+    char *expected_path_json_text = calloc(expected_path_json_len + 1, sizeof(char));
+    json_value *p_expected_value = 0,
+               *p_result_value = 0;
+    path *p_path = 0;
+
+    // Open the path
+    path_open(&p_path, path_text);
+
+    // Convert the path to a json_value
+    path_to_json_value(p_path, &p_result_value);
+
+    // Load the file text
+    load_file(expected_path_json, expected_path_json_text, true);
+
+    // Parse the text into a JSON value
+    parse_json_value(expected_path_json_text, 0, &p_expected_value);
+
+    print_json_value(p_expected_value, stdout);
+    printf("\n\n");
+    print_json_value(p_result_value, stdout);
+    printf("\n\n");
+
+    // Compare the json_value representations of the path against the expected json_value
+    if ( value_equals(p_expected_value, p_result_value) == true)
+        actual_result = match;
+
+    // Return
+    return (result == actual_result);
+}
+
+bool test_path_type(path_type expected_type, const char *path_text, result_t result)
+{
+
+    // Initialized data
+    result_t actual_result = 0;
+    json_value *p_result_value = 0;
+    path *p_path = 0;
+    path_type type = 0;
+
+    // Open the path
+    path_open(&p_path, path_text);
+
+    // Convert the path to a json_value
+    path_to_json_value(p_path, &p_result_value);
+
+    // Get the path of the type
+    type = path_type_path(p_path);
+
+    // Compare the json_value representations of the path against the expected json_value
+    if (expected_type == type)
+        actual_result = match;
+
+    // Return
+    return (result == actual_result);
+}
+
+bool test_file_size(size_t expected_size, const char *path_text, result_t result)
+{
+
+    // Initialized data
+    result_t actual_result = 0;
+    json_value *p_result_value = 0;
+    path *p_path = 0;
+    size_t size = 0;
+
+    // Open the path
+    path_open(&p_path, path_text);
+
+    // Convert the path to a json_value
+    path_to_json_value(p_path, &p_result_value);
+
+    // Get the path of the type
+    path_file_size(p_path, &size);
+
+    // Compare the json_value representations of the path against the expected json_value
+    if (expected_size == size)
+        actual_result = match;
+
+    // Return
+    return (result == actual_result);
+}
+
+int path_to_json_value(const path *const p_path, json_value **pp_value)
+{
+
+    // Initialized data
+    json_value *p_value1 = calloc(1, sizeof(json_value));
+    json_value *p_value2 = calloc(1, sizeof(json_value));
+    const char *p_path_name = path_name_text(p_path);
+    size_t len = strlen(p_path_name);
+    char *_path_name = calloc(len + 1, sizeof(char));
+
+    p_value1->type = JSON_VALUE_OBJECT;
+
+    strncpy(_path_name, p_path_name, len);
+
+    // file path -> JSON
+    if ( path_type_path(p_path) == PATH_TYPE_FILE )
+    {
+        p_value2->type = JSON_VALUE_INTEGER;
+
+        path_file_size(p_path, &p_value2->integer);
+
+        dict_construct(&p_value1->object, 1, 0);
+        dict_add(p_value1->object, _path_name, p_value2);
+    }
+
+    // directory path -> JSON
+    else if ( path_type_path(p_path) == PATH_TYPE_DIRECTORY )
+    {
+
+        // TODO:
+        // 1. Dump directory names and contents
+        // 2. Iterate over each path in the directory
+        // 2.1 Call path_to_json on each path in the directory
+        // 3 Serialize and return json_value
+
+        const char *names[4096] = {0};
+        path_type   types[4096] = {0};
+
+        size_t count = path_directory_content_names(p_path, 0);
+
+        p_value2->type = JSON_VALUE_OBJECT;
+        dict_construct(&p_value1->object, 1, 0);
+        dict_construct(&p_value2->object, count, 0);
+
+        path_directory_content_names(p_path, names);
+        path_directory_content_types(p_path, types);
+
+        // Iterate over each item in the directory
+        for (size_t i = 0; i < count; i++)
+        {
+
+            json_value *p_valueN       = 0;
+            size_t      path_name_len  = strlen(names[i]);
+            char       *path_name_copy = calloc(path_name_len+1, sizeof(char));
+
+            strncpy(path_name_copy, names[i], path_name_len);
+
+            if ( path_navigate(&p_path, path_name_copy) == 0 )
+            {
+                goto failed_to_nav;
+            }
+            
+            if ( path_type_path(p_path) == PATH_TYPE_FILE )
+            {
+                p_valueN = calloc(1, sizeof(json_value));
+                p_valueN->type = JSON_VALUE_INTEGER;
+                path_file_size(p_path, &p_valueN->integer);
+                dict_add(p_value2->object, path_name_copy, p_valueN);
+
+            }
+            else if ( path_type_path(p_path) == PATH_TYPE_DIRECTORY )
+            {
+                path_to_json_value(p_path, &p_valueN);
+
+                dict_add(p_value2->object, path_name_copy, dict_get(p_valueN->object, path_name_copy));
+
+            }
+
+            failed_to_nav:
+
+            path_navigate(&p_path, "..");
+        }
+    
+        dict_add(p_value1->object, _path_name, p_value2);
+    }
+
+    // Return
+    *pp_value = p_value1;
+
+    // Success
+    return 1;
+}
+
+int print_test(const char *scenario_name, const char *test_name, bool passed)
+{
+
+    // Initialized data
+    printf("%s %-20s %s\n", scenario_name, test_name, (passed) ? "PASS" : "FAIL");
+
+    // Increment the counters
+    {
+        if (passed)
+        {
+            ephemeral_passes++;
+        }
+        else
+        {
+            ephemeral_fails++;
+        }
+
+        ephemeral_tests++;
+    }
+
+    fflush(stdout);
+
+    // Success
+    return 1;
+}
+
+int print_final_summary()
+{
+
+    // Accumulate
+    total_tests += ephemeral_tests,
+    total_passes += ephemeral_passes,
+    total_fails += ephemeral_fails;
+
+    // Print
+    printf("\nTests: %d, Passed: %d, Failed: %d (%%%.3f)\n", ephemeral_tests, ephemeral_passes, ephemeral_fails, ((float)ephemeral_passes / (float)ephemeral_tests * 100.f));
+    printf("Total: %d, Passed: %d, Failed: %d (%%%.3f)\n\n", total_tests, total_passes, total_fails, ((float)total_passes / (float)total_tests * 100.f));
+
+    ephemeral_tests = 0;
+    ephemeral_passes = 0;
+    ephemeral_fails = 0;
+
+    // Success
+    return 1;
+}
+
+bool save_file ( const char *path, const char *text )
+{
+
+    // Initialized data
+    FILE *f = fopen(path, "wb");
+    bool  written = false;
+
+    // Check if file is valid
+    if ( f == NULL ) return false;
+
+    // Write the text
+    written = ( fputs(text, f) >= 0 );
+
+    // The file is no longer needed
+    if ( fclose(f) ) written = false;
+
+    // Done
+    return written;
+}
+
+size_t load_file(const char *path, void *buffer, bool binary_mode)
+{
+
+    // Argument checking
+    #ifndef NDEBUG
+        if ( path == 0 ) goto no_path;
+    #endif
+
+    // Initialized data
+    size_t ret = 0;
+    FILE *f = fopen(path, (binary_mode) ? "rb" : "r");
+
+    // Check if file is valid
+    if ( f == NULL ) goto invalid_file;
+
+    // Find file size and prep for read
+    fseek(f, 0, SEEK_END);
+    ret = ftell(f);
+    fseek(f, 0, SEEK_SET);
+
+    // Read to data
+    if (buffer)
+        ret = fread(buffer, 1, ret, f);
+
+    // The file is no longer needed
+    fclose(f);
 
     // Success
     return ret;
@@ -700,4 +2265,352 @@ size_t load_file(const char *path, void *buffer, bool binary_mode)
             return 0;
         }
     }
-}
\ No newline at end of file
+}
+int test_watch ( char *name )
+{
+    printf("Scenario: %s\n", name);
+    print_test(name, "path_watch_create_delete_rename", test_watch_changes(0, 0, match));
+    print_test(name, "path_watch_cycles", test_watch_changes(20000, 100, match));
+    print_test(name, "path_watch_overflow", test_watch_changes(20000, 0, match));
+
+    // Log
+    print_final_summary();
+
+    // Success
+    return 1;
+}
+
+bool test_watch_changes(size_t cycles, size_t read_every, result_t result)
+{
+
+    // Initialized data
+    result_t actual_result = 0;
+    path *p_parent = 0,
+         *p_directory = 0;
+    const char *expected[] = { "keep.txt", "new.txt", "renamed.txt" };
+    const char *names[4] = { 0 };
+    path_type types[4] = { 0 };
+
+    // Make a scratch directory
+    path_open(&p_parent, "test cases/paths");
+    path_create_directory(p_parent, "watch.tmp");
+    save_file("test cases/paths/watch.tmp/keep.txt", "keep");
+    save_file("test cases/paths/watch.tmp/old.txt", "old");
+    save_file("test cases/paths/watch.tmp/gone.txt", "gone");
+
+    // Open the directory, and list it, so it is watched
+    path_open_with_flags(&p_directory, "test cases/paths/watch.tmp", PATH_OPEN_WATCH);
+    if ( path_directory_content_names(p_directory, 0) != 3 ) goto done;
+
+    // Create, and delete, a file many times. Reading the listing now and then patches it. 
+    // Never reading it overflows the event queue, and the directory is read again
+    for (size_t i = 0; i < cycles; i++)
+    {
+
+        // Initialized data
+        char file_path[64] = { 0 };
+
+        // Create the file, and delete it
+        snprintf(file_path, sizeof(file_path), "test cases/paths/watch.tmp/cycle %zu.tmp", i);
+        save_file(file_path, "x");
+        remove(file_path);
+
+        // Read the listing
+        if ( read_every && ( i + 1 ) % read_every == 0 && path_directory_content_names(p_directory, 0) != 3 ) goto done;
+    }
+
+    // Create, delete, and rename
+    save_file("test cases/paths/watch.tmp/new.txt", "new");
+    remove("test cases/paths/watch.tmp/gone.txt");
+    rename("test cases/paths/watch.tmp/old.txt", "test cases/paths/watch.tmp/renamed.txt");
+
+    // The listing has each change, and nothing else
+    if ( path_directory_content_names(p_directory, 0) != 3 ) goto done;
+    path_directory_content_names(p_directory, names);
+    path_directory_content_types(p_directory, types);
+
+    // Check each entry
+    actual_result = match;
+    for (size_t i = 0; i < 3; i++)
+        if ( strcmp(names[i], expected[i]) || types[i] != PATH_TYPE_FILE ) 
+            actual_result = zero;
+
+    done:
+
+    // Clean up
+    path_close(&p_directory);
+    path_remove(p_parent, "watch.tmp");
+    path_close(&p_parent);
+
+    // Return
+    return (result == actual_result);
+}
+
+int test_listing_cache ( char *name )
+{
+    printf("Scenario: %s\n", name);
+    print_test(name, "path_listing_cache_unchanged", test_listing_cache_revisit(false, match));
+    print_test(name, "path_listing_cache_changed", test_listing_cache_revisit(true, match));
+
+    // Log
+    print_final_summary();
+
+    // Success
+    return 1;
+}
+
+bool test_listing_cache_revisit(bool change, result_t result)
+{
+
+    // Initialized data
+    result_t actual_result = 0;
+    path *p_parent = 0,
+         *p_path = 0;
+    const char *names[2] = { 0 };
+    path_type types[2] = { 0 };
+    struct timespec settle = { .tv_nsec = 20000000 };
+    bool agrees = false;
+
+    // Make a directory with a link to a file beside it. The type of the link is the type 
+    // of the target, so the target can change without changing the directory of the link
+    path_open(&p_parent, "test cases/paths");
+    path_create_directory(p_parent, "cache.tmp");
+    path_create_directory(p_parent, "cache.tmp/dir");
+    save_file("test cases/paths/cache.tmp/target", "target");
+    symlink("../target", "test cases/paths/cache.tmp/dir/link");
+
+    // Wait until the directory is older than a timestamp tick, so its listing can be reused
+    nanosleep(&settle, 0);
+
+    // List the directory. The link is a file
+    path_open(&p_path, "test cases/paths/cache.tmp/dir");
+    if ( path_directory_content_names(p_path, 0) != 1 ) goto done;
+
+    // Navigate away, and make the target a directory
+    if ( path_navigate(&p_path, "..") == 0 ) goto done;
+    remove("test cases/paths/cache.tmp/target");
+    mkdir("test cases/paths/cache.tmp/target", 0777);
+
+    // Change the directory, too
+    if ( change ) save_file("test cases/paths/cache.tmp/dir/new.txt", "new");
+
+    // Navigate back
+    if ( path_navigate(&p_path, "dir") == 0 ) goto done;
+    actual_result = match;
+
+    // An unchanged directory isn't read again, so the link is still a file. 
+    // A changed directory is read again, so it has the new file, and the link is a directory
+    if ( path_directory_content_names(p_path, 0) == ( change ? 2 : 1 ) )
+    {
+        path_directory_content_names(p_path, names);
+        path_directory_content_types(p_path, types);
+        agrees = ( change ) ? strcmp(names[0], "link") == 0 && types[0] == PATH_TYPE_DIRECTORY && strcmp(names[1], "new.txt") == 0 && types[1] == PATH_TYPE_FILE
+                            : strcmp(names[0], "link") == 0 && types[0] == PATH_TYPE_FILE;
+    }
+
+    done:
+
+    // Clean up
+    if ( p_path ) path_close(&p_path);
+    path_remove(p_parent, "cache.tmp");
+    path_close(&p_parent);
+
+    // Return
+    return (result == actual_result) && agrees;
+}
+
+int test_arena ( char *name )
+{
+    printf("Scenario: %s\n", name);
+    print_test(name, "path_arena_default_block", test_arena_paths(0, 4, match));
+    print_test(name, "path_arena_small_block", test_arena_paths(4096, 4, match));
+    print_test(name, "path_arena_no_rounds", test_arena_paths(0, 0, match));
+
+    // Log
+    print_final_summary();
+
+    // Success
+    return 1;
+}
+
+bool test_arena_paths(size_t block_size, size_t rounds, result_t result)
+{
+
+    // Initialized data
+    result_t actual_result = 0;
+    path_arena *p_arena = 0;
+    path_allocator allocator = { 0 };
+    path *p_first = 0;
+    const char *expected[] = { "file 1.txt", "file 2.txt", "file 3.txt" };
+    bool agrees = true;
+
+    // Make an arena, and an allocator for it
+    if ( path_arena_create(&p_arena, block_size) == 0 ) goto done;
+    if ( path_arena_allocator(p_arena, &allocator) == 0 ) goto done;
+
+    // Use the arena, and reset it, many times
+    for (size_t i = 0; i < rounds; i++)
+    {
+
+        // Initialized data
+        path *p_a = 0,
+             *p_b = 0;
+        const char *names[3] = { 0 };
+
+        // Open two paths, and list the first
+        if ( path_open_with_allocator(&p_a, "test cases/paths/directory files", PATH_OPEN_DEFAULT, &allocator) == 0 ) goto done;
+        if ( path_open_with_allocator(&p_b, "test cases/paths/directory files", PATH_OPEN_DEFAULT, &allocator) == 0 ) goto done;
+        if ( path_directory_content_names(p_a, 0) != 3 ) agrees = false;
+
+        // Reset keeps the first block, so each round allocates the same memory
+        if ( i == 0 ) p_first = p_a;
+        else if ( p_a != p_first ) agrees = false;
+
+        // Close the older path. Only the newest allocation gives its memory back, 
+        // so the memory of the other path isn't taken by what it allocates next
+        path_close(&p_a);
+
+        // Navigate away, and back, and list the other path
+        if ( path_navigate(&p_b, "..") == 0 || path_navigate(&p_b, "directory files") == 0 ) goto done;
+        if ( path_directory_content_names(p_b, 0) != 3 || path_directory_content_names(p_b, names) == 0 ) agrees = false;
+
+        // Check each name, and the text of the path
+        for (size_t j = 0; j < 3 && agrees; j++)
+            if ( strcmp(names[j], expected[j]) ) agrees = false;
+        if ( strcmp(path_full_path_text(p_b), "test cases/paths/directory files") ) agrees = false;
+
+        // Close the other path, and free everything at once
+        path_close(&p_b);
+        if ( path_arena_reset(p_arena) == 0 ) goto done;
+    }
+
+    // Success
+    actual_result = match;
+
+    done:
+
+    // Clean up
+    if ( p_arena ) path_arena_destroy(&p_arena);
+
+    // Return
+    return (result == actual_result) && agrees;
+}
+
+int test_cursor ( char *name )
+{
+
+    // Initialized data
+    path *p_parent = 0,
+         *p_directory = 0;
+    char (*names)[101] = calloc(1000, sizeof(*names));
+    const char *pp_names[1000] = { 0 };
+
+    // Make a directory larger than the buffer of a cursor, so the cursor reads it in many batches
+    for (size_t i = 0; i < 1000; i++)
+    {
+        snprintf(names[i], sizeof(*names), "%0100zu", i);
+        pp_names[i] = names[i];
+    }
+    path_open(&p_parent, "test cases/paths");
+    path_create_directory(p_parent, "cursor.tmp");
+    path_open(&p_directory, "test cases/paths/cursor.tmp");
+    path_create_files(p_directory, pp_names, 1000, PATH_CREATE_DEFAULT);
+    path_close(&p_directory);
+
+    printf("Scenario: %s\n", name);
+    print_test(name, "path_dir_cursor_mixed", test_cursor_entries(3, 0, "test cases/paths/directory mixed", match));
+    print_test(name, "path_dir_cursor_files", test_cursor_entries(3, 0, "test cases/paths/directory files", match));
+    print_test(name, "path_dir_cursor_hidden", test_cursor_entries(1, 0, "test cases/paths/directory", match));
+    print_test(name, "path_dir_cursor_large", test_cursor_entries(1000, 0, "test cases/paths/cursor.tmp", match));
+    print_test(name, "path_dir_cursor_pattern", test_cursor_entries(2, "file *", "test cases/paths/directory mixed", match));
+    print_test(name, "path_dir_cursor_pattern_large", test_cursor_entries(10, "*99?", "test cases/paths/cursor.tmp", match));
+    print_test(name, "path_dir_cursor_pattern_no_match", test_cursor_entries(0, "*.o", "test cases/paths/directory files", match));
+    print_test(name, "path_dir_cursor_file.txt", test_cursor_entries(0, 0, "test cases/paths/file.txt", zero));
+
+    // Clean up
+    path_remove(p_parent, "cursor.tmp");
+    path_close(&p_parent);
+    free(names);
+
+    // Log
+    print_final_summary();
+
+    // Success
+    return 1;
+}
+
+bool test_cursor_entries(size_t expected_count, const char *pattern_text, const char *path_text, result_t result)
+{
+
+    // Initialized data
+    result_t actual_result = 0;
+    path *p_path = 0;
+    path_pattern *p_pattern = 0;
+    path_dir_cursor *p_cursor = 0;
+    const char **names = calloc(expected_count + 1, sizeof(const char *)),
+               *p_name = 0;
+    path_type *types = calloc(expected_count + 1, sizeof(path_type)),
+              type = 0,
+              first_type = 0;
+    bool *seen = calloc(expected_count + 1, sizeof(bool)),
+         agrees = true;
+    size_t count = 0,
+           listed = 0;
+    char first[256] = { 0 };
+
+    // Open the path, and filter it
+    path_open(&p_path, path_text);
+    if ( pattern_text && ( path_pattern_compile(&p_pattern, pattern_text) == 0 || path_directory_filter(p_path, p_pattern) == 0 ) ) goto done;
+
+    // Open a cursor
+    if ( path_dir_cursor_open(&p_cursor, p_path) == 0 ) goto done;
+
+    // Step once before the path lists the directory. The cursor has its own offset, so listing doesn't move it
+    if ( path_dir_cursor_next(p_cursor, &p_name, &type) ) snprintf(first, sizeof(first), "%s", p_name);
+    first_type = type;
+
+    // List the directory
+    listed = path_directory_content_names(p_path, 0);
+    if ( listed != expected_count ) agrees = false;
+    else if ( listed ) 
+    {
+        path_directory_content_names(p_path, names);
+        path_directory_content_types(p_path, types);
+    }
+
+    // Step over every entry. Each is in the listing once, with the same type
+    for (bool more = ( first[0] != '\0' ); agrees && more; more = path_dir_cursor_next(p_cursor, &p_name, &type))
+    {
+
+        // Initialized data
+        const char *p_entry = ( count == 0 ) ? first : p_name;
+        path_type entry_type = ( count == 0 ) ? first_type : type;
+        size_t i = 0;
+
+        // Find the entry
+        while ( i < listed && strcmp(names[i], p_entry) ) i++;
+
+        // Check it
+        if ( i == listed || seen[i] || types[i] != entry_type ) agrees = false;
+        else seen[i] = true;
+
+        // Count it
+        count++;
+    }
+
+    // Every entry was seen
+    actual_result = ( agrees && count == listed ) ? match : zero;
+
+    done:
+
+    // Clean up
+    if ( p_cursor ) path_dir_cursor_close(&p_cursor);
+    if ( p_path ) path_close(&p_path);
+    if ( p_pattern ) path_pattern_destroy(&p_pattern);
+    free(seen);
+    free(types);
+    free(names);
+
+    // Return
+    return (result == actual_result);
+}